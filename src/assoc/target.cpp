@@ -58,7 +58,7 @@ void Target::addAssociated (TargetReport* tr)
     if (tr->has_ma_ && !mas_.count(tr->ma_))
         mas_.insert(tr->ma_);
 
-    timed_indexes_[tr->timestamp_] = assoc_trs_.size();
+    timed_indexes_[Time::toMicroTimestamp(tr->timestamp_)] = assoc_trs_.size();
     assoc_trs_.push_back(tr);
 
     if (tr->has_ta_)
@@ -200,123 +200,80 @@ bool Target::hasDataForTime (ptime timestamp, time_duration d_max) const
     if (!isTimeInside(timestamp))
         return false;
 
-    if (timed_indexes_.count(timestamp))
-        return true; // contains exact value
-
-    //    Return iterator to lower bound
-    //    Returns an iterator pointing to the first element in the container whose key is not considered to go
-    //    before k (i.e., either it is equivalent or goes after).
-
-    auto lb_it = timed_indexes_.lower_bound(timestamp);
-
-    if (lb_it == timed_indexes_.end())
-        return false;
-
-    assert (lb_it->first >= timestamp);
-
-    if (lb_it->first - timestamp > d_max)
-        return false; // too much time difference
-
-    // save value
-    ptime upper = lb_it->first;
-
-    // TODO lb_it--; ?
-    while (lb_it != timed_indexes_.end() && timestamp < lb_it->first)
-    {
-        if (lb_it == timed_indexes_.begin()) // exit condition on first value
-        {
-            if (timestamp < lb_it->first) // set as not found
-                lb_it = timed_indexes_.end();
-
-            break;
-        }
-
-        lb_it--;
-    }
+    return timedIndexesFor(Time::toMicroTimestamp(timestamp), Time::toMicroDuration(d_max)).first
+            != timed_indexes_.end();
+}
 
-    if (lb_it == timed_indexes_.end())
-        return false;
+std::pair<ptime, ptime> Target::timesFor (
+        ptime timestamp, time_duration  d_max) const
+// lower/upper times, invalid ts if not existing
+{
+    TimedIndexIterator lower_it, upper_it;
 
-    assert (timestamp >= lb_it->first);
+    tie(lower_it, upper_it) = timedIndexesFor(Time::toMicroTimestamp(timestamp), Time::toMicroDuration(d_max));
 
-    if (timestamp - lb_it->first > d_max)
-        return false; // too much time difference
+    ptime lower, upper;
 
-    ptime lower = lb_it->first;
+    if (lower_it != timed_indexes_.end())
+        lower = Time::fromMicroTimestamp(lower_it->first);
 
-    logdbg << "Target " << utn_ << ": hasDataForTime: found " << Time::toString(lower)
-           << " <= " << Time::toString(timestamp)
-           << " <= " << Time::toString(upper);
+    if (upper_it != timed_indexes_.end())
+        upper = Time::fromMicroTimestamp(upper_it->first);
 
-    return true;
+    return {lower, upper};
 }
 
-std::pair<ptime, ptime> Target::timesFor (
-        ptime timestamp, time_duration  d_max) const
-// lower/upper times, invalid ts if not existing
+std::pair<Target::TimedIndexIterator, Target::TimedIndexIterator> Target::timedIndexesFor (
+        Time::MicroTimestamp timestamp, Time::MicroDuration d_max) const
 {
-    if (timed_indexes_.count(timestamp))
-        return {timestamp, {}}; // contains exact value
+    TimedIndexIterator end_it = timed_indexes_.end();
 
     //    Return iterator to lower bound
     //    Returns an iterator pointing to the first element in the container whose key is not considered to go
     //    before k (i.e., either it is equivalent or goes after).
 
-    auto lb_it = timed_indexes_.lower_bound(timestamp);
-
-    if (lb_it == timed_indexes_.end())
-        return {{}, {}};
+    TimedIndexIterator upper_it = timed_indexes_.lower_bound(timestamp);
 
-    assert (lb_it->first >= timestamp);
+    if (upper_it == end_it)
+        return {end_it, end_it};
 
-    if (lb_it->first - timestamp > d_max)
-        return {{}, {}}; // too much time difference
+    if (upper_it->first == timestamp)
+        return {upper_it, end_it}; // contains exact value
 
-    // save value
-    ptime upper = lb_it->first;
+    assert (upper_it->first > timestamp);
 
-    // TODO lb_it--; ?
-    while (lb_it != timed_indexes_.end() && timestamp < lb_it->first)
-    {
-        if (lb_it == timed_indexes_.begin()) // exit condition on first value
-        {
-            if (timestamp < lb_it->first) // set as not found
-                lb_it = timed_indexes_.end();
-
-            break;
-        }
-
-        lb_it--;
-    }
+    if (upper_it->first - timestamp > d_max)
+        return {end_it, end_it}; // too much time difference
 
-    if (lb_it == timed_indexes_.end())
-        return {{}, upper};
+    if (upper_it == timed_indexes_.begin())
+        return {end_it, upper_it};
 
-    assert (timestamp >= lb_it->first);
+    TimedIndexIterator lower_it = std::prev(upper_it);
 
-    if (timestamp - lb_it->first > d_max)
-        return {{}, upper}; // too much time difference
+    assert (timestamp > lower_it->first);
 
-    ptime lower = lb_it->first;
+    if (timestamp - lower_it->first > d_max)
+        return {end_it, upper_it}; // too much time difference
 
-    return {lower, upper};
+    return {lower_it, upper_it};
 }
 
 std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTime (ptime timestamp, time_duration d_max) const
 {
-    ptime lower, upper;
+    Time::MicroTimestamp timestamp_us = Time::toMicroTimestamp(timestamp);
+    TimedIndexIterator lower_it, upper_it;
 
-    tie(lower, upper) = timesFor(timestamp, d_max);
+    tie(lower_it, upper_it) = timedIndexesFor(timestamp_us, Time::toMicroDuration(d_max));
 
-    if (!lower.is_not_a_date_time() && upper.is_not_a_date_time()) // exact time
-        return {posForExactTime(lower), true};
-
-    if (lower.is_not_a_date_time())
+    if (lower_it == timed_indexes_.end())
         return {{}, false};
 
-    EvaluationTargetPosition pos1 = posForExactTime(lower);
-    EvaluationTargetPosition pos2 = posForExactTime(upper);
-    float d_t = Time::partialSeconds(upper - lower);
+    if (upper_it == timed_indexes_.end()) // exact time
+        return {posForIndex(lower_it->second), true};
+
+    EvaluationTargetPosition pos1 = posForIndex(lower_it->second);
+    EvaluationTargetPosition pos2 = posForIndex(upper_it->second);
+    float d_t = Time::secondsFromMicroDuration(upper_it->first - lower_it->first);
 
     logdbg << "Target: interpolatedPosForTime: d_t " << d_t;
 
@@ -326,7 +283,7 @@ std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTime (ptime
             && pos1.longitude_ == pos2.longitude_) // same pos
         return {pos1, true};
 
-    if (lower == upper) // same time
+    if (lower_it->first == upper_it->first) // same time
     {
         logwrn << "Target: interpolatedPosForTime: ref has same time twice";
         return {{}, false};
@@ -379,7 +336,7 @@ std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTime (ptime
     double v_y = y_pos/d_t;
     logdbg << "Target: interpolatedPosForTime: v_x " << v_x << " v_y " << v_y;
 
-    float d_t2 = Time::partialSeconds(timestamp - lower);
+    float d_t2 = Time::secondsFromMicroDuration(timestamp_us - lower_it->first);
     logdbg << "Target: interpolatedPosForTime: d_t2 " << d_t2;
 
     assert (d_t2 >= 0);
@@ -432,19 +389,20 @@ std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTime (ptime
 std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTimeFast (
         ptime timestamp, time_duration d_max) const
 {
-    ptime lower, upper;
-
-    tie(lower, upper) = timesFor(timestamp, d_max);
+    Time::MicroTimestamp timestamp_us = Time::toMicroTimestamp(timestamp);
+    TimedIndexIterator lower_it, upper_it;
 
-    if (!lower.is_not_a_date_time() && upper.is_not_a_date_time()) // exact time
-        return {posForExactTime(lower), true};
+    tie(lower_it, upper_it) = timedIndexesFor(timestamp_us, Time::toMicroDuration(d_max));
 
-    if (lower.is_not_a_date_time())
+    if (lower_it == timed_indexes_.end())
         return {{}, false};
 
-    EvaluationTargetPosition pos1 = posForExactTime(lower);
-    EvaluationTargetPosition pos2 = posForExactTime(upper);
-    float d_t = Time::partialSeconds(upper - lower);
+    if (upper_it == timed_indexes_.end()) // exact time
+        return {posForIndex(lower_it->second), true};
+
+    EvaluationTargetPosition pos1 = posForIndex(lower_it->second);
+    EvaluationTargetPosition pos2 = posForIndex(upper_it->second);
+    float d_t = Time::secondsFromMicroDuration(upper_it->first - lower_it->first);
 
     logdbg << "Target: interpolatedPosForTimeFast: d_t " << d_t;
 
@@ -454,7 +412,7 @@ std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTimeFast (
             && pos1.longitude_ == pos2.longitude_) // same pos
         return {pos1, true};
 
-    if (lower == upper) // same time
+    if (lower_it->first == upper_it->first) // same time
     {
         logwrn << "Target: interpolatedPosForTimeFast: ref has same time twice";
         return {{}, false};
@@ -464,7 +422,7 @@ std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTimeFast (
     double v_long = (pos2.longitude_ - pos1.longitude_)/d_t;
     logdbg << "Target: interpolatedPosForTimeFast: v_x " << v_lat << " v_y " << v_long;
 
-    float d_t2 = Time::partialSeconds(timestamp - lower);
+    float d_t2 = Time::secondsFromMicroDuration(timestamp_us - lower_it->first);
     logdbg << "Target: interpolatedPosForTimeFast: d_t2 " << d_t2;
 
     assert (d_t2 >= 0);
@@ -505,21 +463,29 @@ std::pair<EvaluationTargetPosition, bool> Target::interpolatedPosForTimeFast (
 
 bool Target::hasDataForExactTime (ptime timestamp) const
 {
-    return timed_indexes_.count(timestamp);
+    return timed_indexes_.count(Time::toMicroTimestamp(timestamp));
 }
 
 TargetReport& Target::dataForExactTime (ptime timestamp) const
 {
     assert (hasDataForExactTime(timestamp));;
-    assert (assoc_trs_.size() > timed_indexes_.at(timestamp));
-    return *assoc_trs_.at(timed_indexes_.at(timestamp));
+    unsigned int index = timed_indexes_.at(Time::toMicroTimestamp(timestamp));
+    assert (assoc_trs_.size() > index);
+    return *assoc_trs_.at(index);
 }
 
 EvaluationTargetPosition Target::posForExactTime (ptime timestamp) const
 {
     assert (hasDataForExactTime(timestamp));
 
-    TargetReport& tr = dataForExactTime(timestamp);
+    return posForIndex(timed_indexes_.at(Time::toMicroTimestamp(timestamp)));
+}
+
+EvaluationTargetPosition Target::posForIndex (unsigned int index) const
+{
+    assert (index < assoc_trs_.size());
+
+    TargetReport& tr = *assoc_trs_[index];
 
     EvaluationTargetPosition pos;
 
@@ -607,21 +573,19 @@ std::tuple<vector<ptime>, vector<ptime>, vector<ptime>> Target::compareModeACode
 CompareResult Target::compareModeACode (
         bool has_ma, unsigned int ma, ptime timestamp, time_duration max_time_diff) const
 {
-    if (!hasDataForTime(timestamp, max_time_diff))
+    if (!isTimeInside(timestamp))
         return CompareResult::UNKNOWN;
 
-    ptime lower, upper;
+    TimedIndexIterator lower_it, upper_it;
 
-    tie(lower, upper) = timesFor(timestamp, max_time_diff);
+    tie(lower_it, upper_it) = timedIndexesFor(Time::toMicroTimestamp(timestamp), Time::toMicroDuration(max_time_diff));
 
-    if (lower.is_not_a_date_time() && upper.is_not_a_date_time())
+    if (lower_it == timed_indexes_.end()) // no data for time
         return CompareResult::UNKNOWN;
 
-    if ((lower.is_not_a_date_time() && !upper.is_not_a_date_time())
-            || (!lower.is_not_a_date_time() && upper.is_not_a_date_time())) // only 1
+    if (upper_it == timed_indexes_.end()) // only 1
     {
-        TargetReport& ref1 = (!lower.is_not_a_date_time()) ? dataForExactTime(lower)
-                                           : dataForExactTime(upper);
+        TargetReport& ref1 = *assoc_trs_.at(lower_it->second);
 
         if (!has_ma)
         {
@@ -642,13 +606,8 @@ CompareResult Target::compareModeACode (
     }
 
     // both set
-    assert (!lower.is_not_a_date_time());
-    assert (hasDataForExactTime(lower));
-    TargetReport& ref1 = dataForExactTime(lower);
-
-    assert (!upper.is_not_a_date_time());
-    assert (hasDataForExactTime(upper));
-    TargetReport& ref2 = dataForExactTime(upper);
+    TargetReport& ref1 = *assoc_trs_.at(lower_it->second);
+    TargetReport& ref2 = *assoc_trs_.at(upper_it->second);
 
     if (!has_ma)
     {
@@ -709,14 +668,14 @@ std::tuple<vector<ptime>, vector<ptime>, vector<ptime>> Target::compareModeCCode
 CompareResult Target::compareModeCCode (bool has_mc, float mc, ptime timestamp,
                                         time_duration max_time_diff, float max_alt_diff, bool debug) const
 {
-    if (!hasDataForTime(timestamp, max_time_diff))
+    if (!isTimeInside(timestamp))
         return CompareResult::UNKNOWN;
 
-    ptime lower, upper;
+    TimedIndexIterator lower_it, upper_it;
 
-    tie(lower, upper) = timesFor(timestamp, max_time_diff);
+    tie(lower_it, upper_it) = timedIndexesFor(Time::toMicroTimestamp(timestamp), Time::toMicroDuration(max_time_diff));
 
-    if (lower.is_not_a_date_time() && upper.is_not_a_date_time())
+    if (lower_it == timed_indexes_.end())
     {
         if (debug)
             loginf << "Target: compareModeCCode: unknown, no times found";
@@ -724,14 +683,12 @@ CompareResult Target::compareModeCCode (bool has_mc, float mc, ptime timestamp,
         return CompareResult::UNKNOWN;
     }
 
-    if ((lower.is_not_a_date_time() && !upper.is_not_a_date_time())
-            || (!lower.is_not_a_date_time() && upper.is_not_a_date_time())) // only 1
+    if (upper_it == timed_indexes_.end()) // only 1
     {
         if (debug)
             loginf << "Target: compareModeCCode: only 1";
 
-        TargetReport& ref1 = (!lower.is_not_a_date_time()) ? dataForExactTime(lower)
-                                           : dataForExactTime(upper);
+        TargetReport& ref1 = *assoc_trs_.at(lower_it->second);
 
         if (!has_mc)
         {
@@ -776,13 +733,8 @@ CompareResult Target::compareModeCCode (bool has_mc, float mc, ptime timestamp,
     if (debug)
         loginf << "Target: compareModeCCode: both";
 
-    assert (!lower.is_not_a_date_time());
-    assert (hasDataForExactTime(lower));
-    TargetReport& ref1 = dataForExactTime(lower);
-
-    assert (!upper.is_not_a_date_time());
-    assert (hasDataForExactTime(upper));
-    TargetReport& ref2 = dataForExactTime(upper);
+    TargetReport& ref1 = *assoc_trs_.at(lower_it->second);
+    TargetReport& ref2 = *assoc_trs_.at(upper_it->second);
 
     if (!has_mc)
     {
@@ -837,12 +789,12 @@ void Target::calculateSpeeds()
 {
     has_speed_ = false;
 
-    ptime timestamp;
+    Time::MicroTimestamp timestamp {0};
     double latitude {0};
     double longitude {0};
     TargetReport* tr;
 
-    ptime timestamp_prev;
+    Time::MicroTimestamp timestamp_prev {0};
     double latitude_prev {0};
     double longitude_prev {0};
 
@@ -882,7 +834,7 @@ void Target::calculateSpeeds()
             continue;
         }
 
-        d_t = Time::partialSeconds(timestamp - timestamp_prev);
+        d_t = Time::secondsFromMicroDuration(timestamp - timestamp_prev);
         assert (d_t >= 0);
 
         //            local.SetStereographic(latitude, longitude, 1.0, 0.0, 0.0);
@@ -966,6 +918,36 @@ void Target::removeNonModeSTRs()
     }
 }
 
+void Target::removeAssociatedBefore(ptime timestamp)
+{
+    if (!has_timestamps_ || timestamp_min_ >= timestamp)
+        return;
+
+    vector<TargetReport*> tmp_trs = assoc_trs_;
+
+    if (!tmp_)
+    {
+        for (auto tr_it : tmp_trs)
+            tr_it->removeAssociated(this);
+    }
+
+    assoc_trs_.clear();
+
+    tas_.clear();
+    mas_.clear();
+    has_timestamps_ = false;
+    has_speed_ = false;
+    timed_indexes_.clear();
+    ds_ids_.clear();
+    track_nums_.clear();
+
+    for (auto tr_it : tmp_trs)
+    {
+        if (tr_it->timestamp_ >= timestamp)
+            addAssociated(tr_it);
+    }
+}
+
 std::map <std::string, unsigned int> Target::getDBContentCounts()
 {
     std::map <std::string, unsigned int> counts;
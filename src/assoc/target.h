@@ -3,6 +3,7 @@
 
 #include "evaluationtargetposition.h"
 #include "projection/transformation.h"
+#include "util/timeconv.h"
 
 #include "boost/date_time/posix_time/ptime.hpp"
 #include "boost/date_time/time_duration.hpp"
@@ -49,7 +50,7 @@ namespace Association
         double speed_max_ {0};
 
         vector<TargetReport*> assoc_trs_;
-        std::map<boost::posix_time::ptime, unsigned int> timed_indexes_;
+        std::map<Utils::Time::MicroTimestamp, unsigned int> timed_indexes_; // timestamp -> index in assoc_trs_
         std::set <unsigned int> ds_ids_;
         std::set <std::pair<unsigned int, unsigned int>> track_nums_; // ds_it, tn
 
@@ -77,6 +78,12 @@ namespace Association
                 boost::posix_time::ptime timestamp, boost::posix_time::time_duration d_max) const;
         // lower/upper times, -1 if not existing
 
+        typedef std::map<Utils::Time::MicroTimestamp, unsigned int>::const_iterator TimedIndexIterator;
+        // lower/upper entries within d_max, end() if not existing. exact time is returned as lower, with
+        // upper end()
+        std::pair<TimedIndexIterator, TimedIndexIterator> timedIndexesFor (
+                Utils::Time::MicroTimestamp timestamp, Utils::Time::MicroDuration d_max) const;
+
         std::pair<EvaluationTargetPosition, bool> interpolatedPosForTime (
                 boost::posix_time::ptime timestamp, boost::posix_time::time_duration d_max) const;
         std::pair<EvaluationTargetPosition, bool> interpolatedPosForTimeFast (
@@ -85,6 +92,7 @@ namespace Association
         bool hasDataForExactTime (boost::posix_time::ptime timestamp) const;
         TargetReport& dataForExactTime (boost::posix_time::ptime timestamp) const;
         EvaluationTargetPosition posForExactTime (boost::posix_time::ptime timestamp) const;
+        EvaluationTargetPosition posForIndex (unsigned int index) const; // index in assoc_trs_
 
         float duration () const;
         bool timeOverlaps (const Target& other) const;
@@ -111,6 +119,7 @@ namespace Association
 
         void calculateSpeeds();
         void removeNonModeSTRs();
+        void removeAssociatedBefore(boost::posix_time::ptime timestamp); // removes all older target reports
 
         std::map <std::string, unsigned int> getDBContentCounts();
 
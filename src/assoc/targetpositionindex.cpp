@@ -0,0 +1,271 @@
+#include "assoc/targetpositionindex.h"
+#include "assoc/target.h"
+#include "assoc/targetreport.h"
+#include "global.h"
+#include "logger.h"
+
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+using namespace boost::posix_time;
+
+namespace Association
+{
+
+// minimum length of one degree latitude on WGS84 (at equator) in meters
+static const double MIN_METERS_PER_DEG_LAT = 110574.0;
+// safety factor for degree margins, covers stereographic scale and ellipsoid
+static const double MARGIN_FACTOR = 2.0;
+// above, degree bounding boxes are not suitable
+static const double MAX_ABS_LATITUDE = 85.0;
+
+TargetPositionIndex::TargetPositionIndex(const std::map<unsigned int, Target>& targets,
+                                         time_duration max_time_diff, double max_distance,
+                                         time_duration slice_duration)
+    : max_time_diff_us_(Utils::Time::toMicroDuration(max_time_diff)), max_distance_(max_distance)
+{
+    assert (max_distance_ >= 0);
+    assert (slice_duration.total_microseconds() > 0);
+
+    latitude_margin_ = MARGIN_FACTOR * max_distance_ / MIN_METERS_PER_DEG_LAT;
+    slice_duration_us_ = slice_duration.total_microseconds();
+
+    // find time range
+    bool first = true;
+    Utils::Time::MicroTimestamp time_min {0}, time_max {0};
+
+    for (auto& target_it : targets)
+    {
+        const Target& target = target_it.second;
+
+        if (!target.timed_indexes_.size())
+            continue;
+
+        if (first)
+        {
+            time_min = target.timed_indexes_.begin()->first;
+            time_max = target.timed_indexes_.rbegin()->first;
+            first = false;
+        }
+        else
+        {
+            time_min = min(time_min, target.timed_indexes_.begin()->first);
+            time_max = max(time_max, target.timed_indexes_.rbegin()->first);
+        }
+    }
+
+    if (first) // no positions
+        return;
+
+    time_begin_us_ = time_min - max_time_diff_us_;
+    slices_.resize(sliceIndex(time_max + max_time_diff_us_) + 1);
+
+    // add positions to all slices in which they can be used for interpolation
+    long slice_first, slice_last;
+
+    for (auto& target_it : targets) // in utn order
+    {
+        const Target& target = target_it.second;
+
+        for (auto& ts_it : target.timed_indexes_) // ts -> index
+        {
+            assert (ts_it.second < target.assoc_trs_.size());
+            const TargetReport& tr = *target.assoc_trs_.at(ts_it.second);
+
+            slice_first = sliceIndex(ts_it.first - max_time_diff_us_);
+            slice_last = sliceIndex(ts_it.first + max_time_diff_us_);
+
+            assert (slice_first >= 0 && slice_last < (long) slices_.size());
+
+            for (long slice_cnt = slice_first; slice_cnt <= slice_last; ++slice_cnt)
+            {
+                std::vector<Entry>& slice = slices_[slice_cnt];
+
+                if (!slice.size() || slice.back().target_ != &target) // new in slice
+                {
+                    slice.push_back({&target, tr.latitude_, tr.latitude_, tr.longitude_, tr.longitude_});
+                    continue;
+                }
+
+                Entry& entry = slice.back();
+
+                entry.latitude_min_ = min(entry.latitude_min_, tr.latitude_);
+                entry.latitude_max_ = max(entry.latitude_max_, tr.latitude_);
+                entry.longitude_min_ = min(entry.longitude_min_, tr.longitude_);
+                entry.longitude_max_ = max(entry.longitude_max_, tr.longitude_);
+            }
+        }
+    }
+
+    logdbg << "TargetPositionIndex: ctor: targets " << targets.size() << " slices " << slices_.size()
+           << " entries " << numEntries();
+}
+
+TargetPositionIndex::TargetPositionIndex(time_duration max_time_diff, double max_distance,
+                                         time_duration slice_duration)
+    : max_time_diff_us_(Utils::Time::toMicroDuration(max_time_diff)), max_distance_(max_distance),
+      incremental_(true)
+{
+    assert (max_distance_ >= 0);
+    assert (slice_duration.total_microseconds() > 0);
+
+    latitude_margin_ = MARGIN_FACTOR * max_distance_ / MIN_METERS_PER_DEG_LAT;
+    slice_duration_us_ = slice_duration.total_microseconds();
+}
+
+bool TargetPositionIndex::candidates(ptime timestamp, double latitude, double longitude,
+                                     std::vector<const Target*>& candidates) const
+{
+    candidates.clear();
+
+    double abs_latitude = fabs(latitude) + latitude_margin_;
+
+    if (abs_latitude >= MAX_ABS_LATITUDE)
+        return false;
+
+    double longitude_margin = latitude_margin_ / cos(abs_latitude * DEG2RAD);
+
+    if (fabs(longitude) + longitude_margin >= 180.0) // bounding boxes do not wrap
+        return false;
+
+    // failed interpolations are checked at position 0,0
+    if (fabs(latitude) <= latitude_margin_ && fabs(longitude) <= longitude_margin)
+        return false;
+
+    long slice_index = sliceIndex(Utils::Time::toMicroTimestamp(timestamp));
+
+    if (slice_index < 0 && removed_before_) // positions might have been removed
+        return false;
+
+    if (slice_index < 0 || slice_index >= (long) slices_.size()) // no positions in time
+        return true;
+
+    for (auto& entry : slices_[slice_index])
+    {
+        if (latitude < entry.latitude_min_ - latitude_margin_
+                || latitude > entry.latitude_max_ + latitude_margin_
+                || longitude < entry.longitude_min_ - longitude_margin
+                || longitude > entry.longitude_max_ + longitude_margin)
+            continue;
+
+        candidates.push_back(entry.target_);
+    }
+
+    return true;
+}
+
+void TargetPositionIndex::add(const Target& target, ptime timestamp, double latitude, double longitude)
+{
+    assert (incremental_);
+
+    Utils::Time::MicroTimestamp ts = Utils::Time::toMicroTimestamp(timestamp);
+
+    if (!slices_.size())
+        time_begin_us_ = ts - max_time_diff_us_;
+
+    if (ts - max_time_diff_us_ < time_begin_us_) // prepend slices
+    {
+        long num_slices = (time_begin_us_ - (ts - max_time_diff_us_) + slice_duration_us_ - 1)
+                / slice_duration_us_;
+
+        slices_.insert(slices_.begin(), num_slices, {});
+        slice_entry_indexes_.insert(slice_entry_indexes_.begin(), num_slices, {});
+        time_begin_us_ -= num_slices * slice_duration_us_;
+    }
+
+    long slice_first = sliceIndex(ts - max_time_diff_us_);
+    long slice_last = sliceIndex(ts + max_time_diff_us_);
+
+    assert (slice_first >= 0);
+
+    if (slice_last >= (long) slices_.size())
+    {
+        slices_.resize(slice_last + 1);
+        slice_entry_indexes_.resize(slice_last + 1);
+    }
+
+    for (long slice_cnt = slice_first; slice_cnt <= slice_last; ++slice_cnt)
+    {
+        std::vector<Entry>& slice = slices_[slice_cnt];
+        std::map<const Target*, size_t>& entry_indexes = slice_entry_indexes_[slice_cnt];
+
+        auto index_it = entry_indexes.find(&target);
+
+        if (index_it == entry_indexes.end()) // new in slice
+        {
+            entry_indexes[&target] = slice.size();
+            slice.push_back({&target, latitude, latitude, longitude, longitude});
+            continue;
+        }
+
+        Entry& entry = slice.at(index_it->second);
+
+        entry.latitude_min_ = min(entry.latitude_min_, latitude);
+        entry.latitude_max_ = max(entry.latitude_max_, latitude);
+        entry.longitude_min_ = min(entry.longitude_min_, longitude);
+        entry.longitude_max_ = max(entry.longitude_max_, longitude);
+    }
+}
+
+void TargetPositionIndex::remove(const Target& target)
+{
+    assert (incremental_);
+
+    for (size_t slice_cnt = 0; slice_cnt < slices_.size(); ++slice_cnt)
+    {
+        std::vector<Entry>& slice = slices_[slice_cnt];
+        std::map<const Target*, size_t>& entry_indexes = slice_entry_indexes_[slice_cnt];
+
+        auto index_it = entry_indexes.find(&target);
+
+        if (index_it == entry_indexes.end())
+            continue;
+
+        size_t index = index_it->second;
+        entry_indexes.erase(index_it);
+
+        if (index != slice.size() - 1) // move last entry into gap
+        {
+            slice[index] = slice.back();
+            entry_indexes.at(slice[index].target_) = index;
+        }
+
+        slice.pop_back();
+    }
+}
+
+void TargetPositionIndex::removeBefore(ptime timestamp)
+{
+    assert (incremental_);
+
+    Utils::Time::MicroTimestamp ts = Utils::Time::toMicroTimestamp(timestamp);
+
+    while (slices_.size() && time_begin_us_ + slice_duration_us_ <= ts)
+    {
+        slices_.pop_front();
+        slice_entry_indexes_.pop_front();
+        time_begin_us_ += slice_duration_us_;
+        removed_before_ = true;
+    }
+}
+
+size_t TargetPositionIndex::numEntries() const
+{
+    size_t num_entries {0};
+
+    for (auto& slice : slices_)
+        num_entries += slice.size();
+
+    return num_entries;
+}
+
+long TargetPositionIndex::sliceIndex (Utils::Time::MicroTimestamp timestamp) const
+{
+    if (timestamp < time_begin_us_)
+        return -1;
+
+    return (timestamp - time_begin_us_) / slice_duration_us_;
+}
+
+}
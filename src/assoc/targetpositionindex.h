@@ -0,0 +1,81 @@
+#ifndef ASSOCIATIONTARGETPOSITIONINDEX_H
+#define ASSOCIATIONTARGETPOSITIONINDEX_H
+
+#include "boost/date_time/posix_time/ptime.hpp"
+#include "boost/date_time/posix_time/posix_time_duration.hpp"
+#include "util/timeconv.h"
+
+#include <deque>
+#include <vector>
+#include <map>
+
+namespace Association
+{
+    using namespace std;
+
+    class Target;
+
+    /**
+     * @brief Time-sliced bounding box index over target positions
+     *
+     * For each time slice, stores per target the WGS84 bounding box of all associated positions which
+     * can be used by Target::interpolatedPosForTimeFast for a timestamp in the slice (i.e. within
+     * max_time_diff). Used to prune the targets before the exact position checks, the returned
+     * candidates are a superset of the targets whose interpolated position lies within max_distance.
+     *
+     * Only valid as long as the targets are not changed. An index created empty is instead updated
+     * incrementally with add, remove and removeBefore, e.g. for live data.
+     */
+    class TargetPositionIndex
+    {
+    public:
+        TargetPositionIndex(const std::map<unsigned int, Target>& targets,
+                            boost::posix_time::time_duration max_time_diff, double max_distance,
+                            boost::posix_time::time_duration slice_duration = boost::posix_time::seconds(30));
+        // empty, for incremental use
+        TargetPositionIndex(boost::posix_time::time_duration max_time_diff, double max_distance,
+                            boost::posix_time::time_duration slice_duration = boost::posix_time::seconds(30));
+
+        // sets candidate targets in utn order (insertion order if incremental), returns false if index can
+        // not be used for position, in which case all targets have to be checked
+        bool candidates(boost::posix_time::ptime timestamp, double latitude, double longitude,
+                        std::vector<const Target*>& candidates) const;
+
+        // only if created empty
+        void add(const Target& target, boost::posix_time::ptime timestamp, double latitude, double longitude);
+        void remove(const Target& target); // all entries of target, e.g. before deletion
+        void removeBefore(boost::posix_time::ptime timestamp); // slices only used for earlier timestamps
+
+        size_t numSlices() const { return slices_.size(); }
+        size_t numEntries() const;
+
+    protected:
+        struct Entry
+        {
+            const Target* target_;
+
+            double latitude_min_;
+            double latitude_max_;
+            double longitude_min_;
+            double longitude_max_;
+        };
+
+        Utils::Time::MicroDuration max_time_diff_us_ {0};
+        double max_distance_ {0};
+        double latitude_margin_ {0}; // max distance in degrees, conservative
+
+        Utils::Time::MicroTimestamp time_begin_us_ {0};
+        long slice_duration_us_ {0};
+
+        std::deque<std::vector<Entry>> slices_; // slice -> entries in utn order, if not incremental
+
+        bool incremental_ {false};
+        bool removed_before_ {false}; // slices before time_begin_us_ were removed
+        std::deque<std::map<const Target*, size_t>> slice_entry_indexes_; // slice -> target -> entry index
+
+        long sliceIndex (Utils::Time::MicroTimestamp timestamp) const; // may be out of range
+    };
+
+}
+
+#endif // ASSOCIATIONTARGETPOSITIONINDEX_H
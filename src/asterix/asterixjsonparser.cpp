@@ -2,6 +2,7 @@
 
 #include "compass.h"
 #include "buffer.h"
+#include "jsonmappingplan.h"
 #include "configuration.h"
 #include "dbcontent/dbcontent.h"
 #include "dbcontent/dbcontentmanager.h"
@@ -297,21 +298,35 @@ void ASTERIXJSONParser::appendVariablesToBuffer(Buffer& buffer) const
 }
 
 bool ASTERIXJSONParser::parseJSON(nlohmann::json& j, Buffer& buffer) const
+{
+    std::unique_ptr<JSONMappingPlan> plan = createMappingPlan(buffer);
+
+    return parseJSON(j, *plan);
+}
+
+bool ASTERIXJSONParser::parseJSON(nlohmann::json& j, JSONMappingPlan& plan) const
 {
     assert(initialized_);
 
-    size_t row_cnt = buffer.size();
+    size_t row_cnt = plan.buffer().size();
 
     bool parsed_any = false;
 
     logdbg << "ASTERIXJSONParser: parseJSON: single target report";
     assert(j.is_object());
 
-    parsed_any = parseTargetReport(j, buffer, row_cnt);
+    parsed_any = plan.parseTargetReport(j, row_cnt);
 
     return parsed_any;
 }
 
+std::unique_ptr<JSONMappingPlan> ASTERIXJSONParser::createMappingPlan(Buffer& buffer) const
+{
+    assert(initialized_);
+
+    return std::unique_ptr<JSONMappingPlan>(new JSONMappingPlan(data_mappings_, buffer, name_));
+}
+
 void ASTERIXJSONParser::createMappingStubs(nlohmann::json& j)
 {
     assert(initialized_);
@@ -325,180 +340,6 @@ void ASTERIXJSONParser::createMappingStubs(nlohmann::json& j)
     return;
 }
 
-bool ASTERIXJSONParser::parseTargetReport(const nlohmann::json& tr, Buffer& buffer,
-                                          size_t row_cnt) const
-{
-    PropertyDataType data_type;
-    std::string current_var_name;
-
-    bool mandatory_missing{false};
-
-    for (const auto& map_it : data_mappings_)
-    {
-        if (!map_it->active())
-        {
-            assert(!map_it->mandatory());
-            continue;
-        }
-
-        // logdbg << "setting data mapping key " << data_it.jsonKey();
-
-        try
-        {
-
-            data_type = map_it->variable().dataType();
-            current_var_name = map_it->variable().name();
-
-            switch (data_type)
-            {
-            case PropertyDataType::BOOL:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: bool " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<bool>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<bool>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::CHAR:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: char " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<char>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<char>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::UCHAR:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: uchar " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<unsigned char>(current_var_name));
-                mandatory_missing = map_it->findAndSetValue(
-                            tr, buffer.get<unsigned char>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::INT:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: int " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<int>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<int>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::UINT:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: uint " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<unsigned int>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<unsigned int>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::LONGINT:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: long " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<long int>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<long int>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::ULONGINT:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: ulong " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<unsigned long>(current_var_name));
-                mandatory_missing = map_it->findAndSetValue(
-                            tr, buffer.get<unsigned long>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::FLOAT:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: float " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<float>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<float>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::DOUBLE:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: double " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<double>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<double>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::STRING:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: string " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<std::string>(current_var_name));
-
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<std::string>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::JSON:
-            {
-                logdbg << "ASTERIXJSONParser: parseTargetReport: json " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<json>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<json>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::TIMESTAMP: // not possible for timestamp
-            default:
-                logerr << "ASTERIXJSONParser: parseTargetReport: impossible for property type "
-                         << Property::asString(data_type);
-                throw std::runtime_error(
-                            "JsonMapping: parseTargetReport: impossible property type " +
-                            Property::asString(data_type));
-            }
-
-        }
-        catch (exception& e)
-        {
-            logerr << "ASTERIXJSONParser: parseTargetReport: caught exception '" << e.what() << "' in \n'"
-                     << tr.dump(4) << "' mapping " << map_it->jsonKey();
-            throw e;
-        }
-
-        if (mandatory_missing)
-        {
-            // TODO make configurable
-            logdbg << "ASTERIXJSONParser '" << name_ << "': parseTargetReport: mandatory variable '"
-                     << current_var_name << "' missing in: \n"
-                     << tr.dump(4);
-            break;
-        }
-    }
-
-    if (mandatory_missing)
-    {
-        // cleanup
-        if (buffer.size() > row_cnt)
-            buffer.cutToSize(row_cnt);
-    }
-
-    return !mandatory_missing;
-}
-
 void ASTERIXJSONParser::createMappingsFromTargetReport(const nlohmann::json& tr)
 {
     checkIfKeysExistsInMappings("", tr);
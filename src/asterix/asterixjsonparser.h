@@ -21,6 +21,7 @@
 class DBContent;
 class Buffer;
 class ASTERIXImportTask;
+class JSONMappingPlan;
 
 class ASTERIXJSONParser : public QAbstractItemModel, public Configurable
 {
@@ -50,6 +51,10 @@ public:
 
     // returns true on successful parse
     bool parseJSON(nlohmann::json& j, Buffer& buffer) const;
+    // same as above, using a plan created for the buffer, to be preferred for repeated parsing
+    bool parseJSON(nlohmann::json& j, JSONMappingPlan& plan) const;
+    // buffer must contain all variables, see getNewBuffer/appendVariablesToBuffer
+    std::unique_ptr<JSONMappingPlan> createMappingPlan(Buffer& buffer) const;
     void createMappingStubs(nlohmann::json& j);
 
     const dbContent::VariableSet& variableList() const;
@@ -148,8 +153,6 @@ private:
     QIcon unknown_icon_;
     QIcon hint_icon_;
 
-    // returns true on successful parse
-    bool parseTargetReport(const nlohmann::json& tr, Buffer& buffer, size_t row_cnt) const;
     void createMappingsFromTargetReport(const nlohmann::json& tr);
 
     void checkIfKeysExistsInMappings(const std::string& location, const nlohmann::json& tr,
@@ -0,0 +1,143 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "asterixrecordmapper.h"
+#include "asterixjsonparser.h"
+#include "buffer.h"
+#include "jsonmappingplan.h"
+#include "logger.h"
+
+#include <exception>
+
+using namespace std;
+using namespace nlohmann;
+
+ASTERIXRecordMapper::ASTERIXRecordMapper(
+        const std::map<unsigned int, std::unique_ptr<ASTERIXJSONParser>>& parsers)
+    : parsers_(parsers)
+{
+    category_parsers_.fill(nullptr);
+
+    for (auto& parser_it : parsers_)
+    {
+        assert (parser_it.first < MAX_CATEGORY);
+        assert (parser_it.second);
+
+        category_parsers_[parser_it.first] = parser_it.second.get();
+    }
+
+    createBuffers();
+}
+
+ASTERIXRecordMapper::~ASTERIXRecordMapper() {}
+
+void ASTERIXRecordMapper::mapRecord(nlohmann::json& record)
+{
+    assert (record.contains("category"));
+    unsigned int category = record.at("category");
+
+    if (category >= MAX_CATEGORY || !category_parsers_[category])
+        return;
+
+    const ASTERIXJSONParser* parser = category_parsers_[category];
+    JSONMappingPlan* plan = category_plans_[category].get();
+    assert (plan);
+
+    bool parsed{false};
+
+    try
+    {
+        logdbg << "ASTERIXRecordMapper: mapRecord: obj " << parser->dbContentName() << " parsing JSON";
+
+        parsed = parser->parseJSON(record, *plan);
+    }
+    catch (exception& e)
+    {
+        logerr << "ASTERIXRecordMapper: mapRecord: caught exception '" << e.what() << "' in \n'"
+               << record.dump(4) << "' parser dbo " << parser->dbContentName();
+
+        ++num_errors_;
+
+        return;
+    }
+
+    if (parsed)
+    {
+        category_mapped_counts_[category].first += 1;
+        ++num_mapped_;
+    }
+    else
+    {
+        category_mapped_counts_[category].second += 1;
+        ++num_not_mapped_;
+    }
+}
+
+bool ASTERIXRecordMapper::hasData() const
+{
+    for (auto& buf_it : buffers_)
+    {
+        if (buf_it.second->size())
+            return true;
+    }
+
+    return false;
+}
+
+std::map<std::string, std::shared_ptr<Buffer>> ASTERIXRecordMapper::buffers()
+{
+    std::map<std::string, std::shared_ptr<Buffer>> not_empty_buffers;
+
+    logdbg << "ASTERIXRecordMapper: buffers: counting buffer sizes";
+    for (auto& buf_it : buffers_)
+    {
+        if (buf_it.second && buf_it.second->size())
+        {
+            num_created_ += buf_it.second->size();
+            not_empty_buffers[buf_it.first] = buf_it.second;
+        }
+    }
+
+    createBuffers();
+
+    return not_empty_buffers;
+}
+
+void ASTERIXRecordMapper::createBuffers()
+{
+    buffers_.clear();
+
+    string dbcontent_name;
+
+    for (auto& parser_it : parsers_)
+    {
+        dbcontent_name = parser_it.second->dbContentName();
+
+        if (!buffers_.count(dbcontent_name))
+            buffers_[dbcontent_name] = parser_it.second->getNewBuffer();
+        else
+            parser_it.second->appendVariablesToBuffer(*buffers_.at(dbcontent_name));
+    }
+
+    // after all variables were added
+    for (auto& parser_it : parsers_)
+    {
+        dbcontent_name = parser_it.second->dbContentName();
+        category_plans_[parser_it.first] =
+                parser_it.second->createMappingPlan(*buffers_.at(dbcontent_name));
+    }
+}
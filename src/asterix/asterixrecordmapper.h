@@ -0,0 +1,83 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASTERIXRECORDMAPPER_H
+#define ASTERIXRECORDMAPPER_H
+
+#include "json.hpp"
+
+#include <array>
+#include <map>
+#include <memory>
+#include <string>
+
+class ASTERIXJSONParser;
+class Buffer;
+class JSONMappingPlan;
+
+/**
+ * @brief Maps post-processed ASTERIX records into per-DBContent buffers
+ *
+ * The category to parser/mapping plan association is resolved once on construction (and on each
+ * buffer renewal), so mapping a record only requires a table lookup by category. Used by both the
+ * ASTERIXJSONMappingJob and the direct mapping mode of the ASTERIXDecodeJob, thus both paths
+ * produce identical buffer contents.
+ */
+class ASTERIXRecordMapper
+{
+  public:
+    ASTERIXRecordMapper(const std::map<unsigned int, std::unique_ptr<ASTERIXJSONParser>>& parsers);
+    ~ASTERIXRecordMapper();
+
+    // record must contain the "category" set by ASTERIXPostProcess
+    void mapRecord(nlohmann::json& record);
+
+    bool hasData() const;
+    // returns all non-empty buffers, and prepares new empty ones
+    std::map<std::string, std::shared_ptr<Buffer>> buffers();
+
+    size_t numMapped() const { return num_mapped_; }
+    size_t numNotMapped() const { return num_not_mapped_; }
+    size_t numErrors() const { return num_errors_; }
+    size_t numCreated() const { return num_created_; }
+
+    std::map<unsigned int, std::pair<size_t, size_t>> categoryMappedCounts() const
+    { return category_mapped_counts_; }
+
+  private:
+    static const unsigned int MAX_CATEGORY = 256;
+
+    const std::map<unsigned int, std::unique_ptr<ASTERIXJSONParser>>& parsers_;
+
+    // category -> parser, nullptr if not mapped
+    std::array<const ASTERIXJSONParser*, MAX_CATEGORY> category_parsers_;
+    // category -> mapping plan of parser into its buffer, nullptr if not mapped
+    std::array<std::unique_ptr<JSONMappingPlan>, MAX_CATEGORY> category_plans_;
+
+    std::map<std::string, std::shared_ptr<Buffer>> buffers_; // dbcontent name -> buffer
+
+    std::map<unsigned int, std::pair<size_t, size_t>>
+        category_mapped_counts_;  // mapped, not mapped
+    size_t num_mapped_{0};        // number of parsed where a parse was successful
+    size_t num_not_mapped_{0};    // number of parsed where no parse was successful
+    size_t num_errors_{0};        // number of failed parses
+    size_t num_created_{0};       // number of created objects from parsing
+
+    void createBuffers();
+};
+
+#endif // ASTERIXRECORDMAPPER_H
@@ -20,6 +20,8 @@
 
 
 #include "buffer.h"
+#include "nullbitmap.h"
+#include "offsetvector.h"
 #include "property.h"
 #include "stringconv.h"
 
@@ -29,9 +31,11 @@
 
 #include "boost/date_time/posix_time/posix_time.hpp"
 
+#include <algorithm>
 #include <array>
 #include <bitset>
 #include <iomanip>
+#include <numeric>
 #include <map>
 #include <memory>
 #include <set>
@@ -82,7 +86,7 @@ public:
             assert (false);
         }
 
-        return data_.at(index);
+        return data_[index]; // not null, so within data
     }
 
     /// @brief Returns string of a specific value
@@ -102,6 +106,26 @@ public:
     void setNull(unsigned int index);
     void setAllNull();
 
+    /// @brief Reserves memory for size elements
+    void reserve(unsigned int size);
+
+    // bulk filling, e.g. when reading from database: prepareFill pre-sizes to size (can be called
+    // again to grow), new elements are null. fill & fillRef set the (not null) value without size
+    // checks. finishFill cuts to the filled size and drops trailing not null flags
+    void prepareFill(unsigned int size);
+    void fill(unsigned int index, T value)
+    {
+        data_[index] = value;
+        null_flags_.set(index, false);
+    }
+    template<typename T_ = T, typename std::enable_if<!std::is_same<T_, bool>::value>::type* = nullptr>
+    T_& fillRef(unsigned int index)
+    {
+        null_flags_.set(index, false);
+        return data_[index];
+    }
+    void finishFill(unsigned int size);
+
     NullableVector<T>& operator*=(double factor);
 
     std::set<T> distinctValues(unsigned int index = 0);
@@ -143,10 +167,14 @@ public:
 private:
     Property property_;
     Buffer& buffer_;
-    /// Data container
-    std::vector<T> data_;
-    // Null flags container
-    std::vector<bool> null_flags_;
+    /// Data container, cheap removal at front for live data
+    OffsetVector<T> data_;
+    // Null flags container, bit set if null. not stored after end are not null if in data
+    NullBitmap null_flags_;
+
+    // calls func(begin, end) for each run of not null values in [from_index, to_index)
+    template <typename Func>
+    void forEachNotNullRun(unsigned int from_index, unsigned int to_index, Func func);
 
     /// @brief Sets specific element to not Null value
     void unsetNull(unsigned int index);
@@ -174,7 +202,7 @@ void NullableVector<T>::clear()
 {
     logdbg << "NullableVector " << property_.name() << ": clear";
     std::fill(data_.begin(), data_.end(), T());
-    std::fill(null_flags_.begin(), null_flags_.end(), true);
+    null_flags_.fill(true);
 }
 
 template <class T>
@@ -201,7 +229,7 @@ const T NullableVector<T>::get(unsigned int index)
         assert (false);
     }
 
-    return data_.at(index);
+    return data_[index]; // not null, so within data
 }
 
 template <class T>
@@ -234,7 +262,7 @@ void NullableVector<T>::set(unsigned int index, T value)
     if (BUFFER_PEDANTIC_CHECKING)
         assert(index < data_.size());
 
-    data_.at(index) = value;
+    data_[index] = value;
     unsetNull(index);
 
     // logdbg << "NullableVector: set: size " << size_ << " max_size " << max_size_;
@@ -301,8 +329,8 @@ void NullableVector<T>::setAll(T value)
 
     for (unsigned int cnt=0; cnt < data_size; ++cnt)
     {
-        data_.at(index) = value;
-        unsetNull(index);
+        data_.at(cnt) = value;
+        unsetNull(cnt);
     }
 }
 
@@ -388,7 +416,50 @@ void NullableVector<T>::setNull(unsigned int index)
     if (BUFFER_PEDANTIC_CHECKING)
         assert(index < null_flags_.size());
 
-    null_flags_.at(index) = true;
+    null_flags_.set(index, true);
+}
+
+template <class T>
+void NullableVector<T>::reserve(unsigned int size)
+{
+    data_.reserve(size);
+    null_flags_.reserve(size);
+}
+
+template <class T>
+void NullableVector<T>::prepareFill(unsigned int size)
+{
+    logdbg << "NullableVector " << property_.name() << ": prepareFill: size " << size;
+
+    if (data_.size() > null_flags_.size())  // data was set w/o null, adjust & fill with set values
+        null_flags_.resize(data_.size(), false);
+
+    if (data_.size() < size)
+        data_.resize(size, T());
+
+    if (null_flags_.size() < size)
+        null_flags_.resize(size, true);
+
+    if (buffer_.data_size_ < data_.size())  // set new data size
+        buffer_.data_size_ = data_.size();
+}
+
+template <class T>
+void NullableVector<T>::finishFill(unsigned int size)
+{
+    logdbg << "NullableVector " << property_.name() << ": finishFill: size " << size;
+
+    if (data_.size() > size)
+        data_.resize(size);
+
+    if (null_flags_.size() > size)
+        null_flags_.resize(size);
+
+    // not stored null flags are not null
+    size_t last_null = null_flags_.findLast();
+    null_flags_.resize(last_null == NullBitmap::NPOS ? 0 : last_null + 1);
+
+    // size set in Buffer::cutToSize
 }
 
 template <class T>
@@ -415,7 +486,7 @@ bool NullableVector<T>::isNull(unsigned int index)
     }
 
     if (index < null_flags_.size())  // if stored, return value
-        return null_flags_.at(index);
+        return null_flags_[index];
 
     // null not stored, so all set are not null
 
@@ -485,7 +556,7 @@ void NullableVector<T>::addData(NullableVector<T>& other)
                << ": addData: 1: other no data resizing null";
         resizeNullTo(buffer_.data_size_);
         logdbg << "NullableVector " << property_.name() << ": addData: 1: inserting null";
-        null_flags_.insert(null_flags_.end(), other.null_flags_.begin(), other.null_flags_.end());
+        null_flags_.append(other.null_flags_);
         return;
     }
 
@@ -516,7 +587,7 @@ void NullableVector<T>::addData(NullableVector<T>& other)
            << buffer_.data_size_;
     resizeNullTo(buffer_.data_size_);
     logdbg << "NullableVector " << property_.name() << ": addData: 3: inserting nulls";
-    null_flags_.insert(null_flags_.end(), other.null_flags_.begin(), other.null_flags_.end());
+    null_flags_.append(other.null_flags_);
 
     if (data_.size() < buffer_.data_size_)  // need to size data up
     {
@@ -564,11 +635,11 @@ NullableVector<T>& NullableVector<T>::operator*=(double factor)
     //        }
     //    });
 
-    for (unsigned int cnt=0; cnt < data_size; ++cnt)
+    forEachNotNullRun(0, data_size, [&] (unsigned int begin, unsigned int end)
     {
-        if (!isNull(cnt))
-            data_.at(cnt) *= factor;
-    }
+        for (unsigned int cnt=begin; cnt < end; ++cnt)
+            data_[cnt] *= factor;
+    });
 
     //    for (auto &data_it : data_)
     //        data_it *= factor;
@@ -583,17 +654,16 @@ std::set<T> NullableVector<T>::distinctValues(unsigned int index)
 
     std::set<T> values;
 
-    T value;
-
-    for (; index < data_.size(); ++index)
+    forEachNotNullRun(index, data_.size(), [&] (unsigned int begin, unsigned int end)
     {
-        if (!isNull(index))  // not for null
+        values.insert(data_[begin]);
+
+        for (unsigned int cnt=begin+1; cnt < end; ++cnt)
         {
-            value = data_.at(index);
-            if (values.count(value) == 0)
-                values.insert(value);
+            if (data_[cnt] != data_[cnt-1]) // only insert on change
+                values.insert(data_[cnt]);
         }
-    }
+    });
 
     return values;
 }
@@ -605,16 +675,20 @@ std::map<T, unsigned int> NullableVector<T>::distinctValuesWithCounts(unsigned i
 
     std::map<T, unsigned int> values;
 
-    T value;
-
-    for (; index < data_.size(); ++index)
+    forEachNotNullRun(index, data_.size(), [&] (unsigned int begin, unsigned int end)
     {
-        if (!isNull(index))  // not for null
+        unsigned int same_end;
+
+        for (unsigned int cnt=begin; cnt < end; cnt = same_end) // count equal values at once
         {
-            value = data_.at(index);
-            values[value] += 1;
+            same_end = cnt + 1;
+
+            while (same_end < end && data_[same_end] == data_[cnt])
+                ++same_end;
+
+            values[data_[cnt]] += same_end - cnt;
         }
-    }
+    });
 
     return values;
 }
@@ -625,23 +699,23 @@ std::tuple<bool,T,T> NullableVector<T>::minMaxValues(unsigned int index)
     bool set = false;
     T min, max;
 
-    for (; index < data_.size(); ++index)
+    const T* values = data_.data();
+
+    forEachNotNullRun(index, data_.size(), [&] (unsigned int begin, unsigned int end)
     {
-        if (!isNull(index))  // not for null
+        if (!set)
         {
-            if (!set)
-            {
-                min = data_.at(index);
-                max = data_.at(index);
-                set = true;
-            }
-            else
-            {
-                min = std::min(min, data_.at(index));
-                max = std::max(max, data_.at(index));
-            }
+            min = values[begin];
+            max = values[begin];
+            set = true;
         }
-    }
+
+        for (unsigned int cnt=begin; cnt < end; ++cnt) // contiguous, vectorizable
+        {
+            min = std::min(min, values[cnt]);
+            max = std::max(max, values[cnt]);
+        }
+    });
 
     return std::tuple<bool,T,T> {set, min, max};
 }
@@ -655,23 +729,21 @@ inline std::tuple<bool,bool,bool> NullableVector<bool>::minMaxValues(unsigned in
     bool set = false;
     char min, max;
 
-    for (; index < data_.size(); ++index)
+    forEachNotNullRun(index, data_.size(), [&] (unsigned int begin, unsigned int end)
     {
-        if (!isNull(index))  // not for null
+        if (!set)
         {
-            if (!set)
-            {
-                min = (char)data_.at(index);
-                max = (char)data_.at(index);
-                set = true;
-            }
-            else
-            {
-                min = std::min(min, (char)data_.at(index));
-                max = std::max(max, (char)data_.at(index));
-            }
+            min = (char)data_[begin];
+            max = (char)data_[begin];
+            set = true;
         }
-    }
+
+        for (unsigned int cnt=begin; cnt < end; ++cnt)
+        {
+            min = std::min(min, (char)data_[cnt]);
+            max = std::max(max, (char)data_[cnt]);
+        }
+    });
 
     return std::tuple<bool,bool,bool> {set, min, max};
 }
@@ -737,16 +809,11 @@ std::map<T, std::vector<unsigned int>> NullableVector<T>::distinctValuesWithInde
     if (from_index + 1 > data_.size())  // no data
         return values;
 
-    for (unsigned int index = from_index; index <= to_index; ++index)
+    forEachNotNullRun(from_index, to_index + 1, [&] (unsigned int begin, unsigned int end)
     {
-        if (!isNull(index))  // not for null
-        {
-            if (BUFFER_PEDANTIC_CHECKING)
-                assert(index < data_.size());
-
-            values[data_.at(index)].push_back(index);
-        }
-    }
+        for (unsigned int index = begin; index < end; ++index)
+            values[data_[index]].push_back(index);
+    });
 
     logdbg << "NullableVector " << property_.name() << ": distinctValuesWithIndexes: done with "
            << values.size();
@@ -805,16 +872,18 @@ std::vector<unsigned int> NullableVector<T>::nullValueIndexes(unsigned int from_
     //    if (from_index+1 >= data_.size()) // no data
     //        return indexes;
 
-    for (unsigned int index = from_index; index <= to_index; ++index)
-    {
-        if (isNull(index))  // not for null
-        {
-            if (BUFFER_PEDANTIC_CHECKING)
-                assert(index < data_.size());
+    unsigned int end_index = to_index + 1;
+    unsigned int flags_end = std::min(end_index, (unsigned int) null_flags_.size());
 
-            indexes.push_back(index);
-        }
-    }
+    if (from_index < flags_end) // stored null flags, word-wise
+        null_flags_.forEachSet(from_index, flags_end, [&] (size_t index) { indexes.push_back(index); });
+
+    // after stored null flags not null if in data, null after data
+    unsigned int index = std::max(from_index, std::max((unsigned int) null_flags_.size(),
+                                                       (unsigned int) data_.size()));
+
+    for (; index < end_index; ++index)
+        indexes.push_back(index);
 
     logdbg << "NullableVector " << property_.name() << ": nullValueIndexes: done with "
            << indexes.size();
@@ -911,11 +980,11 @@ void NullableVector<T>::cutToSize(unsigned int size)
         assert(null_flags_.size() <= buffer_.data_size_);
     }
 
-    while (null_flags_.size() > size)
-        null_flags_.pop_back();
+    if (null_flags_.size() > size)
+        null_flags_.resize(size);
 
-    while (data_.size() > size)
-        data_.pop_back();
+    if (data_.size() > size)
+        data_.resize(size);
 
     // size set in Buffer::cutToSize
 }
@@ -932,7 +1001,7 @@ void NullableVector<T>::cutUpToIndex(unsigned int index) // everything up to ind
     if (null_flags_.size())
     {
         if (index < null_flags_.size())
-            null_flags_.erase(null_flags_.begin(), null_flags_.begin() + index + 1);
+            null_flags_.eraseFront(index + 1);
         else
             null_flags_.clear(); // would have been removed
     }
@@ -940,7 +1009,7 @@ void NullableVector<T>::cutUpToIndex(unsigned int index) // everything up to ind
     if (data_.size())
     {
         if (index < data_.size())
-            data_.erase(data_.begin(), data_.begin() + index + 1); // takes number of elements
+            data_.eraseFront(index + 1); // takes number of elements
         else
             data_.clear(); // would have been removed
     }
@@ -1032,7 +1101,7 @@ void NullableVector<T>::removeIndexes(const std::vector<size_t>& indexes_to_remo
             {
                 while (null_idx_old < idx_tbr)
                 {
-                    null_flags_[ null_idx_new ] = null_flags_[ null_idx_old ];
+                    null_flags_.set(null_idx_new, null_flags_[ null_idx_old ]);
 
                     null_idx_new++;
                     null_idx_old++;
@@ -1047,7 +1116,7 @@ void NullableVector<T>::removeIndexes(const std::vector<size_t>& indexes_to_remo
         //copy any null beyond last index to be removed
         while (null_idx_old < null_flags_.size())
         {
-            null_flags_[ null_idx_new ] = null_flags_[ null_idx_old ];
+            null_flags_.set(null_idx_new, null_flags_[ null_idx_old ]);
 
             null_idx_new++;
             null_idx_old++;
@@ -1063,13 +1132,7 @@ bool NullableVector<T>::isNeverNull()
 {
     logdbg << "NullableVector " << property_.name() << ": isNeverNull";
 
-    for (unsigned int cnt = 0; cnt < null_flags_.size(); cnt++)
-    {
-        if (null_flags_.at(cnt))
-            return false;
-    }
-
-    return true;
+    return !null_flags_.any();
 }
 
 template <class T>
@@ -1196,6 +1259,27 @@ void NullableVector<T>::sortByPermutation(const std::vector<std::size_t>& perm)
 
 // private stuff
 
+template <class T>
+template <typename Func>
+void NullableVector<T>::forEachNotNullRun(unsigned int from_index, unsigned int to_index, Func func)
+{
+    to_index = std::min(to_index, (unsigned int) data_.size()); // null after data
+
+    if (from_index >= to_index)
+        return;
+
+    unsigned int flags_end = std::min(to_index, (unsigned int) null_flags_.size());
+
+    if (from_index < flags_end) // stored null flags, word-wise
+    {
+        null_flags_.forEachUnsetRun(from_index, flags_end, func);
+        from_index = flags_end;
+    }
+
+    if (from_index < to_index) // after stored null flags not null
+        func(from_index, to_index);
+}
+
 /// @brief Sets specific element to not Null value
 template <class T>
 void NullableVector<T>::unsetNull(unsigned int index)
@@ -1211,7 +1295,7 @@ void NullableVector<T>::unsetNull(unsigned int index)
     }
 
     if (index < null_flags_.size())  // if was already set
-        null_flags_.at(index) = false;
+        null_flags_.set(index, false);
 }
 
 template <>
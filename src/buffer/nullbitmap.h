@@ -0,0 +1,295 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NULLBITMAP_H
+#define NULLBITMAP_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Bit-packed flags stored in 64-bit words, used as null flags of NullableVector
+ *
+ * Bits beyond size() in the last word are always 0, so words can be processed as a whole. The
+ * for-each functions work a word at a time, skipping empty words and resolving set bits and runs
+ * of unset bits with bit scans.
+ *
+ * Removing bits from the front only moves the begin offset (bits before it are kept 0), the words
+ * before the offset are released in one erase once they are more than the remaining ones.
+ */
+class NullBitmap
+{
+  public:
+    static const size_t WORD_BITS = 64;
+    static const size_t NPOS = static_cast<size_t>(-1);
+
+    size_t size() const { return size_; }
+    bool empty() const { return !size_; }
+
+    void clear()
+    {
+        words_.clear();
+        size_ = 0;
+        offset_ = 0;
+    }
+
+    void reserve(size_t size) { words_.reserve(numWords(offset_ + size)); }
+
+    // new bits are set to value
+    void resize(size_t size, bool value = false)
+    {
+        if (!size)
+        {
+            clear();
+            return;
+        }
+
+        if (size <= size_)
+        {
+            size_ = size;
+            words_.resize(numWords(offset_ + size_));
+            maskLastWord();
+            return;
+        }
+
+        size_t end = offset_ + size_;
+
+        if (value && (end % WORD_BITS))
+            words_.back() |= ~0ULL << (end % WORD_BITS);
+
+        words_.resize(numWords(offset_ + size), value ? ~0ULL : 0ULL);
+        size_ = size;
+
+        maskLastWord();
+    }
+
+    bool operator[](size_t index) const
+    {
+        index += offset_;
+        return (words_[index / WORD_BITS] >> (index % WORD_BITS)) & 1ULL;
+    }
+
+    bool at(size_t index) const
+    {
+        assert (index < size_);
+        return (*this)[index];
+    }
+
+    void set(size_t index, bool value)
+    {
+        index += offset_;
+
+        if (value)
+            words_[index / WORD_BITS] |= 1ULL << (index % WORD_BITS);
+        else
+            words_[index / WORD_BITS] &= ~(1ULL << (index % WORD_BITS));
+    }
+
+    void fill(bool value)
+    {
+        std::fill(words_.begin(), words_.end(), value ? ~0ULL : 0ULL);
+        maskLastWord();
+
+        if (value)
+            clearBits(0, offset_);
+    }
+
+    void append(const NullBitmap& other)
+    {
+        size_t shift = (offset_ + size_) % WORD_BITS;
+        size_t other_num_words = numWords(other.size_);
+
+        for (size_t cnt = 0; cnt < other_num_words; ++cnt)
+        {
+            uint64_t other_word = other.word(cnt);
+
+            if (!shift)
+                words_.push_back(other_word);
+            else
+            {
+                words_.back() |= other_word << shift;
+                words_.push_back(other_word >> (WORD_BITS - shift));
+            }
+        }
+
+        size_ += other.size_;
+        words_.resize(numWords(offset_ + size_));
+    }
+
+    // removes the first num bits
+    void eraseFront(size_t num)
+    {
+        if (num >= size_)
+        {
+            clear();
+            return;
+        }
+
+        clearBits(offset_, offset_ + num);
+
+        offset_ += num;
+        size_ -= num;
+
+        size_t unused_words = offset_ / WORD_BITS;
+
+        if (unused_words >= MIN_COMPACT_WORDS && unused_words > words_.size() - unused_words)
+        {
+            words_.erase(words_.begin(), words_.begin() + unused_words);
+            offset_ -= unused_words * WORD_BITS;
+        }
+    }
+
+    bool any() const
+    {
+        for (uint64_t word : words_)
+        {
+            if (word)
+                return true;
+        }
+
+        return false;
+    }
+
+    size_t count() const
+    {
+        size_t num = 0;
+
+        for (uint64_t word : words_)
+            num += __builtin_popcountll(word);
+
+        return num;
+    }
+
+    // index of last set bit, NPOS if none
+    size_t findLast() const
+    {
+        for (size_t word_index = words_.size(); word_index > 0; --word_index)
+        {
+            if (words_[word_index - 1])
+                return (word_index - 1) * WORD_BITS + WORD_BITS - 1 - __builtin_clzll(words_[word_index - 1])
+                        - offset_;
+        }
+
+        return NPOS;
+    }
+
+    // calls func(index) for each set bit in [from_index, to_index), to_index <= size
+    template <typename Func>
+    void forEachSet(size_t from_index, size_t to_index, Func func) const
+    {
+        assert (to_index <= size_);
+
+        from_index += offset_;
+        to_index += offset_;
+
+        for (size_t word_index = from_index / WORD_BITS; word_index * WORD_BITS < to_index; ++word_index)
+        {
+            size_t word_start = word_index * WORD_BITS;
+            uint64_t word = words_[word_index] & rangeMask(from_index, to_index, word_start);
+
+            while (word)
+            {
+                func(word_start + __builtin_ctzll(word) - offset_);
+                word &= word - 1;
+            }
+        }
+    }
+
+    // calls func(begin, end) for each run of unset bits in [from_index, to_index), to_index <= size
+    template <typename Func>
+    void forEachUnsetRun(size_t from_index, size_t to_index, Func func) const
+    {
+        assert (to_index <= size_);
+
+        from_index += offset_;
+        to_index += offset_;
+
+        for (size_t word_index = from_index / WORD_BITS; word_index * WORD_BITS < to_index; ++word_index)
+        {
+            size_t word_start = word_index * WORD_BITS;
+            uint64_t word = ~words_[word_index] & rangeMask(from_index, to_index, word_start);
+
+            while (word)
+            {
+                unsigned int begin = __builtin_ctzll(word);
+                uint64_t shifted = ~(word >> begin);
+                unsigned int end = shifted ? begin + __builtin_ctzll(shifted) : WORD_BITS;
+
+                func(word_start + begin - offset_, word_start + end - offset_);
+
+                word = end < WORD_BITS ? word & (~0ULL << end) : 0ULL;
+            }
+        }
+    }
+
+  protected:
+    static const size_t MIN_COMPACT_WORDS = 16;
+
+    std::vector<uint64_t> words_;
+    size_t size_ {0};
+    size_t offset_ {0}; // bit position of index 0 in words_
+
+    static size_t numWords(size_t size) { return (size + WORD_BITS - 1) / WORD_BITS; }
+
+    // bits of word starting at word_start which are in [from_index, to_index)
+    static uint64_t rangeMask(size_t from_index, size_t to_index, size_t word_start)
+    {
+        uint64_t mask = ~0ULL;
+
+        if (from_index > word_start)
+            mask &= ~0ULL << (from_index - word_start);
+
+        if (to_index < word_start + WORD_BITS)
+            mask &= (1ULL << (to_index - word_start)) - 1;
+
+        return mask;
+    }
+
+    // bits [cnt * WORD_BITS, (cnt+1) * WORD_BITS) from index 0, 0 after size
+    uint64_t word(size_t cnt) const
+    {
+        size_t bit_index = offset_ + cnt * WORD_BITS;
+        size_t word_index = bit_index / WORD_BITS;
+        size_t bit_shift = bit_index % WORD_BITS;
+
+        uint64_t word = words_[word_index] >> bit_shift;
+
+        if (bit_shift && word_index + 1 < words_.size())
+            word |= words_[word_index + 1] << (WORD_BITS - bit_shift);
+
+        return word;
+    }
+
+    // sets bits in [from_bit, to_bit) of words_ to 0
+    void clearBits(size_t from_bit, size_t to_bit)
+    {
+        for (size_t word_index = from_bit / WORD_BITS; word_index * WORD_BITS < to_bit; ++word_index)
+            words_[word_index] &= ~rangeMask(from_bit, to_bit, word_index * WORD_BITS);
+    }
+
+    void maskLastWord()
+    {
+        size_t end = offset_ + size_;
+
+        if (end % WORD_BITS)
+            words_.back() &= (1ULL << (end % WORD_BITS)) - 1;
+    }
+};
+
+#endif // NULLBITMAP_H
@@ -0,0 +1,108 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef OFFSETVECTOR_H
+#define OFFSETVECTOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Vector with cheap removal of elements at the front, used as data container of NullableVector
+ *
+ * Removing elements from the front only moves the begin offset, the storage of removed elements is
+ * released in one erase once it is larger than the remaining elements, so each element is moved at
+ * most a constant number of times on average. Appending does not move existing elements except for
+ * reallocation. Supports the subset of the std::vector interface used by NullableVector.
+ */
+template <class T>
+class OffsetVector
+{
+  public:
+    typedef typename std::vector<T>::reference reference;
+    typedef typename std::vector<T>::const_reference const_reference;
+    typedef typename std::vector<T>::iterator iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    size_t size() const { return values_.size() - offset_; }
+    bool empty() const { return values_.size() == offset_; }
+
+    reference operator[](size_t index) { return values_[offset_ + index]; }
+    const_reference operator[](size_t index) const { return values_[offset_ + index]; }
+
+    reference at(size_t index)
+    {
+        assert (index < size());
+        return values_.at(offset_ + index);
+    }
+    const_reference at(size_t index) const
+    {
+        assert (index < size());
+        return values_.at(offset_ + index);
+    }
+
+    iterator begin() { return values_.begin() + offset_; }
+    iterator end() { return values_.end(); }
+    const_iterator begin() const { return values_.begin() + offset_; }
+    const_iterator end() const { return values_.end(); }
+
+    // not for bool
+    T* data() { return values_.data() + offset_; }
+    const T* data() const { return values_.data() + offset_; }
+
+    void clear()
+    {
+        values_.clear();
+        offset_ = 0;
+    }
+
+    void reserve(size_t size) { values_.reserve(offset_ + size); }
+    void resize(size_t size, const T& value = T()) { values_.resize(offset_ + size, value); }
+
+    template <class InputIt>
+    void insert(iterator pos, InputIt first, InputIt last) { values_.insert(pos, first, last); }
+
+    // removes the first num elements
+    void eraseFront(size_t num)
+    {
+        if (num >= size())
+        {
+            clear();
+            return;
+        }
+
+        offset_ += num;
+
+        if (offset_ >= MIN_COMPACT_SIZE && offset_ > size())
+            compact();
+    }
+
+  protected:
+    static const size_t MIN_COMPACT_SIZE = 1024;
+
+    std::vector<T> values_;
+    size_t offset_ {0}; // index of first element in values_
+
+    void compact()
+    {
+        values_.erase(values_.begin(), values_.begin() + offset_);
+        offset_ = 0;
+    }
+};
+
+#endif // OFFSETVECTOR_H
@@ -23,6 +23,7 @@
 
 #include <QTimer>
 #include <QCoreApplication>
+#include <QEventLoop>
 #include <QThread>
 
 #include <boost/program_options.hpp>
@@ -1044,7 +1045,14 @@ bool RTCommandEvaluate::run_impl() const
 
     loginf << "RTCommandEvaluate: run_impl: doing evaluation";
 
-    eval_man.evaluate();
+    // runs in background without progress dialog, wait without polling
+    QEventLoop loop;
+    QObject::connect(&eval_man, &EvaluationManager::evaluationDoneSignal, &loop, &QEventLoop::quit);
+
+    eval_man.evaluate(false);
+
+    if (eval_man.evaluationRunning())
+        loop.exec();
 
     return eval_man.evaluated();
 }
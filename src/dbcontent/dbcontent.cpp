@@ -486,7 +486,7 @@ void DBContent::loadFiltered(dbContent::VariableSet& read_set, std::string custo
     connect(read_job_.get(), &DBContentReadDBJob::doneSignal,
             this, &DBContent::readJobDoneSlot, Qt::QueuedConnection);
 
-    JobManager::instance().addDBJob(read_job_);
+    JobManager::instance().addDBReadJob(read_job_); // in parallel to other dbcontents
 }
 
 void DBContent::quitLoading()
@@ -42,6 +42,7 @@
 #include "dbcontentdeletedbjob.h"
 #include "taskmanager.h"
 #include "asteriximporttask.h"
+#include "liveassociator.h"
 
 #include "util/tbbhack.h"
 
@@ -65,6 +66,7 @@ DBContentManager::DBContentManager(const std::string& class_id, const std::strin
 
     registerParameter("max_live_data_age_cache", &max_live_data_age_cache_, 5);
     registerParameter("max_live_data_age_db", &max_live_data_age_db_, 60);
+    registerParameter("associate_live_data", &associate_live_data_, true);
 
     createSubConfigurables();
 
@@ -488,6 +490,7 @@ void DBContentManager::databaseClosedSlot()
         object.second->databaseClosedSlot();
 
     targets_.clear();
+    live_associator_ = nullptr;
 
     timestamp_min_.reset();
     timestamp_max_.reset();
@@ -620,6 +623,7 @@ void DBContentManager::clearData()
     loginf << "DBContentManager: clearData";
 
     data_.clear();
+    live_associator_ = nullptr;
 
     COMPASS::instance().viewManager().clearDataInViews();
 }
@@ -942,6 +946,20 @@ void DBContentManager::addInsertedDataToChache()
 
     assert (label_generator_);
 
+    // set associations of new data, before db column names are transformed
+    if (associate_live_data_)
+    {
+        if (!live_associator_)
+        {
+            unsigned int first_utn = targets_.size() ? targets_.rbegin()->first + 1 : 0;
+
+            live_associator_.reset(new LiveAssociator(
+                                       COMPASS::instance().taskManager().createAssociationsTask(), first_utn));
+        }
+
+        live_associator_->associate(insert_data_);
+    }
+
     //tbb::parallel_for(uint(0), num_targets, [&](unsigned int cnt)
 
     //for (auto& buf_it : insert_data_)
@@ -985,6 +1003,17 @@ void DBContentManager::addInsertedDataToChache()
         // add selection flags
         buf_it->second->addProperty(DBContent::selected_var);
 
+        // sort new data by timestamp, cached data is kept sorted for cutCachedData
+        assert (metaVariable(DBContent::meta_var_timestamp_.name()).existsIn(buf_it->first));
+
+        Variable& ts_var = metaVariable(DBContent::meta_var_timestamp_.name()).getFor(buf_it->first);
+
+        Property ts_prop {ts_var.name(), ts_var.dataType()};
+
+        assert (buf_it->second->hasProperty(ts_prop));
+
+        buf_it->second->sortByProperty(ts_prop);
+
         // add buffer to be able to distribute to views
         if (!data_.count(buf_it->first))
         {
@@ -993,18 +1022,25 @@ void DBContentManager::addInsertedDataToChache()
         }
         else
         {
-            data_.at(buf_it->first)->seizeBuffer(*buf_it->second.get());
+            Buffer& cached_buffer = *data_.at(buf_it->first);
 
-            // sort by tod
-            assert (metaVariable(DBContent::meta_var_timestamp_.name()).existsIn(buf_it->first));
+            assert (cached_buffer.hasProperty(ts_prop));
 
-            Variable& ts_var = metaVariable(DBContent::meta_var_timestamp_.name()).getFor(buf_it->first);
+            // new data is usually newer than all cached, then appending keeps it sorted
+            NullableVector<boost::posix_time::ptime>& cached_ts_vec =
+                    cached_buffer.get<boost::posix_time::ptime>(ts_var.name());
+            NullableVector<boost::posix_time::ptime>& new_ts_vec =
+                    buf_it->second->get<boost::posix_time::ptime>(ts_var.name());
 
-            Property ts_prop {ts_var.name(), ts_var.dataType()};
+            bool keeps_order = !cached_buffer.size() || !buf_it->second->size()
+                    || (!new_ts_vec.isNull(0) && (cached_ts_vec.isNull(cached_buffer.size()-1)
+                                                  || cached_ts_vec.get(cached_buffer.size()-1)
+                                                  <= new_ts_vec.get(0)));
 
-            assert (data_.at(buf_it->first)->hasProperty(ts_prop));
+            cached_buffer.seizeBuffer(*buf_it->second.get());
 
-            data_.at(buf_it->first)->sortByProperty(ts_prop);
+            if (!keeps_order)
+                cached_buffer.sortByProperty(ts_prop);
         }
     });
 
@@ -1086,6 +1122,9 @@ void DBContentManager::cutCachedData()
     loginf << "DBContentManager: cutCachedData: current ts " << Time::toString(Time::currentUTCTime())
            << " min_ts " << Time::toString(min_ts);
 
+    if (live_associator_)
+        live_associator_->expire(min_ts);
+
     for (auto& buf_it : data_)
     {
         buffer_size = buf_it.second->size();
@@ -1101,20 +1140,28 @@ void DBContentManager::cutCachedData()
             NullableVector<boost::posix_time::ptime>& ts_vec = buf_it.second->get<boost::posix_time::ptime>(
                         ts_var.name());
 
+            // sorted by timestamp, null first, so binary search for first one bigger than min_ts
             unsigned int index=0;
+            unsigned int search_end = buffer_size;
 
-            for (; index < buffer_size; ++index)
+            while (index < search_end)
             {
-                if (!ts_vec.isNull(index) && ts_vec.get(index) > min_ts)
-                {
-                    logdbg << "DBContentManager: cutCachedData: found " << buf_it.first
-                           << " cutoff tod index " << index
-                           << " ts " << Time::toString(ts_vec.get(index));
-                    break;
-                }
+                unsigned int middle = index + (search_end - index) / 2;
+
+                if (!ts_vec.isNull(middle) && ts_vec.get(middle) > min_ts)
+                    search_end = middle;
+                else
+                    index = middle + 1;
             }
             // index == buffer_size if none bigger than min_ts
 
+            if (index < buffer_size)
+            {
+                logdbg << "DBContentManager: cutCachedData: found " << buf_it.first
+                       << " cutoff tod index " << index
+                       << " ts " << Time::toString(ts_vec.get(index));
+            }
+
             if (index) // index found
             {
                 index--; // cut at previous
@@ -35,6 +35,7 @@ class DBContent;
 class DBContentManagerWidget;
 class DBSchemaManager;
 class DBContentDeleteDBJob;
+class LiveAssociator;
 
 namespace dbContent {
 
@@ -175,6 +176,9 @@ protected:
     unsigned int max_live_data_age_cache_ {5};
     unsigned int max_live_data_age_db_ {60};
 
+    bool associate_live_data_ {true};
+    std::unique_ptr<LiveAssociator> live_associator_; // created on first live insert
+
     boost::optional<boost::posix_time::ptime> timestamp_min_;
     boost::optional<boost::posix_time::ptime> timestamp_max_;
     boost::optional<double> latitude_min_;
@@ -25,18 +25,17 @@
 #include "stringconv.h"
 #include "compass.h"
 #include "dbcontent/dbcontentmanager.h"
+#include "evaluationjob.h"
+#include "jobmanager.h"
 
 #include <QApplication>
 #include <QThread>
 #include <QProgressDialog>
 #include <QLabel>
 
-#include "util/tbbhack.h"
-
 #include "boost/date_time/posix_time/posix_time.hpp"
 
 #include <sstream>
-#include <future>
 
 using namespace std;
 using namespace Utils;
@@ -49,6 +48,12 @@ EvaluationData::EvaluationData(EvaluationManager& eval_man)
 
 }
 
+EvaluationData::~EvaluationData()
+{
+    if (finalize_job_)
+        cancelFinalize();
+}
+
 void EvaluationData::addReferenceData (DBContent& object, unsigned int line_id, std::shared_ptr<Buffer> buffer)
 {
     loginf << "EvaluationData: addReferenceData: dbcontent " << object.name() << " size " << buffer->size();
@@ -420,152 +425,103 @@ void EvaluationData::finalize ()
     loginf << "EvaluationData: finalize";
 
     assert (!finalized_);
+    assert (!finalize_job_);
 
-    boost::posix_time::ptime start_time;
-    boost::posix_time::ptime elapsed_time;
-
-    start_time = boost::posix_time::microsec_clock::local_time();
+    finalize_start_time_ = boost::posix_time::microsec_clock::local_time();
 
     unsigned int num_targets = target_data_.size();
 
     beginResetModel();
 
-    QProgressDialog postprocess_dialog_ ("", "", 0, num_targets);
-    postprocess_dialog_.setWindowTitle("Finalizing Evaluation Data");
-    postprocess_dialog_.setCancelButton(nullptr);
-    postprocess_dialog_.setWindowModality(Qt::ApplicationModal);
+    progress_dialog_.reset(new QProgressDialog("", "", 0, num_targets));
+    progress_dialog_->setWindowTitle("Finalizing Evaluation Data");
+    progress_dialog_->setCancelButton(nullptr);
+    progress_dialog_->setMinimumDuration(0);
 
-    QLabel* progress_label = new QLabel("", &postprocess_dialog_);
+    QLabel* progress_label = new QLabel("", progress_dialog_.get());
     progress_label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    postprocess_dialog_.setLabel(progress_label);
-
-    postprocess_dialog_.show();
-
-    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    progress_dialog_->setLabel(progress_label);
 
-    vector<bool> done_flags;
-    done_flags.resize(target_data_.size());
-
-    bool done = false;
-    unsigned int tmp_done_cnt;
-
-    boost::posix_time::time_duration time_diff;
-    double elapsed_time_s;
-    double time_per_eval, remaining_time_s;
-
-    string remaining_time_str;
-
-//    EvaluateTargetsFinalizeTask* t = new (tbb::task::allocate_root()) EvaluateTargetsFinalizeTask(
-//                target_data_, done_flags, done);
-//    tbb::task::enqueue(*t);
-
-    std::future<void> pending_future = std::async(std::launch::async, [&] {
-        unsigned int num_targets = target_data_.size();
-
-        tbb::parallel_for(uint(0), num_targets, [&](unsigned int cnt)
-        {
-            target_data_[cnt].finalize();
-            done_flags[cnt] = true;
-        });
-
-        done = true;
+    progress_dialog_->setValue(0);
+    progress_dialog_->show();
 
+    finalize_job_ = make_shared<EvaluationJob>("EvaluationData", num_targets, [this] (unsigned int cnt)
+    {
+        target_data_[cnt].finalize();
     });
 
-//    tbb::task_group g;
-
-//    loginf << "UGA1";
-
-//    g.run([&] {
-//        unsigned int num_targets = target_data_.size();
-
-//        tbb::parallel_for(uint(0), num_targets, [&](unsigned int cnt)
-//        {
-//            target_data_[cnt].finalize();
-//            done_flags[cnt] = true;
-//        });
-
-//        done = true;
-//    });
-
-//    loginf << "UGA2";
+    // handled in gui thread
+    connect(finalize_job_.get(), &EvaluationJob::progressSignal, this, &EvaluationData::finalizeProgressSlot);
+    connect(finalize_job_.get(), &EvaluationJob::doneSignal, this, &EvaluationData::finalizeDoneSlot);
 
-    postprocess_dialog_.setValue(0);
-
-    boost::posix_time::ptime last_elapsed_time = boost::posix_time::microsec_clock::local_time();
-    elapsed_time = boost::posix_time::microsec_clock::local_time();
-    unsigned int last_tmp_done_cnt = 0;
-
-    boost::posix_time::time_duration tmp_time_diff;
-    double tmp_elapsed_time_s;
-
-    while (!done)
-    {
-        tmp_done_cnt = 0;
-
-        for (auto done_it : done_flags)
-        {
-            if (done_it)
-                tmp_done_cnt++;
-        }
+    JobManager::instance().addNonBlockingJob(finalize_job_);
+}
 
-        assert (tmp_done_cnt <= num_targets);
+void EvaluationData::finalizeProgressSlot(unsigned int num_done, unsigned int num_targets)
+{
+    if (!progress_dialog_)
+        return;
 
-        if (tmp_done_cnt && tmp_done_cnt != last_tmp_done_cnt)
-        {
-            elapsed_time = boost::posix_time::microsec_clock::local_time();
+    boost::posix_time::time_duration time_diff =
+            boost::posix_time::microsec_clock::local_time() - finalize_start_time_;
+    double elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
+    double remaining_time_s = num_done ? (double)(num_targets-num_done) * elapsed_time_s / (double) num_done : 0;
 
-            time_diff = elapsed_time - start_time;
-            elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
+    progress_dialog_->setLabelText(
+                ("Elapsed: "+String::timeStringFromDouble(elapsed_time_s, false)
+                 +"\nRemaining: "+String::timeStringFromDouble(remaining_time_s, false)
+                 +" (estimated)").c_str());
 
-            tmp_time_diff = elapsed_time - last_elapsed_time;
-            tmp_elapsed_time_s = tmp_time_diff.total_milliseconds() / 1000.0;
+    progress_dialog_->setValue(num_done);
+}
 
-            time_per_eval = 0.95*time_per_eval + 0.05*(tmp_elapsed_time_s/(double)(tmp_done_cnt-last_tmp_done_cnt));
-            // halfnhalf
-            remaining_time_s = (double)(num_targets-tmp_done_cnt)*time_per_eval;
+void EvaluationData::finalizeDoneSlot()
+{
+    if (!finalize_job_ || sender() != finalize_job_.get()) // cleared meanwhile
+        return;
 
-            //        loginf << " UGA num_targets " << num_targets << " tmp_done_cnt " << tmp_done_cnt
-            //               << " elapsed_time_s " << elapsed_time_s;
+    assert (finalize_job_->done());
+    finalize_job_ = nullptr;
 
-            postprocess_dialog_.setLabelText(
-                        ("Elapsed: "+String::timeStringFromDouble(elapsed_time_s, false)
-                         +"\nRemaining: "+String::timeStringFromDouble(remaining_time_s, false)
-                         +" (estimated)").c_str());
+    finalized_ = true;
 
-            postprocess_dialog_.setValue(tmp_done_cnt);
+    endResetModel();
 
-            last_tmp_done_cnt = tmp_done_cnt;
-            last_elapsed_time = elapsed_time;
-        }
+    if (widget_)
+        widget_->resizeColumnsToContents();
 
-        if (!done)
-        {
-            QCoreApplication::processEvents();
-            QThread::msleep(200);
-        }
+    if (progress_dialog_)
+    {
+        progress_dialog_->close();
+        progress_dialog_ = nullptr;
     }
 
-    //    unsigned int num_targets = target_data_.size();
+    boost::posix_time::time_duration time_diff =
+            boost::posix_time::microsec_clock::local_time() - finalize_start_time_;
 
-    //    tbb::parallel_for(uint(0), num_targets, [&](unsigned int cnt)
-    //    {
-    //        target_data_[cnt].finalize();
-    //    });
+    loginf << "EvaluationData: finalizeDoneSlot: finalize done "
+           << String::timeStringFromDouble(time_diff.total_milliseconds() / 1000.0, true);
 
-    //    for (auto target_it = target_data_.begin(); target_it != target_data_.end(); ++target_it)
-    //        target_data_.modify(target_it, [&](EvaluationTargetData& t) { t.finalize(); });
+    emit finalizedSignal();
+}
 
-    finalized_ = true;
+bool EvaluationData::finalized() const
+{
+    return finalized_;
+}
 
-    endResetModel();
+void EvaluationData::cancelFinalize()
+{
+    assert (finalize_job_);
 
-    if (widget_)
-        widget_->resizeColumnsToContents();
+    loginf << "EvaluationData: cancelFinalize";
 
-    postprocess_dialog_.close();
+    finalize_job_->setObsolete();
 
-    QApplication::restoreOverrideCursor();
+    finalize_job_->waitUntilStopped(); // remaining targets are skipped, later done signal is ignored
+
+    finalize_job_ = nullptr;
+    progress_dialog_ = nullptr;
 }
 
 bool EvaluationData::hasTargetData (unsigned int utn)
@@ -582,6 +538,12 @@ const EvaluationTargetData& EvaluationData::targetData(unsigned int utn)
 
 void EvaluationData::clear()
 {
+    if (finalize_job_) // not needed anymore
+    {
+        cancelFinalize();
+        endResetModel(); // begun in finalize
+    }
+
     beginResetModel();
 
     ref_buffer_ = nullptr;
@@ -37,8 +37,10 @@
 
 
 class EvaluationManager;
+class EvaluationJob;
 class DBContent;
 class Buffer;
+class QProgressDialog;
 
 struct target_tag
 {
@@ -95,12 +97,22 @@ class EvaluationData : public QAbstractItemModel
 {
     Q_OBJECT
 
+signals:
+    void finalizedSignal();
+
+public slots:
+    void finalizeProgressSlot(unsigned int num_done, unsigned int num_targets);
+    void finalizeDoneSlot();
+
 public:
     EvaluationData(EvaluationManager& eval_man);
+    virtual ~EvaluationData();
 
     void addReferenceData (DBContent& object, unsigned int line_id, std::shared_ptr<Buffer> buffer);
     void addTestData (DBContent& object, unsigned int line_id, std::shared_ptr<Buffer> buffer);
+    // finalizes target data as background job, emits finalizedSignal when done
     void finalize ();
+    bool finalized() const;
 
     bool hasTargetData (unsigned int utn);
     const EvaluationTargetData& targetData(unsigned int utn);
@@ -204,6 +216,10 @@ protected:
     TargetCache target_data_;
     bool finalized_ {false};
 
+    std::shared_ptr<EvaluationJob> finalize_job_;
+    std::unique_ptr<QProgressDialog> progress_dialog_;
+    boost::posix_time::ptime finalize_start_time_;
+
     std::unique_ptr<EvaluationDataWidget> widget_;
     std::unique_ptr<EvaluationDataFilterDialog> dialog_;
 
@@ -212,6 +228,8 @@ protected:
 
     unsigned int unassociated_tst_cnt_ {0};
     unsigned int associated_tst_cnt_ {0};
+
+    void cancelFinalize(); // waits for targets in process only
 };
 
 #endif // EVALUATIONDATA_H
@@ -25,6 +25,8 @@
 #include "compass.h"
 #include "dbcontent/dbcontentmanager.h"
 #include "evaluationmanager.h"
+#include "sectorlayer.h"
+#include "timeconv.h"
 
 //#include <ogr_spatialref.h>
 
@@ -164,6 +166,7 @@ void EvaluationTargetData::finalize () const
     //    }
 
     calculateTestDataMappings();
+    calculateRefDataMappings();
 }
 
 unsigned int EvaluationTargetData::numUpdates () const
@@ -302,21 +305,21 @@ void EvaluationTargetData::use(bool use)
     use_ = use;
 }
 
-const std::multimap<ptime, unsigned int>& EvaluationTargetData::refData() const
+const TimeIndex& EvaluationTargetData::refData() const
 {
     return ref_data_;
 }
 
 
-const std::multimap<ptime, unsigned int>& EvaluationTargetData::tstData() const
+const TimeIndex& EvaluationTargetData::tstData() const
 {
     return tst_data_;
 }
 
 bool EvaluationTargetData::hasRefDataForTime (ptime timestamp, time_duration d_max) const
 {
-    assert (test_data_mappings_.count(timestamp));
-    TstDataMapping& mapping = test_data_mappings_.at(timestamp);
+    const TstDataMapping& mapping = testDataMapping(timestamp);
+    Time::MicroDuration d_max_us = Time::toMicroDuration(d_max);
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return false;
@@ -326,10 +329,10 @@ bool EvaluationTargetData::hasRefDataForTime (ptime timestamp, time_duration d_m
         assert (mapping.timestamp_ref1_ <= timestamp);
         assert (mapping.timestamp_ref2_ >= timestamp);
 
-        if (timestamp - mapping.timestamp_ref1_ > d_max) // lower to far
+        if (mapping.d_ref1_ > d_max_us) // lower to far
             return false;
 
-        if (mapping.timestamp_ref2_ - timestamp > d_max) // upper to far
+        if (mapping.d_ref2_ > d_max_us) // upper to far
             return false;
 
         return true;
@@ -341,8 +344,8 @@ bool EvaluationTargetData::hasRefDataForTime (ptime timestamp, time_duration d_m
 std::pair<ptime, ptime> EvaluationTargetData::refTimesFor (
         boost::posix_time::ptime timestamp, time_duration d_max)  const
 {
-    assert (test_data_mappings_.count(timestamp));
-    TstDataMapping& mapping = test_data_mappings_.at(timestamp);
+    const TstDataMapping& mapping = testDataMapping(timestamp);
+    Time::MicroDuration d_max_us = Time::toMicroDuration(d_max);
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {{}, {}};
@@ -352,10 +355,10 @@ std::pair<ptime, ptime> EvaluationTargetData::refTimesFor (
         assert (mapping.timestamp_ref1_ <= timestamp);
         assert (mapping.timestamp_ref2_ >= timestamp);
 
-        if (timestamp - mapping.timestamp_ref1_ > d_max) // lower to far
+        if (mapping.d_ref1_ > d_max_us) // lower to far
             return {{}, {}};
 
-        if (mapping.timestamp_ref2_ - timestamp > d_max) // upper to far
+        if (mapping.d_ref2_ > d_max_us) // upper to far
             return {{}, {}};
 
         return {mapping.timestamp_ref1_, mapping.timestamp_ref2_};
@@ -367,8 +370,8 @@ std::pair<ptime, ptime> EvaluationTargetData::refTimesFor (
 std::pair<EvaluationTargetPosition, bool>  EvaluationTargetData::interpolatedRefPosForTime (
         ptime timestamp, time_duration d_max) const
 {
-    assert (test_data_mappings_.count(timestamp));
-    TstDataMapping& mapping = test_data_mappings_.at(timestamp);
+    const TstDataMapping& mapping = testDataMapping(timestamp);
+    Time::MicroDuration d_max_us = Time::toMicroDuration(d_max);
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {{}, false};
@@ -378,7 +381,7 @@ std::pair<EvaluationTargetPosition, bool>  EvaluationTargetData::interpolatedRef
         assert (mapping.timestamp_ref1_ <= timestamp);
         assert (mapping.timestamp_ref2_ >= timestamp);
 
-        if (timestamp - mapping.timestamp_ref1_ > d_max) // lower to far
+        if (mapping.d_ref1_ > d_max_us) // lower to far
         {
             //            if (utn_ == debug_utn)
             //                loginf << "EvaluationTargetData: interpolatedRefPosForTime: lower too far";
@@ -386,7 +389,7 @@ std::pair<EvaluationTargetPosition, bool>  EvaluationTargetData::interpolatedRef
             return {{}, false};
         }
 
-        if (mapping.timestamp_ref2_ - timestamp > d_max) // upper to far
+        if (mapping.d_ref2_ > d_max_us) // upper to far
         {
             //            if (utn_ == debug_utn)
             //                loginf << "EvaluationTargetData: interpolatedRefPosForTime: upper too far";
@@ -417,8 +420,8 @@ std::pair<EvaluationTargetPosition, bool>  EvaluationTargetData::interpolatedRef
 std::pair<EvaluationTargetVelocity, bool>  EvaluationTargetData::interpolatedRefPosBasedSpdForTime (
         ptime timestamp, time_duration d_max) const
 {
-    assert (test_data_mappings_.count(timestamp));
-    TstDataMapping& mapping = test_data_mappings_.at(timestamp);
+    const TstDataMapping& mapping = testDataMapping(timestamp);
+    Time::MicroDuration d_max_us = Time::toMicroDuration(d_max);
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {{}, false};
@@ -428,7 +431,7 @@ std::pair<EvaluationTargetVelocity, bool>  EvaluationTargetData::interpolatedRef
         assert (mapping.timestamp_ref1_ <= timestamp);
         assert (mapping.timestamp_ref2_ >= timestamp);
 
-        if (timestamp - mapping.timestamp_ref1_ > d_max) // lower to far
+        if (mapping.d_ref1_ > d_max_us) // lower to far
         {
             //            if (utn_ == debug_utn)
             //                loginf << "EvaluationTargetData: interpolatedRefPosForTime: lower too far";
@@ -436,7 +439,7 @@ std::pair<EvaluationTargetVelocity, bool>  EvaluationTargetData::interpolatedRef
             return {{}, false};
         }
 
-        if (mapping.timestamp_ref2_ - timestamp > d_max) // upper to far
+        if (mapping.d_ref2_ > d_max_us) // upper to far
         {
             //            if (utn_ == debug_utn)
             //                loginf << "EvaluationTargetData: interpolatedRefPosForTime: upper too far";
@@ -825,12 +828,11 @@ std::pair<bool,bool> EvaluationTargetData::refGroundBitForTime (ptime timestamp)
 std::pair<bool,bool> EvaluationTargetData::interpolatedRefGroundBitForTime (ptime timestamp, time_duration d_max) const
 // has gbs, gbs true
 {
-    assert (test_data_mappings_.count(timestamp));
-
     bool has_gbs = false;
     bool gbs = false;
 
-    TstDataMapping& mapping = test_data_mappings_.at(timestamp);
+    const TstDataMapping& mapping = testDataMapping(timestamp);
+    Time::MicroDuration d_max_us = Time::toMicroDuration(d_max);
 
     if (!mapping.has_ref1_ && !mapping.has_ref2_) // no ref data
         return {has_gbs, gbs};
@@ -840,10 +842,10 @@ std::pair<bool,bool> EvaluationTargetData::interpolatedRefGroundBitForTime (ptim
         assert (mapping.timestamp_ref1_ <= timestamp);
         assert (mapping.timestamp_ref2_ >= timestamp);
 
-        if (timestamp - mapping.timestamp_ref1_ > d_max) // lower to far
+        if (mapping.d_ref1_ > d_max_us) // lower to far
             return {has_gbs, gbs};
 
-        if (mapping.timestamp_ref2_ - timestamp > d_max) // upper to far
+        if (mapping.d_ref2_ > d_max_us) // upper to far
             return {has_gbs, gbs};
 
         tie (has_gbs, gbs) = refGroundBitForTime(mapping.timestamp_ref1_);
@@ -1511,6 +1513,148 @@ bool EvaluationTargetData::hasNacp() const
     return has_nacp;
 }
 
+const std::vector<bool>& EvaluationTargetData::refPosInsideForTst(const SectorLayer& sector_layer) const
+{
+    auto it = ref_pos_inside_for_tst_.find(sector_layer.name());
+
+    if (it != ref_pos_inside_for_tst_.end())
+        return it->second;
+
+    time_duration max_ref_time_diff = Time::partialSeconds(eval_man_->maxRefTimeDiff());
+
+    size_t num_tst = tst_data_.size();
+
+    vector<EvaluationTargetPosition> positions (num_tst);
+    vector<bool> has_pos (num_tst, false);
+    vector<bool> has_ground_bits (num_tst, false);
+    vector<bool> ground_bits_set (num_tst, false);
+
+    bool ok;
+    bool has_ground_bit, ground_bit_set;
+    size_t tst_cnt = 0;
+
+    for (auto& tst_it : tst_data_)
+    {
+        tie(positions[tst_cnt], ok) = interpolatedRefPosForTime(tst_it.first, max_ref_time_diff);
+
+        if (ok)
+        {
+            has_pos[tst_cnt] = true;
+
+            tie(has_ground_bit, ground_bit_set) = groundBitForTstTime(tst_it.first);
+            has_ground_bits[tst_cnt] = has_ground_bit;
+            ground_bits_set[tst_cnt] = ground_bit_set;
+        }
+
+        ++tst_cnt;
+    }
+
+    vector<bool>& inside = ref_pos_inside_for_tst_[sector_layer.name()];
+    inside = sector_layer.isInside(positions, has_ground_bits, ground_bits_set);
+
+    for (tst_cnt = 0; tst_cnt < num_tst; ++tst_cnt)
+    {
+        if (!has_pos[tst_cnt])
+            inside[tst_cnt] = false;
+    }
+
+    return inside;
+}
+
+const std::vector<bool>& EvaluationTargetData::tstPosInside(const SectorLayer& sector_layer) const
+{
+    auto it = tst_pos_inside_.find(sector_layer.name());
+
+    if (it != tst_pos_inside_.end())
+        return it->second;
+
+    size_t num_tst = tst_data_.size();
+
+    vector<EvaluationTargetPosition> positions;
+    vector<bool> has_ground_bits;
+    vector<bool> ground_bits_set;
+
+    positions.reserve(num_tst);
+    has_ground_bits.reserve(num_tst);
+    ground_bits_set.reserve(num_tst);
+
+    bool has_ground_bit, ground_bit_set;
+
+    for (auto& tst_it : tst_data_)
+    {
+        positions.push_back(tstPosForTime(tst_it.first));
+
+        tie(has_ground_bit, ground_bit_set) = groundBitForTstTime(tst_it.first);
+        has_ground_bits.push_back(has_ground_bit);
+        ground_bits_set.push_back(ground_bit_set);
+    }
+
+    vector<bool>& inside = tst_pos_inside_[sector_layer.name()];
+    inside = sector_layer.isInside(positions, has_ground_bits, ground_bits_set);
+
+    return inside;
+}
+
+const std::vector<bool>& EvaluationTargetData::refPosInside(const SectorLayer& sector_layer) const
+{
+    auto it = ref_pos_inside_.find(sector_layer.name());
+
+    if (it != ref_pos_inside_.end())
+        return it->second;
+
+    size_t num_ref = ref_data_.size();
+
+    vector<EvaluationTargetPosition> positions;
+    vector<bool> has_ground_bits;
+    vector<bool> ground_bits_set;
+
+    positions.reserve(num_ref);
+    has_ground_bits.reserve(num_ref);
+    ground_bits_set.reserve(num_ref);
+
+    bool has_ground_bit, ground_bit_set;
+
+    for (auto& ref_it : ref_data_)
+    {
+        positions.push_back(refPosForTime(ref_it.first));
+
+        // for ref
+        tie (has_ground_bit, ground_bit_set) = refGroundBitForTime(ref_it.first);
+        // for tst
+        if (!ground_bit_set)
+            tie (has_ground_bit, ground_bit_set) = tstGroundBitForTimeInterpolated(ref_it.first);
+
+        has_ground_bits.push_back(has_ground_bit);
+        ground_bits_set.push_back(ground_bit_set);
+    }
+
+    vector<bool>& inside = ref_pos_inside_[sector_layer.name()];
+    inside = sector_layer.isInside(positions, has_ground_bits, ground_bits_set);
+
+    return inside;
+}
+
+void EvaluationTargetData::clearInsideCache() const
+{
+    ref_pos_inside_for_tst_.clear();
+    tst_pos_inside_.clear();
+    ref_pos_inside_.clear();
+}
+
+std::pair<bool,bool> EvaluationTargetData::groundBitForTstTime (ptime timestamp) const // has gbs, gbs true
+{
+    bool has_ground_bit = hasTstGroundBitForTime(timestamp);
+    bool ground_bit_set = false;
+
+    if (has_ground_bit)
+        ground_bit_set = tstGroundBitForTime(timestamp);
+
+    if (!ground_bit_set)
+        tie(has_ground_bit, ground_bit_set) = interpolatedRefGroundBitForTime(timestamp, seconds(15));
+
+    return {has_ground_bit, ground_bit_set};
+}
+
 //std::set<unsigned int> EvaluationTargetData::NACPs() const
 //{
 //    return nacps_;
@@ -1908,16 +2052,48 @@ void EvaluationTargetData::calculateTestDataMappings() const
 
     assert (!test_data_mappings_.size());
 
-    for (auto& tst_it : tst_data_)
-    {
-        test_data_mappings_[tst_it.first] = calculateTestDataMapping(tst_it.first);
-    }
+    test_data_mappings_.resize(tst_data_.size());
 
+    // both indexes are sorted, so the first ref time >= tst time only moves forward
+    auto ref_it = ref_data_.begin();
     unsigned int cnt=0;
 
-    for (auto& tst_map_it : test_data_mappings_)
+    for (size_t tst_cnt=0; tst_cnt < tst_data_.size(); ++tst_cnt)
     {
-        if (tst_map_it.second.has_ref_pos_)
+        const ptime& timestamp = tst_data_[tst_cnt].first;
+        TstDataMapping& mapping = test_data_mappings_[tst_cnt];
+
+        if (tst_cnt && tst_data_[tst_cnt-1].first == timestamp) // same time as previous, reuse
+        {
+            mapping = test_data_mappings_[tst_cnt-1];
+        }
+        else
+        {
+            while (ref_it != ref_data_.end() && ref_it->first < timestamp)
+                ++ref_it;
+
+            mapping.timestamp_ = timestamp;
+
+            // upper is the first ref time >= timestamp, lower the ref time before it
+            if (ref_it != ref_data_.end() && ref_it != ref_data_.begin())
+            {
+                assert (ref_it->first >= timestamp);
+                assert ((ref_it-1)->first < timestamp);
+
+                mapping.has_ref1_ = true;
+                mapping.timestamp_ref1_ = (ref_it-1)->first;
+
+                mapping.has_ref2_ = true;
+                mapping.timestamp_ref2_ = ref_it->first;
+
+                mapping.d_ref1_ = Time::toMicroDuration(timestamp - mapping.timestamp_ref1_);
+                mapping.d_ref2_ = Time::toMicroDuration(mapping.timestamp_ref2_ - timestamp);
+            }
+
+            addRefPositiosToMapping(mapping);
+        }
+
+        if (mapping.has_ref_pos_)
             ++cnt;
     }
 
@@ -1925,60 +2101,42 @@ void EvaluationTargetData::calculateTestDataMappings() const
            << test_data_mappings_.size() << " ref pos " << cnt;
 }
 
-TstDataMapping EvaluationTargetData::calculateTestDataMapping(ptime timestamp) const
+void EvaluationTargetData::calculateRefDataMappings() const
 {
-    TstDataMapping ret;
+    assert (!ref_data_mappings_.size());
 
-    ret.timestamp_ = timestamp;
+    ref_data_mappings_.resize(ref_data_.size());
 
-    //    Return iterator to lower bound
-    //    Returns an iterator pointing to the first element in the container whose key is not considered to go
-    //    before k (i.e., either it is equivalent or goes after).
+    auto tst_it = tst_data_.begin();
 
-    auto lb_it = ref_data_.lower_bound(timestamp);
-
-    //auto ub_it = ref_data_.upper_bound(tod);
-
-    if (lb_it != ref_data_.end()) // upper tod found
+    for (size_t ref_cnt=0; ref_cnt < ref_data_.size(); ++ref_cnt)
     {
-        assert (lb_it->first >= timestamp);
+        const ptime& timestamp = ref_data_[ref_cnt].first;
+        DataMappingTimes& times = ref_data_mappings_[ref_cnt];
 
-        // save upper value
-        ret.has_ref2_ = true;
-        ret.timestamp_ref2_ = lb_it->first;
+        while (tst_it != tst_data_.end() && tst_it->first < timestamp)
+            ++tst_it;
 
-        // search lower values by decrementing iterator
-        while (lb_it != ref_data_.end() && (timestamp < lb_it->first || lb_it->first == ret.timestamp_ref2_))
-        {
-            if (lb_it == ref_data_.begin()) // exit condition on first value
-            {
-                if (timestamp < lb_it->first) // set as not found
-                    lb_it = ref_data_.end();
-
-                break;
-            }
+        times.timestamp_ = timestamp;
 
-            lb_it--;
-        }
-
-        if (lb_it != ref_data_.end() && lb_it->first != ret.timestamp_ref2_) // lower tod found
+        if (tst_it != tst_data_.end() && tst_it != tst_data_.begin())
         {
-            assert (timestamp >= lb_it->first);
+            times.has_other1_ = true;
+            times.timestamp_other1_ = (tst_it-1)->first;
 
-            // add lower value
-            ret.has_ref1_ = true;
-            ret.timestamp_ref1_ = lb_it->first;
-        }
-        else // not found, clear previous
-        {
-            ret.has_ref2_ = false;
-            ret.timestamp_ref2_ = {};
+            times.has_other2_ = true;
+            times.timestamp_other2_ = tst_it->first;
         }
     }
+}
+
+const TstDataMapping& EvaluationTargetData::testDataMapping(ptime timestamp) const
+{
+    size_t pos = tst_data_.find(timestamp);
 
-    addRefPositiosToMapping(ret);
+    assert (pos < test_data_mappings_.size());
 
-    return ret;
+    return test_data_mappings_[pos];
 }
 
 void EvaluationTargetData::addRefPositiosToMapping (TstDataMapping& mapping) const
@@ -2225,51 +2383,25 @@ void EvaluationTargetData::addRefPositiosToMappingFast (TstDataMapping& mapping)
 
 DataMappingTimes EvaluationTargetData::findTstTimes(ptime timestamp_ref) const // ref tod
 {
+    size_t pos = ref_data_.find(timestamp_ref);
+
+    if (pos < ref_data_mappings_.size()) // ref time, precalculated
+        return ref_data_mappings_[pos];
+
     DataMappingTimes ret;
 
     ret.timestamp_ = timestamp_ref;
 
-    //    Return iterator to lower bound
-    //    Returns an iterator pointing to the first element in the container whose key is not considered to go
-    //    before k (i.e., either it is equivalent or goes after).
-
+    // upper is the first tst time >= timestamp, lower the tst time before it
     auto lb_it = tst_data_.lower_bound(timestamp_ref);
 
-    if (lb_it != tst_data_.end()) // upper tod found
+    if (lb_it != tst_data_.end() && lb_it != tst_data_.begin())
     {
-        assert (lb_it->first >= timestamp_ref);
+        ret.has_other1_ = true;
+        ret.timestamp_other1_ = (lb_it-1)->first;
 
-        // save upper value
         ret.has_other2_ = true;
         ret.timestamp_other2_ = lb_it->first;
-
-        // search lower values by decrementing iterator
-        while (lb_it != tst_data_.end() && (timestamp_ref < lb_it->first || lb_it->first == ret.timestamp_other2_))
-        {
-            if (lb_it == tst_data_.begin()) // exit condition on first value
-            {
-                if (timestamp_ref < lb_it->first) // set as not found
-                    lb_it = tst_data_.end();
-
-                break;
-            }
-
-            lb_it--;
-        }
-
-        if (lb_it != tst_data_.end() && lb_it->first != ret.timestamp_other2_) // lower tod found
-        {
-            assert (timestamp_ref >= lb_it->first);
-
-            // add lower value
-            ret.has_other1_ = true;
-            ret.timestamp_other1_ = lb_it->first;
-        }
-        else // not found, clear previous
-        {
-            ret.has_other2_ = false;
-            ret.timestamp_other2_ = {};
-        }
     }
 
     return ret;
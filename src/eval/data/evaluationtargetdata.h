@@ -20,7 +20,9 @@
 
 #include "evaluationtargetposition.h"
 #include "evaluationtargetvelocity.h"
+#include "timeindex.h"
 #include "projection/transformation.h"
+#include "util/timeconv.h"
 
 #include "boost/date_time/posix_time/ptime.hpp"
 
@@ -33,6 +35,7 @@
 class Buffer;
 class EvaluationData;
 class EvaluationManager;
+class SectorLayer;
 //class Transformation;
 
 //class OGRSpatialReference;
@@ -49,6 +52,10 @@ public:
     bool has_ref2_ {false};
     boost::posix_time::ptime timestamp_ref2_;
 
+    // time differences of ref1/ref2 to test time, to check max time differences without ptime arithmetic
+    Utils::Time::MicroDuration d_ref1_ {0};
+    Utils::Time::MicroDuration d_ref2_ {0};
+
     bool has_ref_pos_ {false};
     EvaluationTargetPosition pos_ref_;
 
@@ -116,8 +123,8 @@ public:
     bool use() const;
     void use(bool use);
 
-    const std::multimap<boost::posix_time::ptime, unsigned int>& refData() const;
-    const std::multimap<boost::posix_time::ptime, unsigned int>& tstData() const;
+    const TimeIndex& refData() const;
+    const TimeIndex& tstData() const;
 
     // ref
     bool hasRefDataForTime (boost::posix_time::ptime timestamp, boost::posix_time::time_duration d_max) const;
@@ -209,6 +216,18 @@ public:
     bool hasNacp() const;
     std::string nacpStr() const;
 
+    // inside sector layer flags, computed once per layer and cached until clearInsideCache
+    // per tst update (in tstData order), interpolated ref pos with max ref time diff, false if none
+    const std::vector<bool>& refPosInsideForTst(const SectorLayer& sector_layer) const;
+    // per tst update (in tstData order), tst pos
+    const std::vector<bool>& tstPosInside(const SectorLayer& sector_layer) const;
+    // per ref update (in refData order), ref pos
+    const std::vector<bool>& refPosInside(const SectorLayer& sector_layer) const;
+    void clearInsideCache() const;
+
+    // tst ground bit, if not set interpolated ref ground bit
+    std::pair<bool,bool> groundBitForTstTime (boost::posix_time::ptime timestamp) const; // has gbs, gbs true
+
 protected:
     //static bool in_appimage_;
 
@@ -217,10 +236,10 @@ protected:
 
     bool use_ {true};
 
-    std::multimap<boost::posix_time::ptime, unsigned int> ref_data_; // timestamp -> index
+    TimeIndex ref_data_; // timestamp -> index
     mutable std::vector<unsigned int> ref_indexes_;
 
-    std::multimap<boost::posix_time::ptime, unsigned int> tst_data_; // timestamp -> index
+    TimeIndex tst_data_; // timestamp -> index
     mutable std::vector<unsigned int> tst_indexes_;
 
     mutable std::set<std::string> callsigns_;
@@ -246,7 +265,13 @@ protected:
     mutable bool has_nacp {false};
     mutable unsigned int min_nacp_, max_nacp_;
 
-    mutable std::map<boost::posix_time::ptime, TstDataMapping> test_data_mappings_;
+    mutable std::vector<TstDataMapping> test_data_mappings_; // parallel to tst_data_
+    mutable std::vector<DataMappingTimes> ref_data_mappings_; // parallel to ref_data_, tst times
+
+    // sector layer name -> inside flags
+    mutable std::map<std::string, std::vector<bool>> ref_pos_inside_for_tst_;
+    mutable std::map<std::string, std::vector<bool>> tst_pos_inside_;
+    mutable std::map<std::string, std::vector<bool>> ref_pos_inside_;
 
 //    std::unique_ptr<OGRSpatialReference> wgs84_;
 //    mutable std::unique_ptr<OGRSpatialReference> local_;
@@ -262,7 +287,8 @@ protected:
     //void updateADSBInfo() const;
 
     void calculateTestDataMappings() const;
-    TstDataMapping calculateTestDataMapping(boost::posix_time::ptime timestamp) const; // test tod
+    void calculateRefDataMappings() const;
+    const TstDataMapping& testDataMapping(boost::posix_time::ptime timestamp) const; // test tod
     void addRefPositiosToMapping (TstDataMapping& mapping) const;
     void addRefPositiosToMappingFast (TstDataMapping& mapping) const;
 
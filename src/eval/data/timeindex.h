@@ -0,0 +1,110 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TIMEINDEX_H
+#define TIMEINDEX_H
+
+#include "boost/date_time/posix_time/ptime.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Sorted timestamp -> buffer index entries, stored contiguously
+ *
+ * Drop-in replacement for the former std::multimap<ptime, unsigned int>: iteration yields pairs in
+ * timestamp order, entries with equal timestamps keep their insertion order. Lookups are binary
+ * searches, and entries can also be addressed by their position, which allows keeping data parallel
+ * to the index in plain vectors.
+ *
+ * Since data is added mostly in time order, insert appends in the common case and only inserts in
+ * the middle for out-of-order timestamps.
+ */
+class TimeIndex
+{
+  public:
+    typedef std::pair<boost::posix_time::ptime, unsigned int> Entry;
+    typedef std::vector<Entry>::const_iterator const_iterator;
+    typedef std::vector<Entry>::const_reverse_iterator const_reverse_iterator;
+
+    void insert(const Entry& entry)
+    {
+        if (entries_.empty() || entries_.back().first <= entry.first)
+            entries_.push_back(entry);
+        else
+            entries_.insert(upper_bound(entry.first), entry);
+    }
+
+    size_t size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    const Entry& operator[](size_t pos) const { return entries_[pos]; }
+
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    const_reverse_iterator rbegin() const { return entries_.rbegin(); }
+    const_reverse_iterator rend() const { return entries_.rend(); }
+
+    const_iterator lower_bound(boost::posix_time::ptime timestamp) const
+    {
+        return std::lower_bound(entries_.begin(), entries_.end(), timestamp,
+                                [](const Entry& entry, const boost::posix_time::ptime& ts)
+                                { return entry.first < ts; });
+    }
+
+    const_iterator upper_bound(boost::posix_time::ptime timestamp) const
+    {
+        return std::upper_bound(entries_.begin(), entries_.end(), timestamp,
+                                [](const boost::posix_time::ptime& ts, const Entry& entry)
+                                { return ts < entry.first; });
+    }
+
+    std::pair<const_iterator, const_iterator> equal_range(boost::posix_time::ptime timestamp) const
+    {
+        const_iterator lb_it = lower_bound(timestamp);
+        const_iterator ub_it = lb_it;
+
+        while (ub_it != entries_.end() && ub_it->first == timestamp)
+            ++ub_it;
+
+        return {lb_it, ub_it};
+    }
+
+    size_t count(boost::posix_time::ptime timestamp) const
+    {
+        std::pair<const_iterator, const_iterator> it_pair = equal_range(timestamp);
+        return it_pair.second - it_pair.first;
+    }
+
+    // position of the first entry with timestamp, size() if not contained
+    size_t find(boost::posix_time::ptime timestamp) const
+    {
+        const_iterator lb_it = lower_bound(timestamp);
+
+        if (lb_it == entries_.end() || lb_it->first != timestamp)
+            return entries_.size();
+
+        return lb_it - entries_.begin();
+    }
+
+  protected:
+    std::vector<Entry> entries_;
+};
+
+#endif // TIMEINDEX_H
@@ -0,0 +1,95 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "evaluationjob.h"
+#include "logger.h"
+#include "stringconv.h"
+
+#include "util/tbbhack.h"
+
+#include "boost/date_time/posix_time/posix_time.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+using namespace Utils;
+
+EvaluationJob::EvaluationJob(const std::string& name, unsigned int num_targets,
+                             std::function<void(unsigned int)> target_func)
+    : Job(name), num_targets_(num_targets), target_func_(target_func)
+{
+}
+
+EvaluationJob::~EvaluationJob() {}
+
+void EvaluationJob::run()
+{
+    loginf << "EvaluationJob: run: " << name_ << " targets " << num_targets_;
+    started_ = true;
+
+    boost::posix_time::ptime start_time = boost::posix_time::microsec_clock::local_time();
+
+    unsigned int progress_step = max(1u, num_targets_ / 100);
+
+    tbb::parallel_for(uint(0), num_targets_, [&](unsigned int target_cnt)
+    {
+        {
+            std::lock_guard<std::mutex> lock(running_mutex_);
+
+            if (obsolete_) // skip remaining
+                return;
+
+            ++num_running_;
+        }
+
+        target_func_(target_cnt);
+
+        {
+            std::lock_guard<std::mutex> lock(running_mutex_);
+            --num_running_;
+        }
+
+        running_condition_.notify_all();
+
+        unsigned int done_cnt = ++done_cnt_;
+
+        if (done_cnt % progress_step == 0 || done_cnt == num_targets_)
+            emit progressSignal(done_cnt, num_targets_);
+    });
+
+    boost::posix_time::time_duration time_diff = boost::posix_time::microsec_clock::local_time() - start_time;
+
+    loginf << "EvaluationJob: run: " << name_ << (obsolete_ ? " canceled" : " done") << " after "
+           << String::timeStringFromDouble(time_diff.total_milliseconds() / 1000.0, true);
+
+    done_ = true;
+}
+
+void EvaluationJob::setObsolete()
+{
+    std::lock_guard<std::mutex> lock(running_mutex_);
+    Job::setObsolete();
+}
+
+void EvaluationJob::waitUntilStopped()
+{
+    assert (obsolete_);
+
+    std::unique_lock<std::mutex> lock(running_mutex_);
+    running_condition_.wait(lock, [this] { return num_running_ == 0; });
+}
@@ -0,0 +1,69 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVALUATIONJOB_H
+#define EVALUATIONJOB_H
+
+#include "job.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+
+/**
+ * @brief Job calling a function for each target index in parallel, used for evaluation data finalizing
+ * and requirement evaluation
+ *
+ * Progress is counted atomically and reported with progressSignal in steps of about one percent, so
+ * the GUI thread does not have to poll. If set obsolete, the remaining targets are skipped, and
+ * waitUntilStopped returns as soon as the targets in process are finished, without waiting for the job
+ * to be started or done.
+ */
+class EvaluationJob : public Job
+{
+    Q_OBJECT
+
+signals:
+    void progressSignal(unsigned int num_done, unsigned int num_targets);
+
+public:
+    EvaluationJob(const std::string& name, unsigned int num_targets,
+                  std::function<void(unsigned int)> target_func);
+    virtual ~EvaluationJob();
+
+    virtual void run();
+
+    virtual void setObsolete() override;
+    // after set obsolete, waits until the target function is not called anymore
+    void waitUntilStopped();
+
+    unsigned int numTargets() const { return num_targets_; }
+    unsigned int numDone() const { return done_cnt_; }
+
+protected:
+    unsigned int num_targets_;
+    std::function<void(unsigned int)> target_func_; // called with target index
+
+    std::atomic<unsigned int> done_cnt_ {0};
+
+    std::mutex running_mutex_;
+    std::condition_variable running_condition_;
+    unsigned int num_running_ {0}; // number of target function calls in process
+};
+
+#endif // EVALUATIONJOB_H
@@ -207,6 +207,8 @@ EvaluationManager::EvaluationManager(const std::string& class_id, const std::str
     registerParameter("warning_shown", &warning_shown_, false);
 
     createSubConfigurables();
+
+    connect(&data_, &EvaluationData::finalizedSignal, this, &EvaluationManager::dataFinalizedSlot);
 }
 
 void EvaluationManager::init(QTabWidget* tab_widget)
@@ -234,6 +236,9 @@ bool EvaluationManager::canLoadData ()
 {
     assert (initialized_);
 
+    if (evaluationRunning())
+        return false;
+
     return COMPASS::instance().dbContentManager().hasAssociations() && hasCurrentStandard();
 }
 
@@ -514,7 +519,7 @@ bool EvaluationManager::canEvaluate ()
 {
     assert (initialized_);
 
-    if (!data_loaded_ || !hasCurrentStandard())
+    if (!data_loaded_ || !hasCurrentStandard() || evaluationRunning())
         return false;
 
     if (!compass_.dbContentManager().hasAssociations())
@@ -567,6 +572,9 @@ std::string EvaluationManager::getCannotEvaluateComment()
     if (!hasSelectedTestDataSources())
         return "Please select test data sources";
 
+    if (evaluationRunning())
+        return "Evaluation running";
+
     if (!data_loaded_)
         return "Please load reference & test data";
 
@@ -614,6 +622,8 @@ void EvaluationManager::databaseClosedSlot()
 {
     loginf << "EvaluationManager: databaseClosedSlot";
 
+    results_gen_.abortEvaluation(); // sectors & data are cleared
+
     sector_layers_.clear();
 
     sectors_loaded_ = false;
@@ -697,14 +707,9 @@ void EvaluationManager::loadingDoneSlot()
     {
         loginf << "EvaluationManager: loadingDoneSlot: finalizing";
 
-        boost::posix_time::ptime start_time = boost::posix_time::microsec_clock::local_time();
-
-        data_.finalize();
+        data_.finalize(); // data loaded when finalized
 
-        boost::posix_time::time_duration time_diff =  boost::posix_time::microsec_clock::local_time() - start_time;
-
-        loginf << "EvaluationManager: loadingDoneSlot: finalize done "
-                   << String::timeStringFromDouble(time_diff.total_milliseconds() / 1000.0, true);
+        return;
     }
 
     data_loaded_ = data_loaded_tmp;
@@ -714,6 +719,16 @@ void EvaluationManager::loadingDoneSlot()
 
 }
 
+void EvaluationManager::dataFinalizedSlot()
+{
+    loginf << "EvaluationManager: dataFinalizedSlot";
+
+    data_loaded_ = reference_data_loaded_ && test_data_loaded_;
+
+    if (widget_)
+        widget_->updateButtons();
+}
+
 //void EvaluationManager::newDataSlot(DBContent& object)
 //{
 //    //loginf << "EvaluationManager: newDataSlot: obj " << object.name() << " buffer size " << object.data()->size();
@@ -781,37 +796,56 @@ void EvaluationManager::loadingDoneSlot()
 //        widget_->updateButtons();
 //}
 
-void EvaluationManager::evaluate ()
+void EvaluationManager::evaluate (bool show_progress)
 {
     loginf << "EvaluationManager: evaluate";
 
     assert (initialized_);
     assert (data_loaded_);
     assert (hasCurrentStandard());
+    assert (!evaluationRunning());
 
     // clean previous
     results_gen_.clear();
 
     evaluated_ = false;
 
+    // eval
+    results_gen_.evaluate(data_, currentStandard(), show_progress);
+
     if (widget_)
         widget_->updateButtons();
 
     emit resultsChangedSignal();
+}
 
-    // eval
-    results_gen_.evaluate(data_, currentStandard());
+bool EvaluationManager::evaluationRunning() const
+{
+    return results_gen_.evaluationRunning();
+}
+
+void EvaluationManager::cancelEvaluation()
+{
+    results_gen_.cancelEvaluation();
+}
 
-    evaluated_ = true;
+void EvaluationManager::finishEvaluation(bool evaluated)
+{
+    loginf << "EvaluationManager: finishEvaluation: evaluated " << evaluated;
+
+    evaluated_ = evaluated;
 
     if (widget_)
     {
         widget_->updateButtons();
-        widget_->expandResults();
+
+        if (evaluated_)
+            widget_->expandResults();
         //widget_->showResultId("")
     }
 
     emit resultsChangedSignal();
+    emit evaluationDoneSignal();
 }
 
 bool EvaluationManager::canGenerateReport ()
@@ -1011,6 +1045,12 @@ void EvaluationManager::createNewSector (const std::string& name, const std::str
     loginf << "EvaluationManager: createNewSector: name " << name << " layer_name " << layer_name
            << " num points " << points.size();
 
+    if (evaluationRunning())
+    {
+        logerr << "EvaluationManager: createNewSector: not possible while evaluation is running";
+        return;
+    }
+
     assert (sectors_loaded_);
     assert (!hasSector(name, layer_name));
 
@@ -1131,6 +1171,12 @@ void EvaluationManager::saveSector(std::shared_ptr<Sector> sector)
 
 void EvaluationManager::deleteSector(shared_ptr<Sector> sector)
 {
+    if (evaluationRunning())
+    {
+        logerr << "EvaluationManager: deleteSector: not possible while evaluation is running";
+        return;
+    }
+
     assert (sectors_loaded_);
     assert (hasSector(sector->name(), sector->layerName()));
 
@@ -1160,6 +1206,12 @@ void EvaluationManager::deleteSector(shared_ptr<Sector> sector)
 
 void EvaluationManager::deleteAllSectors()
 {
+    if (evaluationRunning())
+    {
+        logerr << "EvaluationManager: deleteAllSectors: not possible while evaluation is running";
+        return;
+    }
+
     assert (sectors_loaded_);
     sector_layers_.clear();
 
@@ -1176,6 +1228,12 @@ void EvaluationManager::importSectors (const std::string& filename)
 {
     loginf << "EvaluationManager: importSectors: filename '" << filename << "'";
 
+    if (evaluationRunning())
+    {
+        logerr << "EvaluationManager: importSectors: not possible while evaluation is running";
+        return;
+    }
+
     assert (sectors_loaded_);
 
     sector_layers_.clear();
@@ -1471,6 +1529,12 @@ void EvaluationManager::deleteCurrentStandard()
 {
     loginf << "EvaluationManager: deleteCurrentStandard: name " << current_standard_;
 
+    if (evaluationRunning())
+    {
+        logerr << "EvaluationManager: deleteCurrentStandard: not possible while evaluation is running";
+        return;
+    }
+
     assert (hasCurrentStandard());
 
     string name = current_standard_;
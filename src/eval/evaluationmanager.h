@@ -56,6 +56,7 @@ signals:
     void currentStandardChangedSignal(); // emitted if current standard was changed
 
     void resultsChangedSignal();
+    void evaluationDoneSignal(); // emitted when evaluation finished or was canceled
 
 public slots:
     void databaseOpenedSlot();
@@ -64,6 +65,7 @@ public slots:
 
     void loadedDataDataSlot(const std::map<std::string, std::shared_ptr<Buffer>>& data, bool requires_reset);
     void loadingDoneSlot();
+    void dataFinalizedSlot();
 
 //    void newDataSlot(DBContent& object);
 //    void loadingDoneSlot(DBContent& object);
@@ -79,7 +81,11 @@ public:
     void autofilterUTNs();
     bool canEvaluate ();
     std::string getCannotEvaluateComment();
-    void evaluate ();
+    // runs in background, evaluationDoneSignal is emitted when done
+    void evaluate (bool show_progress=true);
+    bool evaluationRunning() const;
+    void cancelEvaluation();
+    void finishEvaluation(bool evaluated); // called by EvaluationResultsGenerator when done
     bool canGenerateReport ();
     void generateReport ();
 
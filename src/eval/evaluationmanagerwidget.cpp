@@ -123,13 +123,17 @@ void EvaluationManagerWidget::updateSectors()
 
 void EvaluationManagerWidget::updateButtons()
 {
-    load_button_->setEnabled(eval_man_.anySectorsWithReq()
+    load_button_->setEnabled(!eval_man_.evaluationRunning()
+                             && eval_man_.anySectorsWithReq()
                              && eval_man_.hasSelectedReferenceDataSources()
                              && eval_man_.hasSelectedTestDataSources());
 
     evaluate_button_->setEnabled(eval_man_.canEvaluate());
     gen_report_button_->setEnabled(eval_man_.canGenerateReport());
 
+    if (std_tab_widget_)
+        std_tab_widget_->updateButtons();
+
     if (eval_man_.canEvaluate())
     {
         not_eval_comment_label_->setText("");
@@ -262,7 +262,7 @@ void EvaluationStandardTabWidget::updateButtons()
     assert (copy_button_);
     copy_button_->setEnabled(eval_man_.hasCurrentStandard());
     assert (remove_button_);
-    remove_button_->setEnabled(eval_man_.hasCurrentStandard());
+    remove_button_->setEnabled(eval_man_.hasCurrentStandard() && !eval_man_.evaluationRunning());
 }
 
 void EvaluationStandardTabWidget::updateStandardStack()
@@ -0,0 +1,124 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef EVALUATIONREQUIREMENTCOMPACTDETAILS_H
+#define EVALUATIONREQUIREMENTCOMPACTDETAILS_H
+
+#include <cassert>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace EvaluationRequirement
+{
+
+/**
+ * @brief Comment texts of the details of one single result, each distinct text is stored once
+ */
+class DetailComments
+{
+public:
+    unsigned int code(const std::string& text)
+    {
+        auto code_it = codes_.find(text);
+
+        if (code_it != codes_.end())
+            return code_it->second;
+
+        texts_.push_back(text);
+        codes_.emplace(text, texts_.size() - 1);
+
+        return texts_.size() - 1;
+    }
+
+    const std::string& text(unsigned int code) const
+    {
+        assert (code < texts_.size());
+        return texts_[code];
+    }
+
+    // lookup only needed while adding, texts added afterwards are stored again
+    void shrink_to_fit()
+    {
+        codes_.clear();
+        texts_.shrink_to_fit();
+    }
+
+private:
+    std::vector<std::string> texts_;
+    std::unordered_map<std::string, unsigned int> codes_;
+};
+
+// record type and conversion of a detail type, specialized next to each detail class
+template <class Detail>
+struct DetailPacking;
+
+/**
+ * @brief Compact storage of the details of one single result
+ *
+ * Kept for every target, requirement and sector layer, so each detail is stored as a packed record
+ * (no QVariants, comment as code of the comment table) defined by DetailPacking<Detail>. Detail objects
+ * are only materialized when accessed, e.g. when a target report section or viewable is created.
+ */
+template <class Detail>
+class CompactDetails
+{
+public:
+    typedef typename DetailPacking<Detail>::Record Record;
+
+    class const_iterator
+    {
+    public:
+        const_iterator(const CompactDetails& details, size_t index) : details_(&details), index_(index) {}
+
+        Detail operator*() const { return details_->at(index_); }
+        const_iterator& operator++() { ++index_; return *this; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const CompactDetails* details_;
+        size_t index_;
+    };
+
+    void push_back(const Detail& detail) { records_.push_back(DetailPacking<Detail>::pack(detail, comments_)); }
+    void reserve(size_t size) { records_.reserve(size); }
+    void shrink_to_fit()
+    {
+        records_.shrink_to_fit();
+        comments_.shrink_to_fit();
+    }
+
+    size_t size() const { return records_.size(); }
+    bool empty() const { return records_.empty(); }
+
+    Detail at(size_t index) const
+    {
+        assert (index < size());
+        return DetailPacking<Detail>::unpack(records_[index], comments_);
+    }
+
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size()); }
+
+private:
+    std::vector<Record> records_;
+    DetailComments comments_;
+};
+
+}
+
+#endif // EVALUATIONREQUIREMENTCOMPACTDETAILS_H
@@ -2,6 +2,7 @@
 #define EVALUATIONREQUIREMENTCORRECTNESSDETAIL_H
 
 #include "evaluationtargetposition.h"
+#include "compactdetails.h"
 
 #include <QVariant>
 
@@ -45,6 +46,43 @@ namespace EvaluationRequirement
 
         std::string comment_;
     };
+
+    template <>
+    struct DetailPacking<CorrectnessDetail>
+    {
+        struct Record
+        {
+            boost::posix_time::ptime timestamp;
+            EvaluationTargetPosition pos_tst;
+            unsigned int counts[6];
+            unsigned int comment;
+            bool ref_exists;
+            bool has_pos_inside;
+            bool pos_inside;
+            bool is_not_correct;
+        };
+
+        static Record pack(const CorrectnessDetail& detail, DetailComments& comments)
+        {
+            return {detail.timestamp_, detail.pos_tst_,
+                    {detail.num_updates_, detail.num_no_ref_, detail.num_inside_, detail.num_outside_,
+                     detail.num_correct_, detail.num_not_correct_},
+                    comments.code(detail.comment_), detail.ref_exists_,
+                    detail.pos_inside_.isValid(), detail.pos_inside_.toBool(), detail.is_not_correct_};
+        }
+
+        static CorrectnessDetail unpack(const Record& record, const DetailComments& comments)
+        {
+            return CorrectnessDetail(record.timestamp, record.pos_tst, record.ref_exists,
+                                     record.has_pos_inside ? QVariant(record.pos_inside) : QVariant(),
+                                     record.is_not_correct,
+                                     record.counts[0], record.counts[1], record.counts[2], record.counts[3],
+                                     record.counts[4], record.counts[5],
+                                     comments.text(record.comment));
+        }
+    };
+
+    typedef CompactDetails<CorrectnessDetail> CorrectnessDetails;
 }
 
 #endif // EVALUATIONREQUIREMENTCORRECTNESSDETAIL_H
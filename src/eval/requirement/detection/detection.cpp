@@ -101,28 +101,23 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
 
     EvaluationTargetPosition ref_pos;
     ptime timestamp, last_ts;
-    bool has_ground_bit;
-    bool ground_bit_set;
 
     bool inside, was_inside;
 
     {
-        const std::multimap<ptime, unsigned int>& ref_data = target_data.refData();
+        const TimeIndex& ref_data = target_data.refData();
         bool first {true};
 
+        const vector<bool>& ref_pos_inside_flags = target_data.refPosInside(sector_layer);
+        assert (ref_pos_inside_flags.size() == ref_data.size());
+        unsigned int ref_cnt = 0;
+
         for (auto& ref_it : ref_data)
         {
             timestamp = ref_it.first;
             was_inside = inside;
 
-            // for ref
-            tie (has_ground_bit, ground_bit_set) = target_data.refGroundBitForTime(timestamp);
-            // for tst
-            if (!ground_bit_set)
-                tie (has_ground_bit, ground_bit_set) = target_data.tstGroundBitForTimeInterpolated(timestamp);
-
-            inside = target_data.hasRefPosForTime(timestamp)
-                    && sector_layer.isInside(target_data.refPosForTime(timestamp), has_ground_bit, ground_bit_set);
+            inside = ref_pos_inside_flags[ref_cnt++];
 
             if (first)
             {
@@ -160,7 +155,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
     last_ts = {};
 
     // evaluate test data
-    const std::multimap<ptime, unsigned int>& tst_data = target_data.tstData();
+    const TimeIndex& tst_data = target_data.tstData();
 
     int sum_uis = ref_periods.getUIs(update_interval_s_);
 
@@ -175,7 +170,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
     //pair<EvaluationTargetPosition, bool> ret_pos;
     bool ok;
 
-    vector<DetectionDetail> details;
+    DetectionDetails details;
     EvaluationTargetPosition pos_current;
 
     unsigned int tst_data_size = tst_data.size();
@@ -222,7 +217,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
 
         return make_shared<EvaluationRequirementResult::SingleDetection>(
                     "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
-                    eval_man_, sum_uis, sum_missed_uis, ref_periods, details);
+                    eval_man_, sum_uis, sum_missed_uis, ref_periods, std::move(details));
     }
 
 
@@ -241,8 +236,15 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
 
     bool skip_no_data_details = eval_man_.reportSkipNoDataDetails();
 
+    const vector<bool>& ref_pos_inside_flags = target_data.refPosInsideForTst(sector_layer);
+    assert (ref_pos_inside_flags.size() == tst_data.size());
+    unsigned int tst_cnt = 0;
+    bool ref_pos_inside;
+
     for (auto tst_it=tst_data.begin(); tst_it != tst_data.end(); ++tst_it)
     {
+        ref_pos_inside = ref_pos_inside_flags[tst_cnt++];
+
         comment = "";
 
         last_ts = timestamp;
@@ -366,17 +368,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
             continue;
         }
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-        if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-        else
-            ground_bit_set = false;
-
-        if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(timestamp, seconds(15));
-
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = ref_pos_inside;
 
         if (!is_inside)
         {
@@ -598,7 +590,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> Detection::evaluate (
 
     return make_shared<EvaluationRequirementResult::SingleDetection>(
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
-                eval_man_, sum_uis, sum_missed_uis, ref_periods, details);
+                eval_man_, sum_uis, sum_missed_uis, ref_periods, std::move(details));
 }
 
 bool Detection::invertProb() const
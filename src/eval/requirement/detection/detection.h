@@ -20,6 +20,7 @@
 
 #include "eval/requirement/base/base.h"
 #include "evaluationtargetposition.h"
+#include "compactdetails.h"
 
 #include <QVariant>
 
@@ -57,6 +58,51 @@ public:
     EvaluationTargetPosition pos_last_;
 };
 
+template <>
+struct DetailPacking<DetectionDetail>
+{
+    struct Record
+    {
+        boost::posix_time::ptime timestamp;
+        EvaluationTargetPosition pos_current;
+        EvaluationTargetPosition pos_last; // default if !has_last_position
+        float d_tod;
+        int missed_uis;
+        int max_gap_uis;
+        int no_ref_uis;
+        unsigned int comment;
+        bool has_d_tod;
+        bool miss_occurred;
+        bool ref_exists;
+        bool has_last_position;
+    };
+
+    static Record pack(const DetectionDetail& detail, DetailComments& comments)
+    {
+        return {detail.timestamp_, detail.pos_current_,
+                detail.has_last_position_ ? detail.pos_last_ : EvaluationTargetPosition(),
+                detail.d_tod_.toFloat(), detail.missed_uis_, detail.max_gap_uis_, detail.no_ref_uis_,
+                comments.code(detail.comment_), detail.d_tod_.isValid(), detail.miss_occurred_,
+                detail.ref_exists_, detail.has_last_position_};
+    }
+
+    static DetectionDetail unpack(const Record& record, const DetailComments& comments)
+    {
+        DetectionDetail detail (record.timestamp, record.has_d_tod ? QVariant(record.d_tod) : QVariant(),
+                                record.miss_occurred, record.pos_current, record.ref_exists, record.missed_uis,
+                                comments.text(record.comment));
+
+        detail.max_gap_uis_ = record.max_gap_uis;
+        detail.no_ref_uis_ = record.no_ref_uis;
+        detail.has_last_position_ = record.has_last_position;
+        detail.pos_last_ = record.pos_last;
+
+        return detail;
+    }
+};
+
+typedef CompactDetails<DetectionDetail> DetectionDetails;
+
 class Detection : public Base
 {
 public:
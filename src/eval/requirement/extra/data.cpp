@@ -78,7 +78,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
     bool inside;
 
     {
-        const std::multimap<ptime, unsigned int>& ref_data = target_data.refData();
+        const TimeIndex& ref_data = target_data.refData();
 
         bool first {true};
 
@@ -122,14 +122,21 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
     unsigned int num_extra = 0;
     EvaluationTargetPosition tst_pos;
 
-    vector<ExtraDataDetail> details;
+    ExtraDataDetails details;
     bool skip_no_data_details = eval_man_.reportSkipNoDataDetails();
 
     {
-        const std::multimap<ptime, unsigned int>& tst_data = target_data.tstData();
+        const TimeIndex& tst_data = target_data.tstData();
+
+        const vector<bool>& tst_pos_inside_flags = target_data.tstPosInside(sector_layer);
+        assert (tst_pos_inside_flags.size() == tst_data.size());
+        unsigned int tst_cnt = 0;
+        bool tst_pos_inside;
 
         for (auto& tst_it : tst_data)
         {
+            tst_pos_inside = tst_pos_inside_flags[tst_cnt++];
+
             timestamp = tst_it.first;
 
             assert (target_data.hasTstPosForTime(timestamp));
@@ -146,18 +153,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
 
             // no ref
 
-            has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-            if (has_ground_bit)
-                ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-            else
-                ground_bit_set = false;
-
-            if (!ground_bit_set)
-                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(
-                            timestamp, seconds(15));
-
-            inside = sector_layer.isInside(tst_pos, has_ground_bit, ground_bit_set);
+            inside = tst_pos_inside;
 
             if (inside)
             {
@@ -198,6 +194,6 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraData::evaluate (
 
     return make_shared<EvaluationRequirementResult::SingleExtraData>(
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
-                eval_man_, ignore, num_extra, num_ok, has_extra_test_data, details);
+                eval_man_, ignore, num_extra, num_ok, has_extra_test_data, std::move(details));
 }
 }
@@ -20,6 +20,7 @@
 
 #include "eval/requirement/base/base.h"
 #include "evaluationtargetposition.h"
+#include "compactdetails.h"
 
 #include <QVariant>
 
@@ -49,6 +50,34 @@ public:
     std::string comment_;
 };
 
+template <>
+struct DetailPacking<ExtraDataDetail>
+{
+    struct Record
+    {
+        boost::posix_time::ptime timestamp;
+        EvaluationTargetPosition pos_current;
+        unsigned int comment;
+        bool inside;
+        bool extra;
+        bool ref_exists;
+    };
+
+    static Record pack(const ExtraDataDetail& detail, DetailComments& comments)
+    {
+        return {detail.timestamp_, detail.pos_current_, comments.code(detail.comment_),
+                detail.inside_, detail.extra_, detail.ref_exists_};
+    }
+
+    static ExtraDataDetail unpack(const Record& record, const DetailComments& comments)
+    {
+        return ExtraDataDetail(record.timestamp, record.pos_current, record.inside, record.extra,
+                               record.ref_exists, comments.text(record.comment));
+    }
+};
+
+typedef CompactDetails<ExtraDataDetail> ExtraDataDetails;
+
 class ExtraData : public Base
 {
 public:
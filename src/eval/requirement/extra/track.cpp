@@ -69,7 +69,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
 
     time_duration max_ref_time_diff = Time::partialSeconds(eval_man_.maxRefTimeDiff());
 
-    const std::multimap<ptime, unsigned int>& tst_data = target_data.tstData();
+    const TimeIndex& tst_data = target_data.tstData();
 
     ptime timestamp;
     EvaluationTargetPosition tst_pos;
@@ -78,8 +78,10 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
 
     bool skip_no_data_details = eval_man_.reportSkipNoDataDetails();
 
-    bool has_ground_bit;
-    bool ground_bit_set;
+    const vector<bool>& tst_pos_inside_flags = target_data.tstPosInside(sector_layer);
+    assert (tst_pos_inside_flags.size() == tst_data.size());
+    unsigned int tst_cnt = 0;
+
     unsigned int track_num;
 
     // collect track numbers with time periods
@@ -88,24 +90,14 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
 
     for (const auto& tst_id : tst_data)
     {
+        is_inside = tst_pos_inside_flags[tst_cnt++];
+
         timestamp = tst_id.first;
         tst_pos = target_data.tstPosForTime(timestamp);
 
         if (!target_data.hasRefDataForTime (timestamp, max_ref_time_diff))
             continue;
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-        if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-        else
-            ground_bit_set = false;
-
-        if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(timestamp, seconds(15));
-
-        is_inside = sector_layer.isInside(tst_pos, has_ground_bit, ground_bit_set);
-
         if (!is_inside)
             continue;
 
@@ -153,7 +145,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
     unsigned int num_extra {0};
     unsigned int num_ok {0};
 
-    std::vector<EvaluationRequirement::ExtraTrackDetail> details;
+    EvaluationRequirement::ExtraTrackDetails details;
 
     //unsigned int extra_time_period_cnt;
     vector<string> extra_track_nums;
@@ -163,8 +155,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
     bool has_tod {false};
     ptime tod_min, tod_max;
 
+    tst_cnt = 0;
+
     for (const auto& tst_id : tst_data)
     {
+        is_inside = tst_pos_inside_flags[tst_cnt++];
+
         ++num_pos;
 
         timestamp = tst_id.first;
@@ -175,19 +171,6 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
         if (has_track_num)
             track_num = target_data.tstTrackNumForTime(timestamp);
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-        if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-        else
-            ground_bit_set = false;
-
-        if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(timestamp, seconds(15));
-
-        is_inside = sector_layer.isInside(tst_pos, has_ground_bit, ground_bit_set);
-
-
         if (!is_inside)
         {
             if (!skip_no_data_details)
@@ -267,6 +250,6 @@ std::shared_ptr<EvaluationRequirementResult::Single> ExtraTrack::evaluate (
 
     return make_shared<EvaluationRequirementResult::SingleExtraTrack>(
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
-                eval_man_, ignore, num_pos_inside, num_extra, num_ok, details);
+                eval_man_, ignore, num_pos_inside, num_extra, num_ok, std::move(details));
 }
 }
@@ -20,6 +20,7 @@
 
 #include "eval/requirement/base/base.h"
 #include "evaluationtargetposition.h"
+#include "compactdetails.h"
 
 #include <QVariant>
 
@@ -48,6 +49,36 @@ public:
     std::string comment_;
 };
 
+template <>
+struct DetailPacking<ExtraTrackDetail>
+{
+    struct Record
+    {
+        boost::posix_time::ptime timestamp;
+        EvaluationTargetPosition pos_current;
+        unsigned int track_num;
+        unsigned int comment;
+        bool has_track_num;
+        bool inside;
+        bool extra;
+    };
+
+    static Record pack(const ExtraTrackDetail& detail, DetailComments& comments)
+    {
+        return {detail.timestamp_, detail.pos_current_, detail.track_num_.toUInt(),
+                comments.code(detail.comment_), detail.track_num_.isValid(), detail.inside_, detail.extra_};
+    }
+
+    static ExtraTrackDetail unpack(const Record& record, const DetailComments& comments)
+    {
+        return ExtraTrackDetail(record.timestamp, record.pos_current, record.inside,
+                                record.has_track_num ? QVariant(record.track_num) : QVariant(),
+                                record.extra, comments.text(record.comment));
+    }
+};
+
+typedef CompactDetails<ExtraTrackDetail> ExtraTrackDetails;
+
 class ExtraTrack : public Base
 {
 public:
@@ -55,12 +55,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
 
         return make_shared<EvaluationRequirementResult::SingleIdentificationCorrect>(
                     "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
-                    eval_man_, 0, 0, 0, 0, 0, 0, 0, vector<CorrectnessDetail>{});
+                    eval_man_, 0, 0, 0, 0, 0, 0, 0, CorrectnessDetails{});
     }
 
     time_duration max_ref_time_diff = Time::partialSeconds(eval_man_.maxRefTimeDiff());
 
-    const std::multimap<ptime, unsigned int>& tst_data = target_data.tstData();
+    const TimeIndex& tst_data = target_data.tstData();
 
     ptime timestamp;
 
@@ -72,7 +72,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
     unsigned int num_correct {0};
     unsigned int num_not_correct {0};
 
-    vector<CorrectnessDetail> details;
+    CorrectnessDetails details;
     EvaluationTargetPosition pos_current;
 
     bool ref_exists;
@@ -86,8 +86,6 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
     bool skip_no_data_details = eval_man_.reportSkipNoDataDetails();
     bool skip_detail;
 
-    bool has_ground_bit;
-    bool ground_bit_set;
 
     ValueComparisonResult cmp_res_ti;
     string cmp_res_ti_comment;
@@ -109,8 +107,15 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
     bool all_correct;
     bool result_ok;
 
+    const vector<bool>& ref_pos_inside_flags = target_data.refPosInsideForTst(sector_layer);
+    assert (ref_pos_inside_flags.size() == tst_data.size());
+    unsigned int tst_cnt = 0;
+    bool ref_pos_inside;
+
     for (const auto& tst_id : tst_data)
     {
+        ref_pos_inside = ref_pos_inside_flags[tst_cnt++];
+
         ref_exists = false;
         is_inside = false;
         comment = "";
@@ -152,17 +157,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
         }
         ref_exists = true;
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-        if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-        else
-            ground_bit_set = false;
-
-        if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(timestamp, seconds(15));
-
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = ref_pos_inside;
 
         if (!is_inside)
         {
@@ -287,7 +282,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> IdentificationCorrect::eval
     return make_shared<EvaluationRequirementResult::SingleIdentificationCorrect>(
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
                 eval_man_, num_updates, num_no_ref_pos, num_no_ref_id, num_pos_outside, num_pos_inside,
-                num_correct, num_not_correct, details);
+                num_correct, num_not_correct, std::move(details));
 }
 
 bool IdentificationCorrect::requireCorrectnessOfAll() const
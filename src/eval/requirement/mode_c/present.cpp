@@ -46,7 +46,7 @@ namespace EvaluationRequirement
 
         time_duration max_ref_time_diff = Time::partialSeconds(eval_man_.maxRefTimeDiff());
 
-        const std::multimap<ptime, unsigned int>& tst_data = target_data.tstData();
+        const TimeIndex& tst_data = target_data.tstData();
 
         ptime timestamp;
 
@@ -62,7 +62,7 @@ namespace EvaluationRequirement
         int num_present_id {0};
         int num_missing_id {0};
 
-        vector<PresentDetail> details;
+        PresentDetails details;
         EvaluationTargetPosition pos_current;
         //unsigned int code;
         //bool code_ok;
@@ -83,11 +83,15 @@ namespace EvaluationRequirement
         bool skip_no_data_details = eval_man_.reportSkipNoDataDetails();
         bool skip_detail;
 
-        bool has_ground_bit;
-        bool ground_bit_set;
+        const vector<bool>& ref_pos_inside_flags = target_data.refPosInsideForTst(sector_layer);
+        assert (ref_pos_inside_flags.size() == tst_data.size());
+        unsigned int tst_cnt = 0;
+        bool ref_pos_inside;
 
         for (const auto& tst_id : tst_data)
         {
+            ref_pos_inside = ref_pos_inside_flags[tst_cnt++];
+
             //ref_exists = false;
             is_inside = false;
             comment = "";
@@ -127,18 +131,7 @@ namespace EvaluationRequirement
                 ++num_no_ref_pos;
                 continue;
             }
-            has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-            if (has_ground_bit)
-                ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-            else
-                ground_bit_set = false;
-
-            if (!ground_bit_set)
-                tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(
-                            timestamp, seconds(15));
-
-            is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+            is_inside = ref_pos_inside;
 
             if (!is_inside)
             {
@@ -217,6 +210,6 @@ namespace EvaluationRequirement
         return make_shared<EvaluationRequirementResult::SingleModeCPresent>(
                     "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
                     eval_man_, num_updates, num_no_ref_pos, num_pos_outside, num_pos_inside,
-                    num_no_ref_id, num_present_id, num_missing_id, details);
+                    num_no_ref_id, num_present_id, num_missing_id, std::move(details));
     }
 }
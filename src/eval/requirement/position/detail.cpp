@@ -0,0 +1,133 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "detail.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace EvaluationRequirement
+{
+
+namespace
+{
+    // in order of PositionDetails::Comment
+    const string comment_texts[PositionDetails::NumComments] = {
+        "",
+        "No reference data",
+        "No reference position",
+        "No reference speed",
+        "Outside sector",
+        "Position transformation error",
+        "Distance Invalid",
+        "Angle Invalid",
+        "Speed Invalid",
+        "Passed",
+        "Failed",
+        "Along-track not OK",
+        "Across-track not OK",
+        "Latency not OK"
+    };
+}
+
+void PositionDetails::push_back(const boost::posix_time::ptime& timestamp,
+                                const EvaluationTargetPosition& tst_pos,
+                                bool has_ref_pos, const EvaluationTargetPosition& ref_pos,
+                                bool has_pos_inside, bool pos_inside, bool has_value, double value,
+                                bool check_passed,
+                                unsigned int num_pos, unsigned int num_no_ref,
+                                unsigned int num_inside, unsigned int num_outside,
+                                unsigned int num_check_failed, unsigned int num_check_passed,
+                                Comment comment)
+{
+    assert (comment < NumComments);
+
+    timestamps_.push_back(timestamp);
+    tst_positions_.push_back(tst_pos);
+    ref_positions_.push_back(has_ref_pos ? ref_pos : EvaluationTargetPosition());
+    values_.push_back(has_value ? value : 0);
+
+    unsigned char flags = 0;
+
+    if (has_ref_pos)
+        flags |= HasRefPos;
+    if (check_passed)
+        flags |= CheckPassed;
+    if (has_pos_inside)
+        flags |= HasPosInside;
+    if (has_pos_inside && pos_inside)
+        flags |= PosInside;
+    if (has_value)
+        flags |= HasValue;
+
+    flags_.push_back(flags);
+
+    counts_.push_back(num_pos);
+    counts_.push_back(num_no_ref);
+    counts_.push_back(num_inside);
+    counts_.push_back(num_outside);
+    counts_.push_back(num_check_failed);
+    counts_.push_back(num_check_passed);
+
+    comments_.push_back(comment);
+}
+void PositionDetails::reserve(size_t size)
+{
+    timestamps_.reserve(size);
+    tst_positions_.reserve(size);
+    ref_positions_.reserve(size);
+    values_.reserve(size);
+    flags_.reserve(size);
+    counts_.reserve(NUM_COUNTS * size);
+    comments_.reserve(size);
+}
+
+void PositionDetails::shrink_to_fit()
+{
+    timestamps_.shrink_to_fit();
+    tst_positions_.shrink_to_fit();
+    ref_positions_.shrink_to_fit();
+    values_.shrink_to_fit();
+    flags_.shrink_to_fit();
+    counts_.shrink_to_fit();
+    comments_.shrink_to_fit();
+}
+
+PositionDetail PositionDetails::at(size_t index) const
+{
+    assert (index < size());
+
+    unsigned char flags = flags_[index];
+    const unsigned int* counts = &counts_[NUM_COUNTS * index];
+
+    return PositionDetail(timestamps_[index], tst_positions_[index],
+                          flags & HasRefPos, ref_positions_[index],
+                          (flags & HasPosInside) ? QVariant((bool) (flags & PosInside)) : QVariant(),
+                          (flags & HasValue) ? QVariant(values_[index]) : QVariant(),
+                          flags & CheckPassed,
+                          counts[0], counts[1], counts[2], counts[3], counts[4], counts[5],
+                          comment(comments_[index]));
+}
+
+const std::string& PositionDetails::comment(Comment code)
+{
+    assert (code < NumComments);
+    return comment_texts[code];
+}
+
+}
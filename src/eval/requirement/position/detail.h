@@ -7,6 +7,9 @@
 
 #include "boost/date_time/posix_time/ptime.hpp"
 
+#include <string>
+#include <vector>
+
 namespace EvaluationRequirement
 {
 class PositionDetail
@@ -51,6 +54,93 @@ public:
 
     std::string comment_;
 };
+
+/**
+ * @brief Column-wise storage of the PositionDetails of one single result
+ *
+ * Kept for every target, requirement and sector layer, so the per-update data is stored in flat
+ * columns instead of PositionDetail objects (no QVariants, comments as codes of a fixed table).
+ * PositionDetail objects are only materialized when accessed, e.g. when a target report section
+ * or viewable is created.
+ */
+class PositionDetails
+{
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(const PositionDetails& details, size_t index) : details_(&details), index_(index) {}
+
+        PositionDetail operator*() const { return details_->at(index_); }
+        const_iterator& operator++() { ++index_; return *this; }
+        bool operator!=(const const_iterator& other) const { return index_ != other.index_; }
+
+    private:
+        const PositionDetails* details_;
+        size_t index_;
+    };
+
+    // comments used by the position requirements, texts in constant table
+    enum Comment : unsigned char
+    {
+        NoComment = 0,
+        NoRefData,
+        NoRefPosition,
+        NoRefSpeed,
+        OutsideSector,
+        PosTransformationError,
+        DistanceInvalid,
+        AngleInvalid,
+        SpeedInvalid,
+        Passed,
+        Failed,
+        AlongNotOK,
+        AcrossNotOK,
+        LatencyNotOK,
+        NumComments
+    };
+
+    // pos_inside only stored if has_pos_inside, value only if has_value
+    void push_back(const boost::posix_time::ptime& timestamp, const EvaluationTargetPosition& tst_pos,
+                   bool has_ref_pos, const EvaluationTargetPosition& ref_pos,
+                   bool has_pos_inside, bool pos_inside, bool has_value, double value, bool check_passed,
+                   unsigned int num_pos, unsigned int num_no_ref,
+                   unsigned int num_inside, unsigned int num_outside,
+                   unsigned int num_check_failed, unsigned int num_check_passed,
+                   Comment comment);
+    void reserve(size_t size);
+    void shrink_to_fit();
+
+    size_t size() const { return timestamps_.size(); }
+    bool empty() const { return timestamps_.empty(); }
+
+    PositionDetail at(size_t index) const;
+
+    const_iterator begin() const { return const_iterator(*this, 0); }
+    const_iterator end() const { return const_iterator(*this, size()); }
+
+private:
+    enum Flags : unsigned char
+    {
+        HasRefPos = 1 << 0,
+        CheckPassed = 1 << 1,
+        HasPosInside = 1 << 2,
+        PosInside = 1 << 3,
+        HasValue = 1 << 4
+    };
+
+    static const unsigned int NUM_COUNTS = 6;
+
+    std::vector<boost::posix_time::ptime> timestamps_;
+    std::vector<EvaluationTargetPosition> tst_positions_;
+    std::vector<EvaluationTargetPosition> ref_positions_; // default position if !has_ref_pos
+    std::vector<double> values_; // 0 if no value
+    std::vector<unsigned char> flags_;
+    std::vector<unsigned int> counts_; // NUM_COUNTS per detail
+    std::vector<Comment> comments_;
+
+    static const std::string& comment(Comment code);
+};
 }
 
 #endif // EVALUATIONREQUIREMENPOSITIONDETAIL_H
@@ -22,8 +22,7 @@
 #include "logger.h"
 #include "stringconv.h"
 #include "sectorlayer.h"
-
-#include <ogr_spatialref.h>
+#include "localstereographic.h"
 
 #include <algorithm>
 
@@ -70,7 +69,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
 
     time_duration max_ref_time_diff = Time::partialSeconds(eval_man_.maxRefTimeDiff());
 
-    const std::multimap<ptime, unsigned int>& tst_data = target_data.tstData();
+    const TimeIndex& tst_data = target_data.tstData();
 
     unsigned int num_pos {0};
     unsigned int num_no_ref {0};
@@ -80,16 +79,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
     unsigned int num_comp_failed {0};
     unsigned int num_comp_passed {0};
 
-    std::vector<EvaluationRequirement::PositionDetail> details;
+    EvaluationRequirement::PositionDetails details;
+    details.reserve(tst_data.size());
 
     ptime timestamp;
 
-    OGRSpatialReference wgs84;
-    wgs84.SetWellKnownGeogCS("WGS84");
-
-    OGRSpatialReference local;
-
-    std::unique_ptr<OGRCoordinateTransformation> ogr_geo2cart;
+    LocalStereographic local;
 
     EvaluationTargetPosition tst_pos;
 
@@ -104,17 +99,21 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
     bool comp_passed;
 
     unsigned int num_distances {0};
-    string comment;
+    PositionDetails::Comment comment;
 
     vector<double> values;
 
     bool skip_no_data_details = eval_man_.reportSkipNoDataDetails();
 
-    bool has_ground_bit;
-    bool ground_bit_set;
+    const vector<bool>& ref_pos_inside_flags = target_data.refPosInsideForTst(sector_layer);
+    assert (ref_pos_inside_flags.size() == tst_data.size());
+    unsigned int tst_cnt = 0;
+    bool ref_pos_inside;
 
     for (const auto& tst_id : tst_data)
     {
+        ref_pos_inside = ref_pos_inside_flags[tst_cnt++];
+
         ++num_pos;
 
         timestamp = tst_id.first;
@@ -125,12 +124,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
         if (!target_data.hasRefDataForTime (timestamp, max_ref_time_diff))
         {
             if (!skip_no_data_details)
-                details.push_back({timestamp, tst_pos,
-                                   false, {}, // has_ref_pos, ref_pos
-                                   {}, {}, comp_passed, // pos_inside, value, check_passed
-                                   num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                                   num_comp_failed, num_comp_passed,
-                                   "No reference data"});
+                details.push_back(timestamp, tst_pos,
+                                  false, {}, // has_ref_pos, ref_pos
+                                  false, false, false, 0, comp_passed, // has_pos_inside, pos_inside, has_value, value, check_passed
+                                  num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                                  num_comp_failed, num_comp_passed,
+                                  PositionDetails::NoRefData);
 
             ++num_no_ref;
             continue;
@@ -144,67 +143,44 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
         if (!ok)
         {
             if (!skip_no_data_details)
-                details.push_back({timestamp, tst_pos,
-                                   false, {}, // has_ref_pos, ref_pos
-                                   {}, {}, comp_passed, // pos_inside, value, check_passed
-                                   num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                                   num_comp_failed, num_comp_passed,
-                                   "No reference position"});
+                details.push_back(timestamp, tst_pos,
+                                  false, {}, // has_ref_pos, ref_pos
+                                  false, false, false, 0, comp_passed, // has_pos_inside, pos_inside, has_value, value, check_passed
+                                  num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                                  num_comp_failed, num_comp_passed,
+                                  PositionDetails::NoRefPosition);
 
             ++num_no_ref;
             continue;
         }
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-        if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-        else
-            ground_bit_set = false;
-
-        if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(timestamp, seconds(15));
-
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = ref_pos_inside;
 
         if (!is_inside)
         {
             if (!skip_no_data_details)
-                details.push_back({timestamp, tst_pos,
-                                   true, ref_pos, // has_ref_pos, ref_pos
-                                   is_inside, {}, comp_passed, // pos_inside, value, check_passed
-                                   num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                                   num_comp_failed, num_comp_passed,
-                                   "Outside sector"});
+                details.push_back(timestamp, tst_pos,
+                                  true, ref_pos, // has_ref_pos, ref_pos
+                                  true, is_inside, false, 0, comp_passed, // has_pos_inside, pos_inside, has_value, value, check_passed
+                                  num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                                  num_comp_failed, num_comp_passed,
+                                  PositionDetails::OutsideSector);
             ++num_pos_outside;
             continue;
         }
         ++num_pos_inside;
 
-        local.SetStereographic(ref_pos.latitude_, ref_pos.longitude_, 1.0, 0.0, 0.0);
-
-        ogr_geo2cart.reset(OGRCreateCoordinateTransformation(&wgs84, &local));
-
-        if (in_appimage_) // inside appimage
-        {
-            x_pos = tst_pos.longitude_;
-            y_pos = tst_pos.latitude_;
-        }
-        else
-        {
-            x_pos = tst_pos.latitude_;
-            y_pos = tst_pos.longitude_;
-        }
+        local.origin(ref_pos.latitude_, ref_pos.longitude_);
 
-        ok = ogr_geo2cart->Transform(1, &x_pos, &y_pos); // wgs84 to cartesian offsets
+        ok = local.wgs2Cart(tst_pos.latitude_, tst_pos.longitude_, x_pos, y_pos); // wgs84 to cartesian offsets
         if (!ok)
         {
-            details.push_back({timestamp, tst_pos,
-                               true, ref_pos, // has_ref_pos, ref_pos
-                               is_inside, {}, comp_passed, // pos_inside, value, check_passed
-                               num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                               num_comp_failed, num_comp_passed,
-                               "Position transformation error"});
+            details.push_back(timestamp, tst_pos,
+                              true, ref_pos, // has_ref_pos, ref_pos
+                              true, is_inside, false, 0, comp_passed, // has_pos_inside, pos_inside, has_value, value, check_passed
+                              num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                              num_comp_failed, num_comp_passed,
+                              PositionDetails::PosTransformationError);
             ++num_pos_calc_errors;
             continue;
         }
@@ -213,12 +189,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
 
         if (std::isnan(distance) || std::isinf(distance))
         {
-            details.push_back({timestamp, tst_pos,
-                               true, ref_pos, // has_ref_pos, ref_pos
-                               is_inside, {}, comp_passed, // pos_inside, value, check_passed
-                               num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                               num_comp_failed, num_comp_passed,
-                               "Distance Invalid"});
+            details.push_back(timestamp, tst_pos,
+                              true, ref_pos, // has_ref_pos, ref_pos
+                              true, is_inside, false, 0, comp_passed, // has_pos_inside, pos_inside, has_value, value, check_passed
+                              num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                              num_comp_failed, num_comp_passed,
+                              PositionDetails::DistanceInvalid);
             ++num_pos_calc_errors;
             continue;
         }
@@ -229,20 +205,20 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
         {
             comp_passed = true;
             ++num_comp_passed;
-            comment = "Passed";
+            comment = PositionDetails::Passed;
         }
         else
         {
             ++num_comp_failed;
-            comment = "Failed";
+            comment = PositionDetails::Failed;
         }
 
-        details.push_back({timestamp, tst_pos,
-                           true, ref_pos,
-                           is_inside, distance, comp_passed, // pos_inside, value, check_passed
-                           num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                           num_comp_failed, num_comp_passed,
-                           comment});
+        details.push_back(timestamp, tst_pos,
+                          true, ref_pos,
+                          true, is_inside, true, distance, comp_passed, // has_pos_inside, pos_inside, has_value, value, check_passed
+                          num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                          num_comp_failed, num_comp_passed,
+                          comment);
 
         values.push_back(distance);
     }
@@ -272,7 +248,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionDistance::evaluate
     return make_shared<EvaluationRequirementResult::SinglePositionDistance>(
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
                 eval_man_, num_pos, num_no_ref, num_pos_outside, num_pos_inside, num_comp_failed, num_comp_passed,
-                values, details);
+                values, std::move(details));
 }
 
 }
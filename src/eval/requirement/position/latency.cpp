@@ -22,8 +22,7 @@
 #include "logger.h"
 #include "stringconv.h"
 #include "sectorlayer.h"
-
-#include <ogr_spatialref.h>
+#include "localstereographic.h"
 
 #include <algorithm>
 
@@ -56,7 +55,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
 
     time_duration max_ref_time_diff = Time::partialSeconds(eval_man_.maxRefTimeDiff());
 
-    const std::multimap<ptime, unsigned int>& tst_data = target_data.tstData();
+    const TimeIndex& tst_data = target_data.tstData();
 
     unsigned int num_pos {0};
     unsigned int num_no_ref {0};
@@ -66,16 +65,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
     unsigned int num_value_ok {0};
     unsigned int num_value_nok {0};
 
-    std::vector<EvaluationRequirement::PositionDetail> details;
+    EvaluationRequirement::PositionDetails details;
+    details.reserve(tst_data.size());
 
     ptime timestamp;
 
-    OGRSpatialReference wgs84;
-    wgs84.SetWellKnownGeogCS("WGS84");
-
-    OGRSpatialReference local;
-
-    std::unique_ptr<OGRCoordinateTransformation> ogr_geo2cart;
+    LocalStereographic local;
 
     EvaluationTargetPosition tst_pos;
 
@@ -92,17 +87,21 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
     bool along_ok;
 
     unsigned int num_distances {0};
-    string comment;
+    PositionDetails::Comment comment;
 
     vector<double> values;
 
     bool skip_no_data_details = eval_man_.reportSkipNoDataDetails();
 
-    bool has_ground_bit;
-    bool ground_bit_set;
+    const vector<bool>& ref_pos_inside_flags = target_data.refPosInsideForTst(sector_layer);
+    assert (ref_pos_inside_flags.size() == tst_data.size());
+    unsigned int tst_cnt = 0;
+    bool ref_pos_inside;
 
     for (const auto& tst_id : tst_data)
     {
+        ref_pos_inside = ref_pos_inside_flags[tst_cnt++];
+
         ++num_pos;
 
         timestamp = tst_id.first;
@@ -113,12 +112,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
         if (!target_data.hasRefDataForTime (timestamp, max_ref_time_diff))
         {
             if (!skip_no_data_details)
-                details.push_back({timestamp, tst_pos,
-                                   false, {}, // has_ref_pos, ref_pos
-                                   {}, {}, along_ok, // pos_inside, value, value_ok,
-                                   num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                                   num_value_ok, num_value_nok,
-                                   "No reference data"});
+                details.push_back(timestamp, tst_pos,
+                                  false, {}, // has_ref_pos, ref_pos
+                                  false, false, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok,
+                                  num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                                  num_value_ok, num_value_nok,
+                                  PositionDetails::NoRefData);
 
             ++num_no_ref;
             continue;
@@ -132,12 +131,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
         if (!ok)
         {
             if (!skip_no_data_details)
-                details.push_back({timestamp, tst_pos,
-                                   false, {}, // has_ref_pos, ref_pos
-                                   {}, {}, along_ok, // pos_inside, value, value_ok
-                                   num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                                   num_value_ok, num_value_nok,
-                                   "No reference position"});
+                details.push_back(timestamp, tst_pos,
+                                  false, {}, // has_ref_pos, ref_pos
+                                  false, false, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                                  num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                                  num_value_ok, num_value_nok,
+                                  PositionDetails::NoRefPosition);
 
             ++num_no_ref;
             continue;
@@ -148,12 +147,12 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
         if (!ret_spd.second)
         {
             if (!skip_no_data_details)
-                details.push_back({timestamp, tst_pos,
-                                   true, ref_pos, // has_ref_pos, ref_pos
-                                   is_inside, {}, along_ok, // pos_inside, value, value_ok
-                                   num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                                   num_value_ok, num_value_nok,
-                                   "No reference speed"});
+                details.push_back(timestamp, tst_pos,
+                                  true, ref_pos, // has_ref_pos, ref_pos
+                                  true, is_inside, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                                  num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                                  num_value_ok, num_value_nok,
+                                  PositionDetails::NoRefSpeed);
             ++num_no_ref;
             continue;
         }
@@ -161,56 +160,33 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
         ref_spd = ret_spd.first;
         assert (ret_pos.second); // must be set of ref pos exists
 
-        has_ground_bit = target_data.hasTstGroundBitForTime(timestamp);
-
-        if (has_ground_bit)
-            ground_bit_set = target_data.tstGroundBitForTime(timestamp);
-        else
-            ground_bit_set = false;
-
-        if (!ground_bit_set)
-            tie(has_ground_bit, ground_bit_set) = target_data.interpolatedRefGroundBitForTime(timestamp, seconds(15));
-
-        is_inside = sector_layer.isInside(ref_pos, has_ground_bit, ground_bit_set);
+        is_inside = ref_pos_inside;
 
         if (!is_inside)
         {
             if (!skip_no_data_details)
-                details.push_back({timestamp, tst_pos,
-                                   true, ref_pos, // has_ref_pos, ref_pos
-                                   is_inside, {}, along_ok, // pos_inside, value, value_ok
-                                   num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                                   num_value_ok, num_value_nok,
-                                   "Outside sector"});
+                details.push_back(timestamp, tst_pos,
+                                  true, ref_pos, // has_ref_pos, ref_pos
+                                  true, is_inside, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                                  num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                                  num_value_ok, num_value_nok,
+                                  PositionDetails::OutsideSector);
             ++num_pos_outside;
             continue;
         }
         ++num_pos_inside;
 
-        local.SetStereographic(ref_pos.latitude_, ref_pos.longitude_, 1.0, 0.0, 0.0);
-
-        ogr_geo2cart.reset(OGRCreateCoordinateTransformation(&wgs84, &local));
-
-        if (in_appimage_) // inside appimage
-        {
-            x_pos = tst_pos.longitude_;
-            y_pos = tst_pos.latitude_;
-        }
-        else
-        {
-            x_pos = tst_pos.latitude_;
-            y_pos = tst_pos.longitude_;
-        }
+        local.origin(ref_pos.latitude_, ref_pos.longitude_);
 
-        ok = ogr_geo2cart->Transform(1, &x_pos, &y_pos); // wgs84 to cartesian offsets
+        ok = local.wgs2Cart(tst_pos.latitude_, tst_pos.longitude_, x_pos, y_pos); // wgs84 to cartesian offsets
         if (!ok)
         {
-            details.push_back({timestamp, tst_pos,
-                               true, ref_pos, // has_ref_pos, ref_pos
-                               is_inside, {}, along_ok, // pos_inside, value, value_ok
-                               num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                               num_value_ok, num_value_nok,
-                               "Position transformation error"});
+            details.push_back(timestamp, tst_pos,
+                              true, ref_pos, // has_ref_pos, ref_pos
+                              true, is_inside, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                              num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                              num_value_ok, num_value_nok,
+                              PositionDetails::PosTransformationError);
             ++num_pos_calc_errors;
             continue;
         }
@@ -220,36 +196,36 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
 
         if (distance == 0 || std::isnan(distance) || std::isinf(distance))
         {
-            details.push_back({timestamp, tst_pos,
-                               true, ref_pos, // has_ref_pos, ref_pos
-                               is_inside, {}, along_ok, // pos_inside, value, value_ok
-                               num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                               num_value_ok, num_value_nok,
-                               "Distance Invalid"});
+            details.push_back(timestamp, tst_pos,
+                              true, ref_pos, // has_ref_pos, ref_pos
+                              true, is_inside, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                              num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                              num_value_ok, num_value_nok,
+                              PositionDetails::DistanceInvalid);
             ++num_pos_calc_errors;
             continue;
         }
 
         if (std::isnan(angle) || std::isinf(angle))
         {
-            details.push_back({timestamp, tst_pos,
-                               true, ref_pos, // has_ref_pos, ref_pos
-                               is_inside, {}, along_ok, // pos_inside, value, value_ok
-                               num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                               num_value_ok, num_value_nok,
-                               "Angle Invalid"});
+            details.push_back(timestamp, tst_pos,
+                              true, ref_pos, // has_ref_pos, ref_pos
+                              true, is_inside, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                              num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                              num_value_ok, num_value_nok,
+                              PositionDetails::AngleInvalid);
             ++num_pos_calc_errors;
             continue;
         }
 
         if (ref_spd.speed_ == 0 || std::isnan(ref_spd.speed_) || std::isinf(ref_spd.speed_))
         {
-            details.push_back({timestamp, tst_pos,
-                               true, ref_pos, // has_ref_pos, ref_pos
-                               is_inside, {}, along_ok, // pos_inside, value, value_ok
-                               num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                               num_value_ok, num_value_nok,
-                               "Speed Invalid"});
+            details.push_back(timestamp, tst_pos,
+                              true, ref_pos, // has_ref_pos, ref_pos
+                              true, is_inside, false, 0, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                              num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                              num_value_ok, num_value_nok,
+                              PositionDetails::SpeedInvalid);
             ++num_pos_calc_errors;
             continue;
         }
@@ -265,20 +241,20 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
         {
             along_ok = false;
             ++num_value_nok;
-            comment = "Latency not OK";
+            comment = PositionDetails::LatencyNotOK;
         }
         else
         {
             ++num_value_ok;
-            comment = "";
+            comment = PositionDetails::NoComment;
         }
 
-        details.push_back({timestamp, tst_pos,
-                           true, ref_pos,
-                           is_inside, d_along, along_ok, // pos_inside, value, value_ok
-                           num_pos, num_no_ref, num_pos_inside, num_pos_outside,
-                           num_value_ok, num_value_nok,
-                           comment});
+        details.push_back(timestamp, tst_pos,
+                          true, ref_pos,
+                          true, is_inside, true, d_along, along_ok, // has_pos_inside, pos_inside, has_value, value, value_ok
+                          num_pos, num_no_ref, num_pos_inside, num_pos_outside,
+                          num_value_ok, num_value_nok,
+                          comment);
 
         values.push_back(latency);
     }
@@ -308,7 +284,7 @@ std::shared_ptr<EvaluationRequirementResult::Single> PositionLatency::evaluate (
     return make_shared<EvaluationRequirementResult::SinglePositionLatency>(
                 "UTN:"+to_string(target_data.utn_), instance, sector_layer, target_data.utn_, &target_data,
                 eval_man_, num_pos, num_no_ref, num_pos_outside, num_pos_inside, num_value_ok, num_value_nok,
-                values, details);
+                values, std::move(details));
 }
 
 }
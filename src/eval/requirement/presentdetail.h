@@ -2,6 +2,7 @@
 #define PRESENTDETAIL_H
 
 #include "evaluationtargetposition.h"
+#include "compactdetails.h"
 
 #include <QVariant>
 
@@ -46,6 +47,43 @@ namespace EvaluationRequirement
 
         std::string comment_;
     };
+
+    template <>
+    struct DetailPacking<PresentDetail>
+    {
+        struct Record
+        {
+            boost::posix_time::ptime timestamp;
+            EvaluationTargetPosition pos_tst;
+            int counts[7];
+            unsigned int comment;
+            bool ref_exists;
+            bool has_pos_inside;
+            bool pos_inside;
+            bool is_not_ok;
+        };
+
+        static Record pack(const PresentDetail& detail, DetailComments& comments)
+        {
+            return {detail.timestamp_, detail.pos_tst_,
+                    {detail.num_updates_, detail.num_no_ref_, detail.num_inside_, detail.num_outside_,
+                     detail.num_no_ref_id_, detail.num_present_id_, detail.num_missing_id_},
+                    comments.code(detail.comment_), detail.ref_exists_,
+                    detail.pos_inside_.isValid(), detail.pos_inside_.toBool(), detail.is_not_ok_};
+        }
+
+        static PresentDetail unpack(const Record& record, const DetailComments& comments)
+        {
+            return PresentDetail(record.timestamp, record.pos_tst, record.ref_exists,
+                                 record.has_pos_inside ? QVariant(record.pos_inside) : QVariant(),
+                                 record.is_not_ok,
+                                 record.counts[0], record.counts[1], record.counts[2], record.counts[3],
+                                 record.counts[4], record.counts[5], record.counts[6],
+                                 comments.text(record.comment));
+        }
+    };
+
+    typedef CompactDetails<PresentDetail> PresentDetails;
 }
 
 #endif // PRESENTDETAIL_H
@@ -2,6 +2,7 @@
 #define EVALUATIONREQUIREMENSPEEDDETAIL_H
 
 #include "evaluationtargetposition.h"
+#include "compactdetails.h"
 
 #include <QVariant>
 
@@ -51,6 +52,46 @@ public:
 
     std::string comment_;
 };
+
+template <>
+struct DetailPacking<SpeedDetail>
+{
+    struct Record
+    {
+        boost::posix_time::ptime timestamp;
+        EvaluationTargetPosition tst_pos;
+        EvaluationTargetPosition ref_pos;
+        float offset; // only reported with few decimals
+        unsigned int counts[6];
+        unsigned int comment;
+        bool has_ref_pos;
+        bool has_offset;
+        bool check_passed;
+        bool has_pos_inside;
+        bool pos_inside;
+    };
+
+    static Record pack(const SpeedDetail& detail, DetailComments& comments)
+    {
+        return {detail.timestamp_, detail.tst_pos_, detail.ref_pos_, detail.offset_.toFloat(),
+                {detail.num_pos_, detail.num_no_ref_, detail.num_inside_, detail.num_outside_,
+                 detail.num_check_failed_, detail.num_check_passed_},
+                comments.code(detail.comment_), detail.has_ref_pos_, detail.offset_.isValid(),
+                detail.check_passed_, detail.pos_inside_.isValid(), detail.pos_inside_.toBool()};
+    }
+
+    static SpeedDetail unpack(const Record& record, const DetailComments& comments)
+    {
+        return SpeedDetail(record.timestamp, record.tst_pos, record.has_ref_pos, record.ref_pos,
+                           record.has_pos_inside ? QVariant(record.pos_inside) : QVariant(),
+                           record.has_offset ? QVariant(record.offset) : QVariant(), record.check_passed,
+                           record.counts[0], record.counts[1], record.counts[2], record.counts[3],
+                           record.counts[4], record.counts[5],
+                           comments.text(record.comment));
+    }
+};
+
+typedef CompactDetails<SpeedDetail> SpeedDetails;
 }
 
 #endif // EVALUATIONREQUIREMENSPEEDDETAIL_H
@@ -41,10 +41,12 @@ SingleDetection::SingleDetection(
         const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
         EvaluationManager& eval_man,
         int sum_uis, int missed_uis, TimePeriodCollection ref_periods,
-        std::vector<EvaluationRequirement::DetectionDetail> details)
+        EvaluationRequirement::DetectionDetails details)
     : Single("SingleDetection", result_id, requirement, sector_layer, utn, target, eval_man),
-      sum_uis_(sum_uis), missed_uis_(missed_uis), ref_periods_(ref_periods), details_(details)
+      sum_uis_(sum_uis), missed_uis_(missed_uis), ref_periods_(ref_periods), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // grown for all test updates
+
     updatePD();
 }
 
@@ -205,7 +207,7 @@ void SingleDetection::reportDetails(EvaluationResultsReport::Section& utn_req_se
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         if (rq_det_it.d_tod_.isValid())
             utn_req_details_table.addRow(
@@ -280,7 +282,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleDetection::getTargetErrorsViewab
     bool has_pos = false;
     double lat_min, lat_max, lon_min, lon_max;
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if (!detail_it.miss_occurred_)
             continue;
@@ -367,7 +369,7 @@ int SingleDetection::missedUIs() const
     return missed_uis_;
 }
 
-std::vector<EvaluationRequirement::DetectionDetail>& SingleDetection::details()
+EvaluationRequirement::DetectionDetails& SingleDetection::details()
 {
     return details_;
 }
@@ -33,7 +33,7 @@ public:
             const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
             EvaluationManager& eval_man,
             int sum_uis, int missed_uis, TimePeriodCollection ref_periods,
-            std::vector<EvaluationRequirement::DetectionDetail> details);
+            EvaluationRequirement::DetectionDetails details);
 
     //virtual void print() override;
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
@@ -43,7 +43,7 @@ public:
     int sumUIs() const;
     int missedUIs() const;
 
-    std::vector<EvaluationRequirement::DetectionDetail>& details();
+    EvaluationRequirement::DetectionDetails& details();
 
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -61,7 +61,7 @@ protected:
 
     TimePeriodCollection ref_periods_;
 
-    std::vector<EvaluationRequirement::DetectionDetail> details_;
+    EvaluationRequirement::DetectionDetails details_;
 
     bool has_pd_ {false};
     float pd_{0};
@@ -28,10 +28,12 @@
 #include "eval/results/report/section.h"
 #include "eval/results/report/sectioncontenttext.h"
 #include "eval/results/report/sectioncontenttable.h"
+#include "evaluationjob.h"
 
 #include "compass.h"
 #include "dbinterface.h"
 #include "sqliteconnection.h"
+#include "jobmanager.h"
 
 #include "logger.h"
 #include "stringconv.h"
@@ -43,13 +45,8 @@
 #include <QLabel>
 #include <QMessageBox>
 
-#include "util/tbbhack.h"
-
 #include "boost/date_time/posix_time/posix_time.hpp"
 
-#include <future>
-
-
 using namespace std;
 using namespace EvaluationRequirementResult;
 using namespace EvaluationResultsReport;
@@ -62,23 +59,42 @@ EvaluationResultsGenerator::EvaluationResultsGenerator(EvaluationManager& eval_m
 
 EvaluationResultsGenerator::~EvaluationResultsGenerator()
 {
+    if (eval_job_) // no more results needed, job might still be referenced by job manager
+    {
+        eval_job_->setObsolete();
+        eval_job_->waitUntilStopped();
+    }
+
     clear();
 }
 
-void EvaluationResultsGenerator::evaluate (EvaluationData& data, EvaluationStandard& standard)
+void EvaluationResultsGenerator::evaluate (EvaluationData& data, EvaluationStandard& standard, bool show_progress)
 {
     loginf << "EvaluationResultsGenerator: evaluate: skip_no_data_details " << eval_man_.reportSkipNoDataDetails()
            << " split_results_by_mops " << eval_man_.reportSplitResultsByMOPS()
            << " show_adsb_info " << eval_man_.reportShowAdsbInfo();
 
-    boost::posix_time::ptime start_time;
-    boost::posix_time::ptime elapsed_time;
+    assert (!eval_job_);
 
-    start_time = boost::posix_time::microsec_clock::local_time();
+    start_time_ = boost::posix_time::microsec_clock::local_time();
 
     std::vector<std::shared_ptr<SectorLayer>>& sector_layers = eval_man_.sectorsLayers();
 
-    unsigned int num_req_evals = 0;
+    clear();
+
+    utns_.clear();
+
+    for (auto& target_data_it : data)
+    {
+        utns_.push_back(target_data_it.utn_);
+        target_data_it.clearInsideCache(); // sectors might have changed since last evaluation
+    }
+
+    unsigned int num_utns = utns_.size();
+
+    // all used requirements of all sector layers, in order of results
+    req_evals_.clear();
+
     for (auto& sec_it : sector_layers)
     {
         const string& sector_layer_name = sec_it->name();
@@ -90,274 +106,268 @@ void EvaluationResultsGenerator::evaluate (EvaluationData& data, EvaluationStand
             if (!eval_man_.useGroupInSectorLayer(sector_layer_name, requirement_group_name))
                 continue; // skip if not used
 
-            num_req_evals += req_group_it->size() * data.size(); // num reqs * num target
-            num_req_evals += req_group_it->size(); // num reqs for sector sum
+            for (auto& req_cfg_it : *req_group_it)
+            {
+                loginf << "EvaluationResultsGenerator: evaluate: sector layer " << sector_layer_name
+                       << " group " << requirement_group_name
+                       << " req '" << req_cfg_it->name() << "'";
+
+                req_evals_.push_back({sec_it, req_cfg_it->createRequirement()});
+            }
         }
     }
 
-    QProgressDialog postprocess_dialog ("", "", 0, num_req_evals);
-    postprocess_dialog.setWindowTitle("Evaluating");
-    postprocess_dialog.setCancelButton(nullptr);
-    postprocess_dialog.setWindowModality(Qt::ApplicationModal);
+    unsigned int num_reqs = req_evals_.size();
 
-    QLabel* progress_label = new QLabel("", &postprocess_dialog);
-    progress_label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
-    postprocess_dialog.setLabel(progress_label);
+    // req index -> utn index -> result
+    job_results_.assign(num_reqs, vector<shared_ptr<Single>>(num_utns));
 
-    postprocess_dialog.show();
+    show_progress_ = show_progress;
 
-    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+    if (show_progress_)
+    {
+        progress_dialog_.reset(new QProgressDialog("", "Cancel", 0, num_utns));
+        progress_dialog_->setWindowTitle("Evaluating");
+        progress_dialog_->setMinimumDuration(0);
 
-    clear();
+        QLabel* progress_label = new QLabel("", progress_dialog_.get());
+        progress_label->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
+        progress_dialog_->setLabel(progress_label);
 
-    vector<unsigned int> utns;
+        progress_dialog_->setLabelText(("Evaluating "+to_string(num_reqs)+" requirements for "
+                                        +to_string(num_utns)+" targets\n\n\n").c_str());
+        progress_dialog_->setValue(0);
 
-    for (auto& target_data_it : data)
-        utns.push_back(target_data_it.utn_);
+        QObject::connect(progress_dialog_.get(), &QProgressDialog::canceled,
+                         &eval_man_, [this] { cancelEvaluation(); }, Qt::QueuedConnection);
 
-    unsigned int num_utns = utns.size();
+        progress_dialog_->show();
+    }
 
-    unsigned int eval_cnt = 0;
+    // each target is evaluated once for all requirements & sector layers, while its data is hot
+    eval_job_ = make_shared<EvaluationJob>(
+                "EvaluationResultsGenerator", num_utns, [this, &data, num_reqs] (unsigned int utn_cnt)
+    {
+        const EvaluationTargetData& target_data = data.targetData(utns_.at(utn_cnt));
 
-    boost::posix_time::time_duration time_diff;
-    double elapsed_time_s;
-    double time_per_eval, remaining_time_s;
+        for (unsigned int req_cnt=0; req_cnt < num_reqs; ++req_cnt)
+        {
+            ReqEvaluation& req_eval = req_evals_[req_cnt];
 
-    string remaining_time_str;
+            job_results_[req_cnt][utn_cnt] = req_eval.req_->evaluate(
+                        target_data, req_eval.req_, *req_eval.sector_layer_);
+        }
+    });
 
-    string mops_str;
+    // handled in gui thread
+    EvaluationJob* job = eval_job_.get();
 
-    for (auto& sec_it : sector_layers)
+    QObject::connect(job, &EvaluationJob::progressSignal, &eval_man_,
+                     [this, job] (unsigned int num_done, unsigned int num_targets)
     {
-        const string& sector_layer_name = sec_it->name();
+        if (job == eval_job_.get())
+            evaluationProgress(num_done, num_targets);
+    });
+    QObject::connect(job, &EvaluationJob::doneSignal, &eval_man_, [this, job]
+    {
+        if (job == eval_job_.get())
+            evaluationDone();
+    });
 
-        loginf << "EvaluationResultsGenerator: evaluate: sector layer " << sector_layer_name;
+    JobManager::instance().addNonBlockingJob(eval_job_);
+}
 
-        for (auto& req_group_it : standard)
+bool EvaluationResultsGenerator::evaluationRunning() const
+{
+    return eval_job_ != nullptr;
+}
+
+void EvaluationResultsGenerator::cancelEvaluation()
+{
+    if (!eval_job_ || canceling_)
+        return;
+
+    loginf << "EvaluationResultsGenerator: cancelEvaluation";
+
+    canceling_ = true;
+
+    // remaining targets are skipped, evaluationDone is called from done signal
+    eval_job_->setObsolete();
+
+    if (progress_dialog_)
+    {
+        progress_dialog_->setLabelText("Canceling evaluation\n\n\n");
+        progress_dialog_->setCancelButton(nullptr);
+    }
+}
+
+void EvaluationResultsGenerator::abortEvaluation()
+{
+    if (!eval_job_)
+        return;
+
+    loginf << "EvaluationResultsGenerator: abortEvaluation";
+
+    eval_job_->setObsolete();
+    eval_job_->waitUntilStopped(); // later done signal is ignored, since job is reset
+
+    finishCanceled();
+}
+
+void EvaluationResultsGenerator::evaluationProgress(unsigned int num_done, unsigned int num_targets)
+{
+    assert (num_done <= num_targets);
+
+    boost::posix_time::time_duration time_diff = boost::posix_time::microsec_clock::local_time() - start_time_;
+    double elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
+    double remaining_time_s = num_done ? (double)(num_targets-num_done) * elapsed_time_s / (double) num_done : 0;
+
+    logdbg << "EvaluationResultsGenerator: evaluationProgress: " << num_done << "/" << num_targets;
+
+    if (!progress_dialog_)
+        return;
+
+    progress_dialog_->setLabelText(
+                ("Evaluating "+to_string(req_evals_.size())+" requirements for "+to_string(num_targets)+" targets"
+                 +"\n\nElapsed: "+String::timeStringFromDouble(elapsed_time_s, false)
+                 +"\nRemaining: "+String::timeStringFromDouble(remaining_time_s, false)
+                 +" (estimated)").c_str());
+
+    progress_dialog_->setValue(num_done);
+}
+
+void EvaluationResultsGenerator::closeProgressDialog()
+{
+    if (progress_dialog_)
+    {
+        progress_dialog_->blockSignals(true); // close emits canceled
+        progress_dialog_->close();
+        progress_dialog_ = nullptr;
+    }
+}
+
+void EvaluationResultsGenerator::finishCanceled()
+{
+    loginf << "EvaluationResultsGenerator: finishCanceled";
+
+    eval_job_ = nullptr;
+    canceling_ = false;
+
+    closeProgressDialog();
+
+    show_progress_ = true;
+
+    job_results_.clear();
+    req_evals_.clear();
+
+    eval_man_.finishEvaluation(false);
+}
+
+void EvaluationResultsGenerator::evaluationDone()
+{
+    assert (eval_job_);
+    assert (eval_job_->done());
+
+    if (eval_job_->obsolete())
+    {
+        finishCanceled();
+        return;
+    }
+
+    eval_job_ = nullptr;
+
+    closeProgressDialog();
+
+    QApplication::setOverrideCursor(QCursor(Qt::WaitCursor));
+
+    unsigned int num_reqs = req_evals_.size();
+    string mops_str;
+
+    for (unsigned int req_cnt=0; req_cnt < num_reqs; ++req_cnt)
+    {
+        std::shared_ptr<Joined> result_sum;
+        map<string, std::shared_ptr<Joined>> mops_sums;
+
+        for (auto& result_it : job_results_[req_cnt])
         {
-            const string& requirement_group_name = req_group_it->name();
+            assert (result_it);
 
-            if (!eval_man_.useGroupInSectorLayer(sector_layer_name, requirement_group_name))
-                continue; // skip if not used
+            results_[result_it->reqGrpId()][result_it->resultId()] = result_it;
+            results_vec_.push_back(result_it);
 
-            loginf << "EvaluationResultsGenerator: evaluate: sector layer " << sector_layer_name
-                   << " group " << requirement_group_name;
+            if (!result_sum)
+                result_sum = result_it->createEmptyJoined("Sum");
 
-            for (auto& req_cfg_it : *req_group_it)
+            result_sum->join(result_it);
+
+            if (eval_man_.reportSplitResultsByMOPS())
             {
-                loginf << "EvaluationResultsGenerator: evaluate: sector layer " << sector_layer_name
-                       << " group " << requirement_group_name
-                       << " req '" << req_cfg_it->name() << "'";
+                mops_str = result_it->target()->mopsVersionStr();
 
-                std::shared_ptr<EvaluationRequirement::Base> req = req_cfg_it->createRequirement();
-                std::shared_ptr<Joined> result_sum;
-                map<string, std::shared_ptr<Joined>> mops_sums;
-
-                vector<shared_ptr<Single>> results;
-                results.resize(num_utns);
-
-                vector<bool> done_flags;
-                done_flags.resize(num_utns, false);
-                bool task_done = false;
-
-                // generate results
-//                EvaluateTask* t = new (tbb::task::allocate_root()) EvaluateTask(
-//                            results, utns, data, req, *sec_it, done_flags, task_done, false);
-//                tbb::task::enqueue(*t);
-
-                const SectorLayer& sector_layer = *sec_it;
-                bool single_thread = false;
-
-//                int num_threads = oneapi::tbb::info::default_concurrency();
-//                loginf << "EvaluateTask: execute: starting, num_threads " << num_threads;
-
-                std::future<void> pending_future = std::async(std::launch::async, [&] {
-
-                    unsigned int num_utns = utns.size();
-                    assert (done_flags.size() == num_utns);
-
-                    if (single_thread)
-                    {
-                        for(unsigned int utn_cnt=0; utn_cnt < num_utns; ++utn_cnt)
-                        {
-                            results[utn_cnt] = req->evaluate(data.targetData(utns.at(utn_cnt)), req, sector_layer);
-                            done_flags[utn_cnt] = true;
-                        }
-                    }
-                    else
-                    {
-                        tbb::parallel_for(uint(0), num_utns, [&](unsigned int utn_cnt)
-                        {
-                            //assert(num_threads == oneapi::tbb::this_task_arena::max_concurrency());
-                            results[utn_cnt] = req->evaluate(data.targetData(utns.at(utn_cnt)), req, sector_layer);
-                            done_flags[utn_cnt] = true;
-                        });
-                    }
-
-                    for(unsigned int utn_cnt=0; utn_cnt < num_utns; ++utn_cnt)
-                        assert (results[utn_cnt]);
-
-                    task_done = true;
-                });
-
-//                tbb::task_group g;
-
-//                g.run([&] {
-//                    loginf << "EvaluateTask: execute: starting";
-
-//                    unsigned int num_utns = utns.size();
-//                    assert (done_flags.size() == num_utns);
-
-//                    if (single_thread)
-//                    {
-//                        for(unsigned int utn_cnt=0; utn_cnt < num_utns; ++utn_cnt)
-//                        {
-//                            results[utn_cnt] = req->evaluate(data.targetData(utns.at(utn_cnt)), req, sector_layer);
-//                            done_flags[utn_cnt] = true;
-//                        }
-//                    }
-//                    else
-//                    {
-//                        tbb::parallel_for(uint(0), num_utns, [&](unsigned int utn_cnt)
-//                        {
-//                            results[utn_cnt] = req->evaluate(data.targetData(utns.at(utn_cnt)), req, sector_layer);
-//                            done_flags[utn_cnt] = true;
-//                        });
-//                    }
-
-//                    for(unsigned int utn_cnt=0; utn_cnt < num_utns; ++utn_cnt)
-//                        assert (results[utn_cnt]);
-//                });
-
-                unsigned int tmp_done_cnt;
-
-                postprocess_dialog.setLabelText(
-                            ("Sector Layer "+sector_layer_name
-                             +":\n Requirement: "+req_group_it->name()+":\n    "+req_cfg_it->name()+"\n\n\n").c_str());
-                postprocess_dialog.setValue(eval_cnt);
-
-                logdbg << "EvaluationResultsGenerator: evaluate: waiting on group " << req_group_it->name()
-                       << " req '" << req_cfg_it->name() << "'";
+                if (mops_str == "?")
+                    mops_str = "Unknown";
+
+                mops_str = "MOPS "+mops_str;
+
+                if (!mops_sums.count(mops_str+" Sum"))
+                    mops_sums[mops_str+" Sum"] =
+                            result_it->createEmptyJoined(mops_str+" Sum");
 
-                while (!task_done)
-                {
-                    tmp_done_cnt = 0;
-
-                    for (auto done_it : done_flags)
-                    {
-                        if (done_it)
-                            tmp_done_cnt++;
-                    }
-
-                    //assert (eval_cnt+tmp_done_cnt <= num_req_evals);
-                    // hack
-                    if (eval_cnt+tmp_done_cnt <= num_req_evals && tmp_done_cnt)
-                    {
-
-                        elapsed_time = boost::posix_time::microsec_clock::local_time();
-
-                        time_diff = elapsed_time - start_time;
-                        elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
-
-                        time_per_eval = elapsed_time_s/(double)(eval_cnt+tmp_done_cnt);
-                        remaining_time_s = (double)(num_req_evals-eval_cnt-tmp_done_cnt)*time_per_eval;
-
-                        postprocess_dialog.setLabelText(
-                                    ("Sector Layer "+sector_layer_name
-                                     +":\n  "+req_group_it->name()+":\n    "+req_cfg_it->name()
-                                     +"\n\nElapsed: "+String::timeStringFromDouble(elapsed_time_s, false)
-                                     +"\nRemaining: "+String::timeStringFromDouble(remaining_time_s, false)
-                                     +" (estimated)").c_str());
-
-                        postprocess_dialog.setValue(eval_cnt+tmp_done_cnt);
-                    }
-
-                    if (!task_done)
-                    {
-                        QCoreApplication::processEvents();
-                        QThread::msleep(200);
-                    }
-                }
-
-                postprocess_dialog.setLabelText(("Sector Layer "+sector_layer_name+":\nAggregating results").c_str());
-
-                for (auto& result_it : results)
-                {
-                    results_[result_it->reqGrpId()][result_it->resultId()] = result_it;
-                    results_vec_.push_back(result_it);
-
-                    if (!result_sum)
-                        result_sum = result_it->createEmptyJoined("Sum");
-
-                    result_sum->join(result_it);
-
-                    if (eval_man_.reportSplitResultsByMOPS())
-                    {
-                        mops_str = result_it->target()->mopsVersionStr();
-
-                        if (mops_str == "?")
-                            mops_str = "Unknown";
-
-                        mops_str = "MOPS "+mops_str;
-
-                        if (!mops_sums.count(mops_str+" Sum"))
-                            mops_sums[mops_str+" Sum"] =
-                                    result_it->createEmptyJoined(mops_str+" Sum");
-
-                        mops_sums.at(mops_str+" Sum")->join(result_it);
-                    }
-                }
-
-                if (result_sum)
-                {
-                    loginf << "EvaluationResultsGenerator: evaluate: adding result '" << result_sum->reqGrpId()
-                           << "' id '" << result_sum->resultId() << "'";
-                    assert (!results_[result_sum->reqGrpId()].count(result_sum->resultId()));
-                    results_[result_sum->reqGrpId()][result_sum->resultId()] = result_sum;
-                    results_vec_.push_back(result_sum); // has to be added after all singles
-                }
-
-                if (eval_man_.reportSplitResultsByMOPS())
-                {
-                    for (auto& mops_res_it : mops_sums)
-                    {
-                        loginf << "EvaluationResultsGenerator: evaluate: adding result '"
-                               << mops_res_it.second->reqGrpId()
-                               << "' id '" << mops_res_it.second->resultId() << "'";
-
-                        assert (!results_[mops_res_it.second->reqGrpId()].count(mops_res_it.second->resultId()));
-                        results_[mops_res_it.second->reqGrpId()][mops_res_it.second->resultId()] = mops_res_it.second;
-                        results_vec_.push_back(mops_res_it.second); // has to be added after all singles
-                    }
-                }
-
-                assert (eval_cnt <= num_req_evals);
-                eval_cnt = results_vec_.size();
+                mops_sums.at(mops_str+" Sum")->join(result_it);
+            }
+        }
+
+        job_results_[req_cnt].clear(); // now held in results_
+
+        if (result_sum)
+        {
+            loginf << "EvaluationResultsGenerator: evaluationDone: adding result '" << result_sum->reqGrpId()
+                   << "' id '" << result_sum->resultId() << "'";
+            assert (!results_[result_sum->reqGrpId()].count(result_sum->resultId()));
+            results_[result_sum->reqGrpId()][result_sum->resultId()] = result_sum;
+            results_vec_.push_back(result_sum); // has to be added after all singles
+        }
+
+        if (eval_man_.reportSplitResultsByMOPS())
+        {
+            for (auto& mops_res_it : mops_sums)
+            {
+                loginf << "EvaluationResultsGenerator: evaluationDone: adding result '"
+                       << mops_res_it.second->reqGrpId()
+                       << "' id '" << mops_res_it.second->resultId() << "'";
+
+                assert (!results_[mops_res_it.second->reqGrpId()].count(mops_res_it.second->resultId()));
+                results_[mops_res_it.second->reqGrpId()][mops_res_it.second->resultId()] = mops_res_it.second;
+                results_vec_.push_back(mops_res_it.second); // has to be added after all singles
             }
         }
     }
 
-    elapsed_time = boost::posix_time::microsec_clock::local_time();
+    job_results_.clear();
+    req_evals_.clear();
 
-    time_diff = elapsed_time - start_time;
-    elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
+    boost::posix_time::time_duration time_diff = boost::posix_time::microsec_clock::local_time() - start_time_;
+    double elapsed_time_s = time_diff.total_milliseconds() / 1000.0;
 
-    loginf << "EvaluationResultsGenerator: evaluate: data done " << String::timeStringFromDouble(elapsed_time_s, true);
+    loginf << "EvaluationResultsGenerator: evaluationDone: data done "
+           << String::timeStringFromDouble(elapsed_time_s, true);
 
     // 00:06:22.852 with no parallel
 
     emit eval_man_.resultsChangedSignal();
 
-    postprocess_dialog.close();
-
-    loginf << "EvaluationResultsGenerator: evaluate: generating results";
+    loginf << "EvaluationResultsGenerator: evaluationDone: generating results";
 
     // generating results GUI
     generateResultsReportGUI();
 
-    loginf << "EvaluationResultsGenerator: evaluate: done " << String::timeStringFromDouble(elapsed_time_s, true);
+    loginf << "EvaluationResultsGenerator: evaluationDone: done " << String::timeStringFromDouble(elapsed_time_s, true);
 
     QApplication::restoreOverrideCursor();
+
+    show_progress_ = true;
+
+    eval_man_.finishEvaluation(true);
 }
 
 void EvaluationResultsGenerator::clear()
@@ -384,7 +394,9 @@ void EvaluationResultsGenerator::generateResultsReportGUI()
     msg_box.setText( "Please wait...");
     msg_box.setStandardButtons(QMessageBox::NoButton);
     msg_box.setWindowModality(Qt::ApplicationModal);
-    msg_box.show();
+
+    if (show_progress_)
+        msg_box.show();
 
     // prepare for new data
     results_model_.beginReset();
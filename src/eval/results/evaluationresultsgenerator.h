@@ -26,10 +26,14 @@
 #include "sectorlayer.h"
 #include "logger.h"
 
+#include "boost/date_time/posix_time/ptime.hpp"
+
 //#include <tbb/tbb.h>
 
 class EvaluationManager;
 class EvaluationStandard;
+class EvaluationJob;
+class QProgressDialog;
 
 namespace EvaluationRequirementResult
 {
@@ -103,7 +107,12 @@ public:
     EvaluationResultsGenerator(EvaluationManager& eval_man);
     virtual ~EvaluationResultsGenerator();
 
-    void evaluate (EvaluationData& data, EvaluationStandard& standard);
+    // starts evaluation as background job, EvaluationManager::finishEvaluation is called when done
+    void evaluate (EvaluationData& data, EvaluationStandard& standard, bool show_progress=true);
+    bool evaluationRunning() const;
+    void cancelEvaluation(); // finished as canceled when job is done, does not wait
+    // finishes as canceled immediately, only waits for targets in process, for data about to be deleted
+    void abortEvaluation();
 
     EvaluationResultsReport::TreeModel& resultsModel();
 
@@ -135,6 +144,30 @@ protected:
     std::map<std::string, std::map<std::string, std::shared_ptr<EvaluationRequirementResult::Base>>> results_;
     std::vector<std::shared_ptr<EvaluationRequirementResult::Base>> results_vec_; // ordered as generated
 
+    // used requirement of a sector layer
+    struct ReqEvaluation
+    {
+        std::shared_ptr<SectorLayer> sector_layer_; // kept if sector layers are changed
+        std::shared_ptr<EvaluationRequirement::Base> req_;
+    };
+
+    // running evaluation
+    std::shared_ptr<EvaluationJob> eval_job_;
+    std::unique_ptr<QProgressDialog> progress_dialog_;
+    bool show_progress_ {true}; // false for running evaluation without gui
+    bool canceling_ {false};
+    boost::posix_time::ptime start_time_;
+
+    std::vector<unsigned int> utns_;
+    std::vector<ReqEvaluation> req_evals_; // all used requirements of all sector layers, in order of results
+    std::vector<std::vector<std::shared_ptr<EvaluationRequirementResult::Single>>> job_results_;
+    // req index -> utn index -> result
+
+    void evaluationProgress(unsigned int num_done, unsigned int num_targets);
+    void evaluationDone(); // aggregates results
+    void finishCanceled();
+    void closeProgressDialog();
+
     void addNonResultsContent (std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
 };
 
@@ -41,11 +41,13 @@ SingleExtraData::SingleExtraData(
         const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
         EvaluationManager& eval_man,
         bool ignore, unsigned int num_extra, unsigned int num_ok, bool has_extra_test_data,
-        std::vector<EvaluationRequirement::ExtraDataDetail> details)
+        EvaluationRequirement::ExtraDataDetails details)
     : Single("SingleExtraData", result_id, requirement, sector_layer, utn, target, eval_man),
       ignore_(ignore), num_extra_(num_extra), num_ok_(num_ok), has_extra_test_data_(has_extra_test_data),
-      details_(details)
+      details_(std::move(details))
 {
+    details_.shrink_to_fit(); // grown for all test updates
+
     //result_usable_ = !ignore;
 
     updateProb();
@@ -198,7 +200,7 @@ void SingleExtraData::reportDetails(EvaluationResultsReport::Section& utn_req_se
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(),
@@ -347,7 +349,7 @@ bool SingleExtraData::hasExtraTestData() const
     return has_extra_test_data_;
 }
 
-const std::vector<EvaluationRequirement::ExtraDataDetail>& SingleExtraData::details() const
+const EvaluationRequirement::ExtraDataDetails& SingleExtraData::details() const
 {
     return details_;
 }
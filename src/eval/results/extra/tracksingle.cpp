@@ -41,10 +41,12 @@ SingleExtraTrack::SingleExtraTrack(
         const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
         EvaluationManager& eval_man,
         bool ignore, unsigned int num_inside, unsigned int num_extra, unsigned int num_ok,
-        std::vector<EvaluationRequirement::ExtraTrackDetail> details)
+        EvaluationRequirement::ExtraTrackDetails details)
     : Single("SingleExtraTrack", result_id, requirement, sector_layer, utn, target, eval_man),
-      ignore_(ignore), num_inside_(num_inside), num_extra_(num_extra), num_ok_(num_ok), details_(details)
+      ignore_(ignore), num_inside_(num_inside), num_extra_(num_extra), num_ok_(num_ok), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // grown for all test updates
+
     //loginf << "SingleTrack: ctor: result_id " << result_id_ << " ignore " << ignore_;
 
     updateProb();
@@ -197,7 +199,7 @@ void SingleExtraTrack::reportDetails(EvaluationResultsReport::Section& utn_req_s
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(),
@@ -356,7 +358,7 @@ unsigned int SingleExtraTrack::numOK() const
     return num_ok_;
 }
 
-const std::vector<EvaluationRequirement::ExtraTrackDetail>& SingleExtraTrack::details() const
+const EvaluationRequirement::ExtraTrackDetails& SingleExtraTrack::details() const
 {
     return details_;
 }
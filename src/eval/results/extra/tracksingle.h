@@ -32,7 +32,7 @@ public:
             const SectorLayer& sector_layer, unsigned int utn, const EvaluationTargetData* target,
             EvaluationManager& eval_man,
             bool ignore, unsigned int num_inside, unsigned int num_extra,  unsigned int num_ok,
-            std::vector<EvaluationRequirement::ExtraTrackDetail> details);
+            EvaluationRequirement::ExtraTrackDetails details);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
@@ -54,14 +54,14 @@ public:
     unsigned int numExtra() const;
     unsigned int numOK() const;
 
-    const std::vector<EvaluationRequirement::ExtraTrackDetail>& details() const;
+    const EvaluationRequirement::ExtraTrackDetails& details() const;
 
 protected:
     bool ignore_ {false};
     unsigned int num_inside_ {0};
     unsigned int num_extra_ {0};
     unsigned int num_ok_ {0};
-    std::vector<EvaluationRequirement::ExtraTrackDetail> details_;
+    EvaluationRequirement::ExtraTrackDetails details_;
 
     bool has_prob_ {false};
     float prob_{0};
@@ -43,12 +43,14 @@ SingleIdentificationCorrect::SingleIdentificationCorrect(
         unsigned int num_updates, unsigned int num_no_ref_pos, unsigned int num_no_ref_id,
         unsigned int num_pos_outside, unsigned int num_pos_inside,
         unsigned int num_correct, unsigned int num_not_correct,
-        std::vector<EvaluationRequirement::CorrectnessDetail> details)
+        EvaluationRequirement::CorrectnessDetails details)
     : Single("SingleIdentificationCorrect", result_id, requirement, sector_layer, utn, target, eval_man),
       num_updates_(num_updates), num_no_ref_pos_(num_no_ref_pos), num_no_ref_id_(num_no_ref_id),
       num_pos_outside_(num_pos_outside), num_pos_inside_(num_pos_inside),
-      num_correct_(num_correct), num_not_correct_(num_not_correct), details_(details)
+      num_correct_(num_correct), num_not_correct_(num_not_correct), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // grown for all test updates
+
     updatePID();
 }
 
@@ -197,7 +199,7 @@ void SingleIdentificationCorrect::reportDetails(EvaluationResultsReport::Section
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(), rq_det_it.ref_exists_,
@@ -267,7 +269,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleIdentificationCorrect::getTarget
     bool has_pos = false;
     double lat_min, lat_max, lon_min, lon_max;
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if (!detail_it.is_not_correct_)
             continue;
@@ -370,7 +372,7 @@ unsigned int SingleIdentificationCorrect::numNotCorrect() const
     return num_not_correct_;
 }
 
-std::vector<EvaluationRequirement::CorrectnessDetail>& SingleIdentificationCorrect::details()
+EvaluationRequirement::CorrectnessDetails& SingleIdentificationCorrect::details()
 {
     return details_;
 }
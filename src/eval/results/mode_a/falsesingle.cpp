@@ -42,13 +42,15 @@ namespace EvaluationRequirementResult
             unsigned int utn, const EvaluationTargetData* target, EvaluationManager& eval_man,
             int num_updates, int num_no_ref_pos, int num_no_ref_val, int num_pos_outside, int num_pos_inside,
             int num_unknown, int num_correct, int num_false,
-            std::vector<EvaluationRequirement::CheckDetail> details)
+            EvaluationRequirement::CheckDetails details)
         : Single("SingleModeAFalse", result_id, requirement, sector_layer, utn, target, eval_man),
           num_updates_(num_updates), num_no_ref_pos_(num_no_ref_pos), num_no_ref_val_(num_no_ref_val),
           num_pos_outside_(num_pos_outside), num_pos_inside_(num_pos_inside),
           num_unknown_(num_unknown),
-          num_correct_(num_correct), num_false_(num_false), details_(details)
+          num_correct_(num_correct), num_false_(num_false), details_(std::move(details))
     {
+        details_.shrink_to_fit(); // grown for all test updates
+
         updateProbabilities();
     }
 
@@ -202,7 +204,7 @@ namespace EvaluationRequirementResult
 
         unsigned int detail_cnt = 0;
 
-        for (auto& rq_det_it : details_)
+        for (const auto& rq_det_it : details_)
         {
             utn_req_details_table.addRow(
             {Time::toString(rq_det_it.timestamp_).c_str(), rq_det_it.ref_exists_,
@@ -273,7 +275,7 @@ namespace EvaluationRequirementResult
         bool has_pos = false;
         double lat_min, lat_max, lon_min, lon_max;
 
-        for (auto& detail_it : details_)
+        for (const auto& detail_it : details_)
         {
             if (!detail_it.is_not_ok_)
                 continue;
@@ -381,7 +383,7 @@ namespace EvaluationRequirementResult
         return num_false_;
     }
 
-    std::vector<EvaluationRequirement::CheckDetail>& SingleModeAFalse::details()
+    EvaluationRequirement::CheckDetails& SingleModeAFalse::details()
     {
         return details_;
     }
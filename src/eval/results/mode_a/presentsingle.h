@@ -34,7 +34,7 @@ public:
             unsigned int utn, const EvaluationTargetData* target, EvaluationManager& eval_man,
             int num_updates, int num_no_ref_pos, int num_pos_outside, int num_pos_inside,
             int num_no_ref_id, int num_present_id, int num_missing_id,
-            std::vector<EvaluationRequirement::PresentDetail> details);
+            EvaluationRequirement::PresentDetails details);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
@@ -48,7 +48,7 @@ public:
     int numPresent() const;
     int numMissing() const;
 
-    std::vector<EvaluationRequirement::PresentDetail>& details();
+    EvaluationRequirement::PresentDetails& details();
 
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -73,7 +73,7 @@ protected:
     bool has_p_present_ {false};
     float p_present_{0};
 
-    std::vector<EvaluationRequirement::PresentDetail> details_;
+    EvaluationRequirement::PresentDetails details_;
 
     void updateProbabilities();
     void addTargetToOverviewTable(std::shared_ptr<EvaluationResultsReport::RootItem> root_item);
@@ -42,13 +42,15 @@ SingleModeCFalse::SingleModeCFalse(
         unsigned int utn, const EvaluationTargetData* target, EvaluationManager& eval_man,
         int num_updates, int num_no_ref_pos, int num_no_ref_val, int num_pos_outside, int num_pos_inside,
         int num_unknown, int num_correct, int num_false,
-        std::vector<EvaluationRequirement::CheckDetail> details)
+        EvaluationRequirement::CheckDetails details)
     : Single("SingleModeCFalse", result_id, requirement, sector_layer, utn, target, eval_man),
       num_updates_(num_updates), num_no_ref_pos_(num_no_ref_pos), num_no_ref_val_(num_no_ref_val),
       num_pos_outside_(num_pos_outside), num_pos_inside_(num_pos_inside),
       num_unknown_(num_unknown),
-      num_correct_(num_correct), num_false_(num_false), details_(details)
+      num_correct_(num_correct), num_false_(num_false), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // grown for all test updates
+
     updateProbabilities();
 }
 
@@ -222,7 +224,7 @@ void SingleModeCFalse::reportDetails(EvaluationResultsReport::Section& utn_req_s
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(), rq_det_it.ref_exists_,
@@ -293,7 +295,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleModeCFalse::getTargetErrorsViewa
     bool has_pos = false;
     double lat_min, lat_max, lon_min, lon_max;
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if (!detail_it.is_not_ok_)
             continue;
@@ -401,7 +403,7 @@ int SingleModeCFalse::numFalse() const
     return num_false_;
 }
 
-std::vector<EvaluationRequirement::CheckDetail>& SingleModeCFalse::details()
+EvaluationRequirement::CheckDetails& SingleModeCFalse::details()
 {
     return details_;
 }
@@ -42,13 +42,15 @@ SingleModeCPresent::SingleModeCPresent(
         unsigned int utn, const EvaluationTargetData* target, EvaluationManager& eval_man,
         int num_updates, int num_no_ref_pos, int num_pos_outside, int num_pos_inside,
         int num_no_ref_id, int num_present_id, int num_missing_id,
-        std::vector<EvaluationRequirement::PresentDetail> details)
+        EvaluationRequirement::PresentDetails details)
     : Single("SingleModeCPresent", result_id, requirement, sector_layer, utn, target, eval_man),
       num_updates_(num_updates), num_no_ref_pos_(num_no_ref_pos),
       num_pos_outside_(num_pos_outside), num_pos_inside_(num_pos_inside),
       num_no_ref_id_(num_no_ref_id),
-      num_present_id_(num_present_id), num_missing_id_(num_missing_id), details_(details)
+      num_present_id_(num_present_id), num_missing_id_(num_missing_id), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // grown for all test updates
+
     updateProbabilities();
 }
 
@@ -202,7 +204,7 @@ void SingleModeCPresent::reportDetails(EvaluationResultsReport::Section& utn_req
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(), rq_det_it.ref_exists_,
@@ -273,7 +275,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleModeCPresent::getTargetErrorsVie
     bool has_pos = false;
     double lat_min, lat_max, lon_min, lon_max;
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if (!detail_it.is_not_ok_)
             continue;
@@ -376,7 +378,7 @@ int SingleModeCPresent::numMissing() const
     return num_missing_id_;
 }
 
-std::vector<EvaluationRequirement::PresentDetail>& SingleModeCPresent::details()
+EvaluationRequirement::PresentDetails& SingleModeCPresent::details()
 {
     return details_;
 }
@@ -46,12 +46,14 @@ SinglePositionAlong::SinglePositionAlong(
         unsigned int num_pos_outside, unsigned int num_pos_inside,
         unsigned int num_value_ok, unsigned int num_value_nok,
         vector<double> values,
-        std::vector<EvaluationRequirement::PositionDetail> details)
+        EvaluationRequirement::PositionDetails details)
     : Single("SinglePositionAlong", result_id, requirement, sector_layer, utn, target, eval_man),
       num_pos_(num_pos), num_no_ref_(num_no_ref), num_pos_outside_(num_pos_outside),
       num_pos_inside_(num_pos_inside), num_value_ok_(num_value_ok), num_value_nok_(num_value_nok),
-      values_(values), details_(details)
+      values_(values), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // reserved for all test updates
+
     update();
 }
 
@@ -294,7 +296,7 @@ void SinglePositionAlong::reportDetails(EvaluationResultsReport::Section& utn_re
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(),
@@ -366,7 +368,7 @@ std::unique_ptr<nlohmann::json::object_t> SinglePositionAlong::getTargetErrorsVi
     bool has_pos = false;
     double lat_min, lat_max, lon_min, lon_max;
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if (detail_it.check_passed_)
             continue;
@@ -479,7 +481,7 @@ unsigned int SinglePositionAlong::numNoRef() const
     return num_no_ref_;
 }
 
-std::vector<EvaluationRequirement::PositionDetail>& SinglePositionAlong::details()
+EvaluationRequirement::PositionDetails& SinglePositionAlong::details()
 {
     return details_;
 }
@@ -46,12 +46,14 @@ SinglePositionDistance::SinglePositionDistance(
         unsigned int num_pos_outside, unsigned int num_pos_inside,
         unsigned int num_comp_failed, unsigned int num_comp_passed,
         vector<double> values,
-        std::vector<EvaluationRequirement::PositionDetail> details)
+        EvaluationRequirement::PositionDetails details)
     : Single("SinglePositionDistance", result_id, requirement, sector_layer, utn, target, eval_man),
       num_pos_(num_pos), num_no_ref_(num_no_ref), num_pos_outside_(num_pos_outside),
       num_pos_inside_(num_pos_inside), num_comp_failed_(num_comp_failed), num_comp_passed_(num_comp_passed),
-      values_(values), details_(details)
+      values_(values), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // reserved for all test updates
+
     update();
 }
 
@@ -309,7 +311,7 @@ void SinglePositionDistance::reportDetails(EvaluationResultsReport::Section& utn
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(),
@@ -383,7 +385,7 @@ std::unique_ptr<nlohmann::json::object_t> SinglePositionDistance::getTargetError
 
     bool failed_values_of_interest = req()->failedValuesOfInterest();
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if ((failed_values_of_interest && detail_it.check_passed_)
                 || (!failed_values_of_interest && !detail_it.check_passed_))
@@ -497,7 +499,7 @@ unsigned int SinglePositionDistance::numNoRef() const
     return num_no_ref_;
 }
 
-std::vector<EvaluationRequirement::PositionDetail>& SinglePositionDistance::details()
+EvaluationRequirement::PositionDetails& SinglePositionDistance::details()
 {
     return details_;
 }
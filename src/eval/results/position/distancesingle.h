@@ -36,7 +36,7 @@ public:
             unsigned int num_pos_outside, unsigned int num_pos_inside,
             unsigned int num_comp_failed, unsigned int num_comp_passed,
             vector<double> values,
-            std::vector<EvaluationRequirement::PositionDetail> details);
+            EvaluationRequirement::PositionDetails details);
 
     virtual void addToReport (std::shared_ptr<EvaluationResultsReport::RootItem> root_item) override;
 
@@ -51,7 +51,7 @@ public:
 
     const vector<double>& values() const;
 
-    std::vector<EvaluationRequirement::PositionDetail>& details();
+    EvaluationRequirement::PositionDetails& details();
 
     virtual bool hasViewableData (
             const EvaluationResultsReport::SectionContentTable& table, const QVariant& annotation) override;
@@ -83,7 +83,7 @@ protected:
     bool has_p_min_ {false};
     float p_passed_{0};
 
-    std::vector<EvaluationRequirement::PositionDetail> details_;
+    EvaluationRequirement::PositionDetails details_;
 
     void update();
 
@@ -46,13 +46,15 @@ SingleSpeed::SingleSpeed(
         unsigned int num_pos_outside, unsigned int num_pos_inside, unsigned int num_no_tst_value,
         unsigned int num_comp_failed, unsigned int num_comp_passed,
         vector<double> values,
-        std::vector<EvaluationRequirement::SpeedDetail> details)
+        EvaluationRequirement::SpeedDetails details)
     : Single("SingleSpeed", result_id, requirement, sector_layer, utn, target, eval_man),
       num_pos_(num_pos), num_no_ref_(num_no_ref), num_pos_outside_(num_pos_outside),
       num_pos_inside_(num_pos_inside), num_no_tst_value_(num_no_tst_value),
       num_comp_failed_(num_comp_failed), num_comp_passed_(num_comp_passed),
-      values_(values), details_(details)
+      values_(values), details_(std::move(details))
 {
+    details_.shrink_to_fit(); // grown for all test updates
+
     update();
 }
 
@@ -311,7 +313,7 @@ void SingleSpeed::reportDetails(EvaluationResultsReport::Section& utn_req_sectio
 
     unsigned int detail_cnt = 0;
 
-    for (auto& rq_det_it : details_)
+    for (const auto& rq_det_it : details_)
     {
         utn_req_details_table.addRow(
                     {Time::toString(rq_det_it.timestamp_).c_str(),
@@ -385,7 +387,7 @@ std::unique_ptr<nlohmann::json::object_t> SingleSpeed::getTargetErrorsViewable (
 
     bool failed_values_of_interest = req()->failedValuesOfInterest();
 
-    for (auto& detail_it : details_)
+    for (const auto& detail_it : details_)
     {
         if ((failed_values_of_interest && detail_it.check_passed_)
                 || (!failed_values_of_interest && !detail_it.check_passed_))
@@ -504,7 +506,7 @@ unsigned int SingleSpeed::numNoRef() const
     return num_no_ref_;
 }
 
-std::vector<EvaluationRequirement::SpeedDetail>& SingleSpeed::details()
+EvaluationRequirement::SpeedDetails& SingleSpeed::details()
 {
     return details_;
 }
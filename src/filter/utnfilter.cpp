@@ -21,6 +21,8 @@
 #include "dbcontent/dbcontent.h"
 #include "dbcontent/dbcontentmanager.h"
 #include "dbcontent/variable/metavariable.h"
+#include "dbinterface.h"
+#include "sqlgenerator.h"
 #include "logger.h"
 #include "stringconv.h"
 
@@ -74,18 +76,22 @@ std::string UTNFilter::getConditionString(const std::string& dbcontent_name, boo
         assert (dbcontent_man.existsDBContent(dbcontent_name));
 
         assert (dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).existsIn(dbcontent_name));
-        //Variable& assoc_var = dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).getFor(dbcontent_name);
+        assert (dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).existsIn(dbcontent_name));
 
-        //extra_from_parts.push_back("json_each("+dbcontent_man.dbContent(dbcontent_name).dbTableName()+".associations)");
+        string rec_num_col_name =
+                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).dbColumnName();
 
         if (!first)
         {
             ss << " AND";
         }
 
-        // SELECT x FROM data_cat062, json_each(data_cat062.associations) WHERE json_each.value == 0;
+        // SELECT x FROM data_cat062 WHERE data_cat062.rec_num IN
+        // (SELECT associations.rec_num FROM associations WHERE associations.dbcontent = 'CAT062'
+        // AND associations.utn IN (0));
 
-        ss << " json_each.value IN (" << utns_str_ << ")";
+        ss << " " << COMPASS::instance().interface().sqlGenerator().getAssociationsCondition(
+                  dbcontent_man.dbContent(dbcontent_name), rec_num_col_name, utns_str_);
 
         first = false;
     }
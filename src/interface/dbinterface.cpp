@@ -22,6 +22,7 @@
 #include "dbcommand.h"
 #include "dbcommandlist.h"
 #include "sqliteconnection.h"
+#include "sqlitereader.h"
 #include "dbcontent/dbcontent.h"
 #include "dbcontent/dbcontentmanager.h"
 #include "dbcontent/variable/variable.h"
@@ -49,6 +50,7 @@
 
 #include "boost/date_time/posix_time/posix_time.hpp"
 
+#include <deque>
 #include <fstream>
 
 using namespace Utils;
@@ -68,6 +70,8 @@ DBInterface::DBInterface(string class_id, string instance_id, COMPASS* compass)
     boost::mutex::scoped_lock locker(connection_mutex_);
 
     registerParameter("read_chunk_size", &read_chunk_size_, 50000);
+    registerParameter("benchmark_insert", &benchmark_insert_, false);
+    registerParameter("benchmark_storage_profiles", &benchmark_storage_profiles_, false);
 
     createSubConfigurables();
 }
@@ -160,6 +164,12 @@ void DBInterface::openDBFile(const std::string& filename, bool overwrite)
     if (!existsTargetsTable())
         createTargetsTable();
 
+    if (!existsAssociationsTable())
+        createAssociationsTable(!created_new_db); // associations of previous versions are in data tables
+
+    if (benchmark_storage_profiles_)
+        benchmarkStorageProfiles();
+
     //emit databaseOpenedSignal();
 
     QApplication::restoreOverrideCursor();
@@ -226,6 +236,129 @@ SQLiteConnection& DBInterface::connection()
     return *db_connection_;
 }
 
+std::vector<std::string> DBInterface::storageProfileNames()
+{
+    assert(db_connection_);
+    return db_connection_->storageProfileNames();
+}
+
+std::string DBInterface::storageProfile()
+{
+    assert(db_connection_);
+    return db_connection_->storageProfile();
+}
+
+void DBInterface::storageProfile(const std::string& name)
+{
+    boost::mutex::scoped_lock locker(connection_mutex_);
+
+    assert(db_connection_);
+    db_connection_->storageProfile(name);
+}
+
+void DBInterface::useImportStorageProfile(bool live)
+{
+    boost::mutex::scoped_lock locker(connection_mutex_);
+
+    assert(db_connection_);
+    db_connection_->useImportStorageProfile(live);
+}
+
+void DBInterface::useConfiguredStorageProfile()
+{
+    boost::mutex::scoped_lock locker(connection_mutex_);
+
+    assert(db_connection_);
+    db_connection_->useConfiguredStorageProfile();
+}
+
+void DBInterface::benchmarkStorageProfiles(unsigned int num_rows)
+{
+    loginf << "DBInterface: benchmarkStorageProfiles: rows " << num_rows;
+
+    assert (dbOpen());
+
+    boost::mutex::scoped_lock locker(connection_mutex_);
+
+    string table_name = "benchmark_storage";
+
+    PropertyList list;
+    list.addProperty("rec_num", PropertyDataType::UINT);
+    list.addProperty("ts", PropertyDataType::DOUBLE);
+    list.addProperty("lat", PropertyDataType::DOUBLE);
+    list.addProperty("lon", PropertyDataType::DOUBLE);
+    list.addProperty("callsign", PropertyDataType::STRING);
+
+    shared_ptr<Buffer> buffer = make_shared<Buffer>(list);
+
+    {
+        NullableVector<unsigned int>& rec_num_vec = buffer->get<unsigned int>("rec_num");
+        NullableVector<double>& ts_vec = buffer->get<double>("ts");
+        NullableVector<double>& lat_vec = buffer->get<double>("lat");
+        NullableVector<double>& lon_vec = buffer->get<double>("lon");
+        NullableVector<string>& callsign_vec = buffer->get<string>("callsign");
+
+        for (unsigned int cnt = 0; cnt < num_rows; ++cnt)
+        {
+            rec_num_vec.set(cnt, cnt);
+            ts_vec.set(cnt, cnt * 0.01);
+            lat_vec.set(cnt, 47.0 + (cnt % 1000) * 0.001);
+            lon_vec.set(cnt, 15.0 + (cnt % 997) * 0.001);
+            callsign_vec.set(cnt, "BM" + to_string(cnt % 5000));
+        }
+    }
+
+    DBCommand load_command;
+    load_command.set("SELECT rec_num, ts, lat, lon, callsign FROM " + table_name + ";");
+    load_command.list(list);
+
+    DBCommand filter_command;
+    filter_command.set("SELECT rec_num, ts, lat, lon, callsign FROM " + table_name
+                       + " WHERE ts BETWEEN " + to_string(num_rows * 0.0025)
+                       + " AND " + to_string(num_rows * 0.0075) + " AND lat < 47.5;");
+    filter_command.list(list);
+
+    string org_profile = db_connection_->storageProfile();
+
+    boost::posix_time::ptime start_time;
+    double insert_time, load_time, filter_time;
+    size_t loaded_rows, filtered_rows;
+
+    for (auto& profile : db_connection_->storageProfileNames())
+    {
+        db_connection_->storageProfile(profile);
+
+        db_connection_->executeSQL("DROP TABLE IF EXISTS " + table_name + ";");
+        db_connection_->executeSQL("CREATE TABLE " + table_name
+                                   + " (rec_num INT, ts DOUBLE, lat DOUBLE, lon DOUBLE, callsign VARCHAR(255));");
+
+        start_time = boost::posix_time::microsec_clock::local_time();
+
+        db_connection_->beginBindTransaction();
+        insertBufferColumnar(table_name, buffer);
+        db_connection_->endBindTransaction();
+
+        insert_time = Time::partialSeconds(boost::posix_time::microsec_clock::local_time() - start_time);
+
+        start_time = boost::posix_time::microsec_clock::local_time();
+        loaded_rows = db_connection_->execute(load_command)->buffer()->size();
+        load_time = Time::partialSeconds(boost::posix_time::microsec_clock::local_time() - start_time);
+
+        start_time = boost::posix_time::microsec_clock::local_time();
+        filtered_rows = db_connection_->execute(filter_command)->buffer()->size();
+        filter_time = Time::partialSeconds(boost::posix_time::microsec_clock::local_time() - start_time);
+
+        db_connection_->executeSQL("DROP TABLE " + table_name + ";");
+
+        loginf << "DBInterface: benchmarkStorageProfiles: profile '" << profile << "'"
+               << " insert " << String::doubleToStringPrecision(insert_time, 3) << " s"
+               << " load " << loaded_rows << " rows " << String::doubleToStringPrecision(load_time, 3) << " s"
+               << " filter " << filtered_rows << " rows " << String::doubleToStringPrecision(filter_time, 3) << " s";
+    }
+
+    db_connection_->storageProfile(org_profile);
+}
+
 void DBInterface::generateSubConfigurable(const string& class_id,
                                           const string& instance_id)
 {
@@ -1053,6 +1186,114 @@ void DBInterface::saveTargets(std::map<unsigned int, std::shared_ptr<dbContent::
 }
 
 
+bool DBInterface::existsAssociationsTable()
+{
+    return existsTable(TABLE_NAME_ASSOCIATIONS);
+}
+
+void DBInterface::createAssociationsTable(bool migrate)
+{
+    loginf << "DBInterface: createAssociationsTable: migrate " << migrate;
+
+    assert(!existsAssociationsTable());
+
+    string sql = sql_generator_.getTableAssociationsCreateStatement();
+
+    if (migrate)
+    {
+        DBContentManager& dbcont_man = COMPASS::instance().dbContentManager();
+
+        string table_name, rec_num_col_name, assoc_col_name;
+
+        boost::mutex::scoped_lock locker(table_info_mutex_);
+
+        for (auto& dbcont_it : dbcont_man)
+        {
+            if (!dbcont_man.metaCanGetVariable(dbcont_it.first, DBContent::meta_var_rec_num_)
+                    || !dbcont_man.metaCanGetVariable(dbcont_it.first, DBContent::meta_var_associations_))
+                continue;
+
+            table_name = dbcont_it.second->dbTableName();
+            rec_num_col_name = dbcont_man.metaGetVariable(
+                        dbcont_it.first, DBContent::meta_var_rec_num_).dbColumnName();
+            assoc_col_name = dbcont_man.metaGetVariable(
+                        dbcont_it.first, DBContent::meta_var_associations_).dbColumnName();
+
+            if (!table_info_.count(table_name) || !table_info_.at(table_name).hasColumn(assoc_col_name))
+                continue;
+
+            loginf << "DBInterface: createAssociationsTable: migrating associations of " << dbcont_it.first;
+
+            sql += sql_generator_.getMigrateAssociationsStatement(
+                        dbcont_it.first, table_name, rec_num_col_name, assoc_col_name);
+        }
+    }
+
+    loginf << "DBInterface: createAssociationsTable: sql '" << sql << "'";
+
+    {
+        boost::mutex::scoped_lock locker(connection_mutex_);
+
+        db_connection_->beginBindTransaction();
+
+        try
+        {
+            db_connection_->executeSQL(sql);
+        }
+        catch (...)
+        {
+            db_connection_->executeSQL("ROLLBACK;");
+            throw;
+        }
+
+        db_connection_->endBindTransaction();
+    }
+
+    updateTableInfo();
+}
+
+void DBInterface::saveAssociations(const std::string& dbcontent_name,
+                                   const std::map<unsigned int, unsigned int>& associations)
+{
+    loginf << "DBInterface: saveAssociations: dbcontent " << dbcontent_name << " size "
+           << associations.size();
+
+    assert(db_connection_);
+
+    PropertyList properties;
+    properties.addProperty("dbcontent", PropertyDataType::STRING);
+    properties.addProperty("rec_num", PropertyDataType::UINT);
+    properties.addProperty("utn", PropertyDataType::UINT);
+
+    shared_ptr<Buffer> buffer = make_shared<Buffer>(properties, dbcontent_name);
+
+    NullableVector<string>& dbcontent_vec = buffer->get<string>("dbcontent");
+    NullableVector<unsigned int>& rec_num_vec = buffer->get<unsigned int>("rec_num");
+    NullableVector<unsigned int>& utn_vec = buffer->get<unsigned int>("utn");
+
+    size_t cnt = 0;
+
+    for (auto& assoc_it : associations)
+    {
+        dbcontent_vec.set(cnt, dbcontent_name);
+        rec_num_vec.set(cnt, assoc_it.first);
+        utn_vec.set(cnt, assoc_it.second);
+        ++cnt;
+    }
+
+    boost::mutex::scoped_lock locker(connection_mutex_);
+
+    db_connection_->beginBindTransaction();
+
+    db_connection_->executeSQL(sql_generator_.getDeleteStatement(
+                                   TABLE_NAME_ASSOCIATIONS, "dbcontent='"+dbcontent_name+"'"));
+
+    if (buffer->size())
+        insertBufferColumnar(TABLE_NAME_ASSOCIATIONS, buffer);
+
+    db_connection_->endBindTransaction();
+}
+
 void DBInterface::insertBuffer(DBContent& dbcontent, std::shared_ptr<Buffer> buffer)
 {
     logdbg << "DBInterface: insertBuffer: dbo " << dbcontent.name() << " buffer size "
@@ -1125,15 +1366,82 @@ void DBInterface::insertBuffer(const string& table_name, shared_ptr<Buffer> buff
         }
     }
 
-    string bind_statement = sql_generator_.insertDBUpdateStringBind(buffer, table_name);
-
     boost::mutex::scoped_lock locker(connection_mutex_);
 
-    logdbg << "DBInterface: insertBuffer: preparing bind statement";
-    db_connection_->prepareBindStatement(bind_statement);
+    if (benchmark_insert_)
+        benchmarkInsert(table_name, buffer);
+
     db_connection_->beginBindTransaction();
 
     logdbg << "DBInterface: insertBuffer: starting inserts";
+    insertBufferColumnar(table_name, buffer);
+
+    logdbg << "DBInterface: insertBuffer: ending bind transactions";
+    db_connection_->endBindTransaction();
+}
+
+void DBInterface::insertBufferColumnar(const std::string& table_name, std::shared_ptr<Buffer> buffer)
+{
+    // connection must be locked, transaction begun
+    assert(buffer);
+
+    size_t size = buffer->size();
+    unsigned int num_cols = buffer->properties().size();
+
+    if (!size || !num_cols)
+        return;
+
+    size_t batch_rows = db_connection_->maxBindVariables() / num_cols;
+
+    if (batch_rows > MAX_INSERT_BATCH_ROWS)
+        batch_rows = MAX_INSERT_BATCH_ROWS;
+
+    if (!batch_rows)
+        batch_rows = 1;
+
+    size_t num_batches = size / batch_rows;
+    size_t remaining_rows = size % batch_rows;
+
+    std::deque<std::string> tmp_strings; // keeps json dumps alive until step
+
+    if (num_batches)
+    {
+        db_connection_->prepareBindStatement(
+                    sql_generator_.insertDBUpdateStringBind(buffer, table_name, batch_rows));
+
+        for (size_t batch_cnt = 0; batch_cnt < num_batches; ++batch_cnt)
+        {
+            bindColumns(*buffer, batch_cnt * batch_rows, batch_rows, tmp_strings);
+            db_connection_->stepAndClearBindings();
+            tmp_strings.clear();
+        }
+
+        db_connection_->finalizeBindStatement();
+    }
+
+    if (remaining_rows)
+    {
+        db_connection_->prepareBindStatement(
+                    sql_generator_.insertDBUpdateStringBind(buffer, table_name, remaining_rows));
+
+        bindColumns(*buffer, num_batches * batch_rows, remaining_rows, tmp_strings);
+        db_connection_->stepAndClearBindings();
+        tmp_strings.clear();
+
+        db_connection_->finalizeBindStatement();
+    }
+}
+
+void DBInterface::insertBufferRowWise(const std::string& table_name, std::shared_ptr<Buffer> buffer)
+{
+    // connection must be locked, transaction begun
+    assert(buffer);
+
+    string bind_statement = sql_generator_.insertDBUpdateStringBind(buffer, table_name);
+
+    logdbg << "DBInterface: insertBufferRowWise: preparing bind statement";
+    db_connection_->prepareBindStatement(bind_statement);
+
     size_t size = buffer->size();
 
     for (unsigned int cnt = 0; cnt < size; ++cnt)
@@ -1141,12 +1449,170 @@ void DBInterface::insertBuffer(const string& table_name, shared_ptr<Buffer> buff
         insertBindStatementUpdateForCurrentIndex(buffer, cnt);
     }
 
-    logdbg << "DBInterface: insertBuffer: ending bind transactions";
-    db_connection_->endBindTransaction();
-    logdbg << "DBInterface: insertBuffer: finalizing bind statement";
+    logdbg << "DBInterface: insertBufferRowWise: finalizing bind statement";
     db_connection_->finalizeBindStatement();
 }
 
+void DBInterface::benchmarkInsert(const std::string& table_name, std::shared_ptr<Buffer> buffer)
+{
+    // connection must be locked, inserts into temporary copy of table
+    assert(buffer);
+
+    string tmp_table_name = "temp.benchmark_insert";
+    size_t size = buffer->size();
+
+    db_connection_->executeSQL("DROP TABLE IF EXISTS " + tmp_table_name + ";");
+    db_connection_->executeSQL("CREATE TEMP TABLE benchmark_insert AS SELECT * FROM " + table_name
+                               + " WHERE 0;");
+
+    boost::posix_time::ptime start_time;
+    double row_wise_time, columnar_time;
+
+    start_time = boost::posix_time::microsec_clock::local_time();
+
+    db_connection_->beginBindTransaction();
+    insertBufferRowWise(tmp_table_name, buffer);
+    db_connection_->endBindTransaction();
+
+    row_wise_time = Time::partialSeconds(boost::posix_time::microsec_clock::local_time() - start_time);
+
+    db_connection_->executeSQL("DELETE FROM " + tmp_table_name + ";");
+
+    start_time = boost::posix_time::microsec_clock::local_time();
+
+    db_connection_->beginBindTransaction();
+    insertBufferColumnar(tmp_table_name, buffer);
+    db_connection_->endBindTransaction();
+
+    columnar_time = Time::partialSeconds(boost::posix_time::microsec_clock::local_time() - start_time);
+
+    db_connection_->executeSQL("DROP TABLE " + tmp_table_name + ";");
+
+    loginf << "DBInterface: benchmarkInsert: table " << table_name << " rows " << size
+           << " columns " << buffer->properties().size()
+           << " row-wise " << String::doubleToStringPrecision(row_wise_time, 3) << " s ("
+           << String::doubleToStringPrecision(row_wise_time > 0 ? size / row_wise_time : 0, 0) << " rows/s)"
+           << " columnar " << String::doubleToStringPrecision(columnar_time, 3) << " s ("
+           << String::doubleToStringPrecision(columnar_time > 0 ? size / columnar_time : 0, 0) << " rows/s)";
+}
+
+template <typename T, typename BindT>
+void DBInterface::bindColumn(NullableVector<T>& values, unsigned int col_cnt, unsigned int num_cols,
+                             size_t from_index, size_t num_rows)
+{
+    unsigned int bind_index = col_cnt + 1;
+
+    for (size_t row_cnt = 0; row_cnt < num_rows; ++row_cnt, bind_index += num_cols)
+    {
+        if (values.isNull(from_index + row_cnt))
+            db_connection_->bindVariableNull(bind_index);
+        else
+            db_connection_->bindVariable(bind_index, static_cast<BindT>(values.get(from_index + row_cnt)));
+    }
+}
+
+void DBInterface::bindColumns(Buffer& buffer, size_t from_index, size_t num_rows,
+                              std::deque<std::string>& tmp_strings)
+{
+    const PropertyList& list = buffer.properties();
+    unsigned int num_cols = list.size();
+
+    unsigned int bind_index;
+
+    for (unsigned int col_cnt = 0; col_cnt < num_cols; col_cnt++)
+    {
+        const Property& property = list.at(col_cnt);
+        PropertyDataType data_type = property.dataType();
+
+        switch (data_type)
+        {
+        case PropertyDataType::BOOL:
+            bindColumn<bool, int>(buffer.get<bool>(property.name()), col_cnt, num_cols, from_index, num_rows);
+            break;
+        case PropertyDataType::CHAR:
+            bindColumn<char, int>(buffer.get<char>(property.name()), col_cnt, num_cols, from_index, num_rows);
+            break;
+        case PropertyDataType::UCHAR:
+            bindColumn<unsigned char, int>(buffer.get<unsigned char>(property.name()), col_cnt, num_cols,
+                                           from_index, num_rows);
+            break;
+        case PropertyDataType::INT:
+            bindColumn<int, int>(buffer.get<int>(property.name()), col_cnt, num_cols, from_index, num_rows);
+            break;
+        case PropertyDataType::UINT:
+            bindColumn<unsigned int, int>(buffer.get<unsigned int>(property.name()), col_cnt, num_cols,
+                                          from_index, num_rows);
+            break;
+        case PropertyDataType::LONGINT:
+            bindColumn<long, long>(buffer.get<long>(property.name()), col_cnt, num_cols, from_index, num_rows);
+            break;
+        case PropertyDataType::ULONGINT:
+            bindColumn<unsigned long, long>(buffer.get<unsigned long>(property.name()), col_cnt, num_cols,
+                                            from_index, num_rows);
+            break;
+        case PropertyDataType::FLOAT:
+            bindColumn<float, double>(buffer.get<float>(property.name()), col_cnt, num_cols,
+                                      from_index, num_rows);
+            break;
+        case PropertyDataType::DOUBLE:
+            bindColumn<double, double>(buffer.get<double>(property.name()), col_cnt, num_cols,
+                                       from_index, num_rows);
+            break;
+        case PropertyDataType::STRING:
+        {
+            NullableVector<string>& values = buffer.get<string>(property.name());
+            bind_index = col_cnt + 1;
+
+            for (size_t row_cnt = 0; row_cnt < num_rows; ++row_cnt, bind_index += num_cols)
+            {
+                if (values.isNull(from_index + row_cnt))
+                    db_connection_->bindVariableNull(bind_index);
+                else // no copy, buffer unchanged until stepped
+                    db_connection_->bindVariableStatic(bind_index, values.getRef(from_index + row_cnt));
+            }
+            break;
+        }
+        case PropertyDataType::JSON:
+        {
+            NullableVector<nlohmann::json>& values = buffer.get<nlohmann::json>(property.name());
+            bind_index = col_cnt + 1;
+
+            for (size_t row_cnt = 0; row_cnt < num_rows; ++row_cnt, bind_index += num_cols)
+            {
+                if (values.isNull(from_index + row_cnt))
+                    db_connection_->bindVariableNull(bind_index);
+                else
+                {
+                    tmp_strings.push_back(values.getRef(from_index + row_cnt).dump());
+                    db_connection_->bindVariableStatic(bind_index, tmp_strings.back());
+                }
+            }
+            break;
+        }
+        case PropertyDataType::TIMESTAMP:
+        {
+            NullableVector<boost::posix_time::ptime>& values =
+                    buffer.get<boost::posix_time::ptime>(property.name());
+            bind_index = col_cnt + 1;
+
+            for (size_t row_cnt = 0; row_cnt < num_rows; ++row_cnt, bind_index += num_cols)
+            {
+                if (values.isNull(from_index + row_cnt))
+                    db_connection_->bindVariableNull(bind_index);
+                else
+                    db_connection_->bindVariable(bind_index, Time::toLong(values.get(from_index + row_cnt)));
+            }
+            break;
+        }
+        default:
+            logerr << "DBInterface: bindColumns: unknown property type "
+                   << Property::asString(data_type);
+            throw runtime_error("DBInterface: bindColumns: unknown property type " +
+                                Property::asString(data_type));
+        }
+    }
+}
+
 void DBInterface::updateBuffer(const std::string& table_name, const std::string& key_col,
                                shared_ptr<Buffer> buffer, int from_index, int to_index)
 {
@@ -1204,21 +1670,38 @@ void DBInterface::prepareRead(
 
     assert(dbobject.existsInDB());
 
-    connection_mutex_.lock();
-
     shared_ptr<DBCommand> read = sql_generator_.getSelectCommand(
                 dbobject, read_list, custom_filter_clause, use_order, order_variable);
 
     logdbg << "DBInterface: prepareRead: dbo " << dbobject.name() << " sql '" << read->get() << "'";
+
+    if (db_connection_->parallelReadPossible()) // own read-only connection, no lock required
+    {
+        shared_ptr<SQLiteReader> reader = db_connection_->acquireReader();
+        reader->prepareCommand(read);
+
+        boost::mutex::scoped_lock locker(readers_mutex_);
+
+        assert (!readers_.count(dbobject.name()));
+        readers_[dbobject.name()] = reader;
+
+        return;
+    }
+
+    connection_mutex_.lock();
+
     db_connection_->prepareCommand(read);
 }
 
 shared_ptr<Buffer> DBInterface::readDataChunk(const DBContent& dbobject)
 {
-    // locked by prepareRead
+    // locked by prepareRead if not using reader
     assert(db_connection_);
 
-    shared_ptr<DBResult> result = db_connection_->stepPreparedCommand(read_chunk_size_);
+    shared_ptr<SQLiteReader> reader = activeReader(dbobject.name());
+
+    shared_ptr<DBResult> result = reader ? reader->stepPreparedCommand(read_chunk_size_)
+                                         : db_connection_->stepPreparedCommand(read_chunk_size_);
 
     if (!result)
     {
@@ -1238,7 +1721,7 @@ shared_ptr<Buffer> DBInterface::readDataChunk(const DBContent& dbobject)
 
     assert(buffer);
 
-    bool last_one = db_connection_->getPreparedCommandDone();
+    bool last_one = reader ? reader->getPreparedCommandDone() : db_connection_->getPreparedCommandDone();
     buffer->lastOne(last_one);
 
     return buffer;
@@ -1246,23 +1729,56 @@ shared_ptr<Buffer> DBInterface::readDataChunk(const DBContent& dbobject)
 
 void DBInterface::finalizeReadStatement(const DBContent& dbobject)
 {
-    connection_mutex_.unlock();
     assert(db_connection_);
 
-    logdbg << "DBInterface: finishReadSystemTracks: start ";
+    shared_ptr<SQLiteReader> reader = activeReader(dbobject.name());
+
+    if (reader)
+    {
+        logdbg << "DBInterface: finalizeReadStatement: dbo " << dbobject.name() << " reader";
+
+        reader->finalizeCommand();
+
+        {
+            boost::mutex::scoped_lock locker(readers_mutex_);
+            readers_.erase(dbobject.name());
+        }
+
+        db_connection_->releaseReader(reader);
+
+        return;
+    }
+
+    connection_mutex_.unlock();
+
+    logdbg << "DBInterface: finalizeReadStatement: dbo " << dbobject.name();
     db_connection_->finalizeCommand();
 }
 
+shared_ptr<SQLiteReader> DBInterface::activeReader(const std::string& dbcontent_name)
+{
+    boost::mutex::scoped_lock locker(readers_mutex_);
+
+    if (readers_.count(dbcontent_name))
+        return readers_.at(dbcontent_name);
+    else
+        return nullptr;
+}
+
 void DBInterface::deleteBefore(const DBContent& dbcontent, boost::posix_time::ptime before_timestamp)
 {
-    connection_mutex_.lock();
+    boost::mutex::scoped_lock locker(connection_mutex_);
     assert(db_connection_);
 
     std::shared_ptr<DBCommand> command = sql_generator_.getDeleteCommand(dbcontent, before_timestamp);
 
+    // associations of the deleted rows in the same transaction
+    db_connection_->beginBindTransaction();
+
+    db_connection_->executeSQL(sql_generator_.getDeleteAssociationsStatement(dbcontent, before_timestamp));
     db_connection_->execute(*command.get());
 
-    connection_mutex_.unlock();
+    db_connection_->endBindTransaction();
 }
 
 void DBInterface::createPropertiesTable()
@@ -27,6 +27,7 @@
 
 #include <boost/thread/mutex.hpp>
 
+#include <deque>
 #include <memory>
 #include <set>
 
@@ -34,11 +35,15 @@ static const std::string TABLE_NAME_PROPERTIES = "properties";
 static const std::string TABLE_NAME_SECTORS = "sectors";
 static const std::string TABLE_NAME_VIEWPOINTS = "viewpoints";
 static const std::string TABLE_NAME_TARGETS = "targets";
+static const std::string TABLE_NAME_ASSOCIATIONS = "associations";
 
 class COMPASS;
 class Buffer;
 class BufferWriter;
 class SQLiteConnection;
+class SQLiteReader;
+template <class T>
+class NullableVector;
 class QProgressDialog;
 class DBContent;
 class DBResult;
@@ -91,6 +96,16 @@ public:
     bool ready();
 
     SQLiteConnection& connection();
+    SQLGenerator& sqlGenerator() { return sql_generator_; }
+
+    std::vector<std::string> storageProfileNames();
+    std::string storageProfile();
+    void storageProfile(const std::string& name);
+    // bulk import or live profile during an import, configured profile restored afterwards
+    void useImportStorageProfile(bool live);
+    void useConfiguredStorageProfile();
+    // runs insert, load and filter workloads under each storage profile, logs durations
+    void benchmarkStorageProfiles(unsigned int num_rows = 500000);
 
     bool existsDataSourcesTable();
     void createDataSourcesTable();
@@ -105,6 +120,7 @@ public:
     void updateBuffer(const std::string& table_name, const std::string& key_col, std::shared_ptr<Buffer> buffer,
                       int from_index = -1, int to_index = -1);  // no indexes means full buffer
 
+    // uses read-only connection from pool if possible, otherwise locks connection until finalized
     void prepareRead(const DBContent& dbcontent, dbContent::VariableSet read_list,
                      std::string custom_filter_clause,
                      bool use_order = false, dbContent::Variable* order_variable = nullptr);
@@ -149,6 +165,13 @@ public:
     std::map<unsigned int, std::shared_ptr<dbContent::Target>> loadTargets();
     void saveTargets(std::map<unsigned int, std::shared_ptr<dbContent::Target>> targets);
 
+    bool existsAssociationsTable();
+    // if migrate, associations of previous versions are moved from the data tables in the same transaction
+    void createAssociationsTable(bool migrate=false);
+    // replaces all previous associations of the dbcontent in one transaction
+    void saveAssociations(const std::string& dbcontent_name,
+                          const std::map<unsigned int, unsigned int>& associations); // rec_num -> utn
+
     void clearTableContent(const std::string& table_name);
 
     unsigned int getMaxRecordNumber(DBContent& object);
@@ -166,7 +189,16 @@ protected:
     boost::mutex connection_mutex_;
     boost::mutex table_info_mutex_;
 
+    boost::mutex readers_mutex_;
+    std::map<std::string, std::shared_ptr<SQLiteReader>> readers_; // dbcontent name -> active reader
+
     unsigned int read_chunk_size_;
+    // also inserts each buffer row-wise and columnar into temporary table, logs rows/s
+    bool benchmark_insert_ {false};
+    // runs storage profile benchmark after opening a database
+    bool benchmark_storage_profiles_ {false};
+
+    static const size_t MAX_INSERT_BATCH_ROWS {500};
 
     SQLGenerator sql_generator_;
 
@@ -176,8 +208,23 @@ protected:
 
     virtual void checkSubConfigurables();
 
+    std::shared_ptr<SQLiteReader> activeReader(const std::string& dbcontent_name); // nullptr if none
+
     void insertBindStatementUpdateForCurrentIndex(std::shared_ptr<Buffer> buffer, unsigned int buffer_index);
 
+    // connection must be locked and transaction begun for the following
+
+    // multi-row insert statements, binding column by column
+    void insertBufferColumnar(const std::string& table_name, std::shared_ptr<Buffer> buffer);
+    // single-row insert statement, binding row by row
+    void insertBufferRowWise(const std::string& table_name, std::shared_ptr<Buffer> buffer);
+    void benchmarkInsert(const std::string& table_name, std::shared_ptr<Buffer> buffer);
+
+    void bindColumns(Buffer& buffer, size_t from_index, size_t num_rows, std::deque<std::string>& tmp_strings);
+    template <typename T, typename BindT>
+    void bindColumn(NullableVector<T>& values, unsigned int col_cnt, unsigned int num_cols,
+                    size_t from_index, size_t num_rows);
+
     void loadProperties();
 
     void updateTableInfo();
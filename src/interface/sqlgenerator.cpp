@@ -86,6 +86,16 @@ SQLGenerator::SQLGenerator(DBInterface& db_interface) : db_interface_(db_interfa
        << "(utn INT, json TEXT, PRIMARY KEY (utn));";
     table_targets_create_statement_ = ss.str();
     ss.str(string());
+
+    // covering indexes for utn filtering and per-row lookup
+    ss << "CREATE TABLE " << TABLE_NAME_ASSOCIATIONS
+       << "(dbcontent VARCHAR(255), rec_num INT, utn INT);"
+       << "CREATE INDEX " << TABLE_NAME_ASSOCIATIONS << "_utn_idx ON " << TABLE_NAME_ASSOCIATIONS
+       << "(utn, dbcontent, rec_num);"
+       << "CREATE INDEX " << TABLE_NAME_ASSOCIATIONS << "_rec_num_idx ON " << TABLE_NAME_ASSOCIATIONS
+       << "(dbcontent, rec_num, utn);";
+    table_associations_create_statement_ = ss.str();
+    ss.str(string());
 }
 
 SQLGenerator::~SQLGenerator() {}
@@ -222,6 +232,27 @@ std::shared_ptr<DBCommand> SQLGenerator::getDeleteCommand(
     return command;
 }
 
+string SQLGenerator::getDeleteAssociationsStatement(const DBContent& dbcontent,
+                                                   boost::posix_time::ptime before_timestamp)
+{
+    DBContentManager& dbcont_man = COMPASS::instance().dbContentManager();
+
+    string rec_num_col_name =
+            dbcont_man.metaGetVariable(dbcontent.name(), DBContent::meta_var_rec_num_).dbColumnName();
+    string ts_col_name =
+            dbcont_man.metaGetVariable(dbcontent.name(), DBContent::meta_var_timestamp_).dbColumnName();
+
+    stringstream ss;
+
+    ss << "DELETE FROM " << TABLE_NAME_ASSOCIATIONS << " WHERE dbcontent = '" << dbcontent.name()
+       << "' AND rec_num IN (SELECT " << rec_num_col_name << " FROM " << dbcontent.dbTableName()
+       << " WHERE " << ts_col_name << " < " << Time::toLong(before_timestamp) << ");";
+
+    logdbg << "SQLGenerator: getDeleteAssociationsStatement: sql '" << ss.str() << "'";
+
+    return ss.str();
+}
+
 //shared_ptr<DBCommand> SQLGenerator::getDistinctDataSourcesSelectCommand(DBContent& object)
 //{
 //    // "SELECT DISTINCT sensor_number__value FROM " << table_names_.at(DBO_PLOTS) << " WHERE
@@ -519,15 +550,21 @@ std::string SQLGenerator::getTableTargetsCreateStatement()
     return table_targets_create_statement_;
 }
 
+std::string SQLGenerator::getTableAssociationsCreateStatement()
+{
+    return table_associations_create_statement_;
+}
+
 string SQLGenerator::insertDBUpdateStringBind(shared_ptr<Buffer> buffer,
-                                              string tablename)
+                                              string tablename, unsigned int num_rows)
 {
     assert(buffer);
     assert(tablename.size() > 0);
+    assert(num_rows > 0);
 
     const vector<Property>& properties = buffer->properties().properties();
 
-    // INSERT INTO table_name (column1, column2, column3, ...) VALUES (value1, value2, value3, ...);
+    // INSERT INTO table_name (column1, column2, column3, ...) VALUES (value1, value2, value3, ...), (...);
 
     unsigned int size = properties.size();
     logdbg << "SQLGenerator: insertDBUpdateStringBind: creating db string";
@@ -535,23 +572,35 @@ string SQLGenerator::insertDBUpdateStringBind(shared_ptr<Buffer> buffer,
 
     ss << "INSERT INTO " << tablename << " (";
 
-    stringstream values_ss;
-    values_ss << "VALUES (";
-
     for (unsigned int cnt = 0; cnt < size; cnt++)
     {
         ss << properties.at(cnt).name();
 
-        values_ss << "@VAR" + to_string(cnt + 1);
-
         if (cnt != size - 1)
-        {
             ss << ", ";
-            values_ss << ", ";
+    }
+
+    ss << ") VALUES ";
+
+    for (unsigned int row_cnt = 0; row_cnt < num_rows; row_cnt++)
+    {
+        if (row_cnt)
+            ss << ", ";
+
+        ss << "(";
+
+        for (unsigned int cnt = 0; cnt < size; cnt++)
+        {
+            ss << "@VAR" + to_string(row_cnt * size + cnt + 1);
+
+            if (cnt != size - 1)
+                ss << ", ";
         }
+
+        ss << ")";
     }
 
-    ss << ") " << values_ss.str() << ");";
+    ss << ";";
 
     logdbg << "SQLGenerator: insertDBUpdateStringBind: var insert string '" << ss.str() << "'";
 
@@ -642,6 +691,19 @@ shared_ptr<DBCommand> SQLGenerator::getSelectCommand(
     string column_name;
     string table_db_name = object.dbTableName();
 
+    DBContentManager& dbcont_man = COMPASS::instance().dbContentManager();
+
+    string assoc_col_name;
+    string rec_num_col_name;
+
+    if (dbcont_man.metaCanGetVariable(object.name(), DBContent::meta_var_associations_))
+    {
+        assert (dbcont_man.metaCanGetVariable(object.name(), DBContent::meta_var_rec_num_));
+
+        assoc_col_name = dbcont_man.metaGetVariable(object.name(), DBContent::meta_var_associations_).dbColumnName();
+        rec_num_col_name = dbcont_man.metaGetVariable(object.name(), DBContent::meta_var_rec_num_).dbColumnName();
+    }
+
     bool first = true;
     for (auto var_it : read_list.getSet())
         // look what tables are needed for loaded variables and add variables to sql query
@@ -653,7 +715,10 @@ shared_ptr<DBCommand> SQLGenerator::getSelectCommand(
 
         column_name = variable->dbColumnName();
 
-        ss << table_db_name << "." << column_name;
+        if (column_name == assoc_col_name) // from associations table
+            ss << getSelectAssociationsExpression(object, rec_num_col_name) << " AS " << column_name;
+        else
+            ss << table_db_name << "." << column_name;
 
         property_list.addProperty(column_name, variable->dataType());
 
@@ -662,10 +727,6 @@ shared_ptr<DBCommand> SQLGenerator::getSelectCommand(
 
     ss << " FROM " << table_db_name;  // << table->getAllTableNames();
 
-    // check associations json_each
-    if (filter.find("json_each.value") != std::string::npos)
-        ss << ", json_each("+object.dbTableName()+".associations)";
-
     // add extra from parts
 //    for (auto& from_part : extra_from_parts)
 //        ss << ", " << from_part;
@@ -818,6 +879,38 @@ shared_ptr<DBCommand> SQLGenerator::getSelectCommand(
 //    return ss.str();
 //}
 
+string SQLGenerator::getSelectAssociationsExpression(const DBContent& object, const string& rec_num_col_name)
+{
+    // indexed lookup by (dbcontent, rec_num), json_group_array gives '[]' if none
+    return "NULLIF((SELECT json_group_array(" + TABLE_NAME_ASSOCIATIONS + ".utn) FROM "
+            + TABLE_NAME_ASSOCIATIONS + " WHERE " + TABLE_NAME_ASSOCIATIONS + ".dbcontent = '"
+            + object.name() + "' AND " + TABLE_NAME_ASSOCIATIONS + ".rec_num = "
+            + object.dbTableName() + "." + rec_num_col_name + "), '[]')";
+}
+
+string SQLGenerator::getAssociationsCondition(const DBContent& object, const string& rec_num_col_name,
+                                              const string& utns)
+{
+    // indexed lookup by (utn, dbcontent)
+    return object.dbTableName() + "." + rec_num_col_name + " IN (SELECT " + TABLE_NAME_ASSOCIATIONS
+            + ".rec_num FROM " + TABLE_NAME_ASSOCIATIONS + " WHERE " + TABLE_NAME_ASSOCIATIONS
+            + ".dbcontent = '" + object.name() + "' AND " + TABLE_NAME_ASSOCIATIONS + ".utn IN ("
+            + utns + "))";
+}
+
+string SQLGenerator::getMigrateAssociationsStatement(const string& dbcontent_name, const string& table_name,
+                                                    const string& rec_num_col_name, const string& assoc_col_name)
+{
+    stringstream ss;
+
+    ss << "INSERT INTO " << TABLE_NAME_ASSOCIATIONS << " (dbcontent, rec_num, utn) SELECT '"
+       << dbcontent_name << "', " << table_name << "." << rec_num_col_name << ", assoc.value FROM "
+       << table_name << ", json_each(CASE WHEN json_valid(" << table_name << "." << assoc_col_name
+       << ") THEN " << table_name << "." << assoc_col_name << " ELSE '[]' END) AS assoc;"; // null gives no rows
+
+    return ss.str();
+}
+
 string SQLGenerator::getDeleteStatement (const string& table, const string& filter)
 {
     // DELETE FROM table_name [WHERE Clause]
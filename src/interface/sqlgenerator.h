@@ -37,7 +37,9 @@ public:
     virtual ~SQLGenerator();
 
     std::string getCreateTableStatement(const DBContent& object);
-    std::string insertDBUpdateStringBind(std::shared_ptr<Buffer> buffer, std::string table_name);
+    std::string insertDBUpdateStringBind(std::shared_ptr<Buffer> buffer, std::string table_name,
+                                         unsigned int num_rows = 1);
+    // multi-row insert, variable index of row r, column c is r*num_columns+c+1
     std::string createDBUpdateStringBind(std::shared_ptr<Buffer> buffer,
                                          const std::string& key_col_name, std::string table_name);
 
@@ -48,6 +50,9 @@ public:
     std::shared_ptr<DBCommand> getDataSourcesSelectCommand();
 
     std::shared_ptr<DBCommand> getDeleteCommand(const DBContent& dbcontent, boost::posix_time::ptime before_timestamp);
+    // deletes associations of rows deleted by getDeleteCommand, must be executed before it
+    std::string getDeleteAssociationsStatement(const DBContent& dbcontent,
+                                               boost::posix_time::ptime before_timestamp);
 
     //std::shared_ptr<DBCommand> getDistinctDataSourcesSelectCommand(DBContent& object);
     std::shared_ptr<DBCommand> getMaxUIntValueCommand(const std::string& table_name,
@@ -65,6 +70,11 @@ public:
     std::string getTableSectorsCreateStatement();
     std::string getTableViewPointsCreateStatement();
     std::string getTableTargetsCreateStatement();
+    std::string getTableAssociationsCreateStatement();
+    // inserts associations from json array column of previous versions into associations table
+    std::string getMigrateAssociationsStatement(const std::string& dbcontent_name, const std::string& table_name,
+                                                const std::string& rec_num_col_name,
+                                                const std::string& assoc_col_name);
     std::string getDeleteStatement (const std::string& table, const std::string& filter);
 
     std::string getInsertTargetStatement(unsigned int utn, const std::string& info);
@@ -90,6 +100,12 @@ public:
     std::string getSelectAllSectorsStatement();
     std::string getSelectAllTargetsStatement();
 
+    // select expression of the utns of each row as json array, null if not associated
+    std::string getSelectAssociationsExpression(const DBContent& object, const std::string& rec_num_col_name);
+    // condition for rows associated to any of the utns (comma separated)
+    std::string getAssociationsCondition(const DBContent& object, const std::string& rec_num_col_name,
+                                         const std::string& utns);
+
     std::shared_ptr<DBCommand> getTableSelectMinMaxNormalStatement(const DBContent& object);
 
 protected:
@@ -101,6 +117,7 @@ protected:
     std::string table_sectors_create_statement_;
     std::string table_view_points_create_statement_;
     std::string table_targets_create_statement_;
+    std::string table_associations_create_statement_;
 
     //    std::string subTablesWhereClause(const DBTable& table,
     //                                     const std::vector<std::string>& used_tables);
@@ -16,6 +16,7 @@
  */
 
 #include "sqliteconnection.h"
+#include "sqlitereader.h"
 #include "buffer.h"
 #include "dbcommand.h"
 #include "dbcommandlist.h"
@@ -31,7 +32,10 @@
 
 #include <QApplication>
 
+#include <boost/algorithm/string.hpp>
+
 #include <cstring>
+#include <functional>
 
 using namespace std;
 using namespace Utils;
@@ -40,6 +44,17 @@ SQLiteConnection::SQLiteConnection(const std::string& class_id, const std::strin
                                    DBInterface* interface)
     : Configurable(class_id, instance_id, interface), interface_(*interface), db_opened_(false)
 {
+    registerParameter("storage_profiles", &storage_profiles_, defaultStorageProfiles());
+    registerParameter("storage_profile", &storage_profile_, "interactive analysis");
+    registerParameter("import_storage_profile", &import_storage_profile_, "bulk import");
+    registerParameter("live_storage_profile", &live_storage_profile_, "live");
+
+    for (auto& profile_it : defaultStorageProfiles().items()) // add if missing in older configs
+    {
+        if (!storage_profiles_.contains(profile_it.key()))
+            storage_profiles_[profile_it.key()] = profile_it.value();
+    }
+
     createSubConfigurables();
 
     loginf << "SQLiteConnection: constructor: SQLITE_VERSION " << SQLITE_VERSION;
@@ -71,17 +86,16 @@ void SQLiteConnection::openFile(const std::string& file_name)
         throw std::runtime_error("SQLiteConnection: openFile: error");
     }
 
-    char* sErrMsg = 0;
-    sqlite3_exec(db_handle_, "PRAGMA SYNCHRONOUS = OFF", NULL, NULL, &sErrMsg);
-    sqlite3_exec(db_handle_, "PRAGMA TEMP_STORE = 2", NULL, NULL, &sErrMsg);
-    sqlite3_exec(db_handle_, "PRAGMA JOURNAL_MODE = OFF", NULL, NULL, &sErrMsg);
-    sqlite3_exec(db_handle_, "PRAGMA LOCKING_MODE = EXCLUSIVE", NULL, NULL, &sErrMsg);
-    sqlite3_exec(db_handle_, "PRAGMA CACHE_SIZE = 500", NULL, NULL, &sErrMsg);
-
-    //sqlite3_exec(db_handle_, "PRAGMA locking_mode = EXCLUSIVE", NULL, NULL, &sErrMsg);
+    // wait on the shared locks of the parallel readers instead of failing writes with SQLITE_BUSY,
+    // readers can hold them for a whole load
+    sqlite3_busy_timeout(db_handle_, 60000);
 
+    file_name_ = file_name;
     db_opened_ = true;
 
+    active_storage_profile_ = storage_profile_;
+    applyStorageProfile();
+
     QApplication::restoreOverrideCursor();
 }
 
@@ -105,6 +119,15 @@ void SQLiteConnection::disconnect()
 
     db_opened_ = false;
 
+    {
+        boost::mutex::scoped_lock locker(readers_mutex_);
+
+        if (num_acquired_readers_)
+            logerr << "SQLiteConnection: disconnect: " << num_acquired_readers_ << " readers still in use";
+
+        idle_readers_.clear();
+    }
+
     if (db_handle_)
     {
         sqlite3_close(db_handle_);
@@ -201,6 +224,12 @@ void SQLiteConnection::bindVariable(unsigned int index, const std::string& value
     sqlite3_bind_text(statement_, index, value.c_str(), -1, SQLITE_TRANSIENT);
 }
 
+void SQLiteConnection::bindVariableStatic(unsigned int index, const std::string& value)
+{
+    logdbg << "SQLiteConnection: bindVariableStatic: index " << index << " value '" << value << "'";
+    sqlite3_bind_text(statement_, index, value.c_str(), value.size(), SQLITE_STATIC);
+}
+
 void SQLiteConnection::bindVariable(unsigned int index, long value)
 {
     logdbg << "SQLiteConnection: bindVariable: index " << index << " value '" << value << "'";
@@ -212,6 +241,12 @@ void SQLiteConnection::bindVariableNull(unsigned int index)
     sqlite3_bind_null(statement_, index);
 }
 
+unsigned int SQLiteConnection::maxBindVariables()
+{
+    assert (db_handle_);
+    return sqlite3_limit(db_handle_, SQLITE_LIMIT_VARIABLE_NUMBER, -1);
+}
+
 std::shared_ptr<DBResult> SQLiteConnection::execute(const DBCommand& command)
 {
     std::shared_ptr<DBResult> dbresult(new DBResult());
@@ -283,38 +318,79 @@ void SQLiteConnection::execute(const std::string& command, std::shared_ptr<Buffe
     logdbg << "SQLiteConnection: execute";
 
     assert(buffer);
-    unsigned int num_properties = 0;
 
-    const PropertyList& list = buffer->properties();
-    num_properties = list.size();
+    prepareStatement(command.c_str());
 
-    unsigned int cnt = buffer->size();
+    readRows(db_handle_, statement_, *buffer, 0); // appends all result lines
 
-    int result;
+    finalizeStatement();
+}
 
-    prepareStatement(command.c_str());
+namespace
+{
 
-    // Now step throught the result lines
-    for (result = sqlite3_step(statement_); result == SQLITE_ROW; result = sqlite3_step(statement_))
-    {
-        readRowIntoBuffer(list, num_properties, buffer, cnt);
-        cnt++;
-    }
+/**
+ * Typed reading of one result column into its NullableVector, resolved once per statement.
+ */
+struct ColumnFill
+{
+    std::function<void(unsigned int)> prepare_; // size
+    std::function<void(unsigned int)> read_; // index, current row of statement
+    std::function<void(unsigned int)> finish_; // size
+};
 
-    if (result != SQLITE_DONE)
+template <typename T, typename ReadFunc>
+ColumnFill columnFill(sqlite3_stmt* statement, int column, NullableVector<T>& values, ReadFunc read_value)
+{
+    ColumnFill fill;
+
+    fill.prepare_ = [&values] (unsigned int size) { values.prepareFill(size); };
+    fill.read_ = [statement, column, &values, read_value] (unsigned int index)
     {
-        logerr << "SQLiteConnection: execute: problem while stepping the result: " << result << " "
-               << sqlite3_errmsg(db_handle_);
-        throw std::runtime_error("SQLiteConnection: execute: problem while stepping the result");
-    }
+        if (sqlite3_column_type(statement, column) != SQLITE_NULL) // otherwise stays null
+            read_value(statement, column, values, index);
+    };
+    fill.finish_ = [&values] (unsigned int size) { values.finishFill(size); };
+
+    return fill;
+}
+
+template <typename T>
+ColumnFill intColumnFill(sqlite3_stmt* statement, int column, NullableVector<T>& values)
+{
+    return columnFill(statement, column, values,
+                      [] (sqlite3_stmt* stmt, int col, NullableVector<T>& vec, unsigned int index)
+    { vec.fill(index, static_cast<T>(sqlite3_column_int(stmt, col))); });
+}
+
+template <typename T>
+ColumnFill int64ColumnFill(sqlite3_stmt* statement, int column, NullableVector<T>& values)
+{
+    return columnFill(statement, column, values,
+                      [] (sqlite3_stmt* stmt, int col, NullableVector<T>& vec, unsigned int index)
+    { vec.fill(index, static_cast<T>(sqlite3_column_int64(stmt, col))); });
+}
+
+template <typename T>
+ColumnFill doubleColumnFill(sqlite3_stmt* statement, int column, NullableVector<T>& values)
+{
+    return columnFill(statement, column, values,
+                      [] (sqlite3_stmt* stmt, int col, NullableVector<T>& vec, unsigned int index)
+    { vec.fill(index, static_cast<T>(sqlite3_column_double(stmt, col))); });
+}
 
-    finalizeStatement();
 }
 
-void SQLiteConnection::readRowIntoBuffer(const PropertyList& list, unsigned int num_properties,
-                                         std::shared_ptr<Buffer> buffer, unsigned int index)
+unsigned int SQLiteConnection::readRows(sqlite3* db_handle, sqlite3_stmt* statement, Buffer& buffer,
+                                        unsigned int max_rows, bool* done)
 {
-    logdbg << "SQLiteConnection: readRowIntoBuffer: num_properties " << num_properties;
+    const PropertyList& list = buffer.properties();
+    unsigned int num_properties = list.size();
+
+    logdbg << "SQLiteConnection: readRows: num_properties " << num_properties << " max_rows " << max_rows;
+
+    std::vector<ColumnFill> columns;
+    columns.reserve(num_properties);
 
     for (unsigned int cnt = 0; cnt < num_properties; cnt++)
     {
@@ -323,187 +399,114 @@ void SQLiteConnection::readRowIntoBuffer(const PropertyList& list, unsigned int
         switch (prop.dataType())
         {
             case PropertyDataType::BOOL:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: bool index " << index
-                           << " property '" << prop.name()
-                           << "' value " << static_cast<bool>(sqlite3_column_int(statement_, cnt));
-
-                    buffer->get<bool>(prop.name())
-                            .set(index, static_cast<bool>(sqlite3_column_int(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: bool index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(intColumnFill(statement, cnt, buffer.get<bool>(prop.name())));
                 break;
             case PropertyDataType::UCHAR:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned char index " << index
-                           << " property '" << prop.name()
-                           << "' value " << (int) static_cast<unsigned char>(sqlite3_column_int(statement_, cnt));
-
-                    buffer->get<unsigned char>(prop.name())
-                            .set(index,
-                                 static_cast<unsigned char>(sqlite3_column_int(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned char index " << index
-                           << " property '" << prop.name() << " is null";
-
+                columns.push_back(intColumnFill(statement, cnt, buffer.get<unsigned char>(prop.name())));
                 break;
             case PropertyDataType::CHAR:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: char index " << index
-                           << " property '" << prop.name()
-                           << "' value " << (int)static_cast<char>(sqlite3_column_int(statement_, cnt));
-
-                    buffer->get<char>(prop.name())
-                            .set(index, static_cast<char>(sqlite3_column_int(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: char index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(intColumnFill(statement, cnt, buffer.get<char>(prop.name())));
                 break;
             case PropertyDataType::INT:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: int index " << index
-                           << " property '" << prop.name()
-                           << "' value " << static_cast<int>(sqlite3_column_int(statement_, cnt));
-
-                    buffer->get<int>(prop.name())
-                            .set(index, static_cast<int>(sqlite3_column_int(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: int index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(intColumnFill(statement, cnt, buffer.get<int>(prop.name())));
                 break;
             case PropertyDataType::UINT:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned int index " << index
-                           << " property '" << prop.name()
-                           << "' value " << static_cast<unsigned int>(sqlite3_column_int(statement_, cnt));
-
-                    buffer->get<unsigned int>(prop.name())
-                            .set(index, static_cast<unsigned int>(sqlite3_column_int(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned int index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(intColumnFill(statement, cnt, buffer.get<unsigned int>(prop.name())));
                 break;
             case PropertyDataType::LONGINT:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: int index " << index
-                           << " property '" << prop.name()
-                           << "' value " << sqlite3_column_int64(statement_, cnt);
-
-                    buffer->get<long>(prop.name())
-                            .set(index, sqlite3_column_int64(statement_, cnt));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: int index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(int64ColumnFill(statement, cnt, buffer.get<long>(prop.name())));
                 break;
             case PropertyDataType::ULONGINT:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned int index " << index
-                           << " property '" << prop.name()
-                           << "' value " << static_cast<unsigned long>(sqlite3_column_int64(statement_, cnt));
-
-                    buffer->get<unsigned long>(prop.name())
-                            .set(index, static_cast<unsigned long>(sqlite3_column_int64(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned int index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(int64ColumnFill(statement, cnt, buffer.get<unsigned long>(prop.name())));
                 break;
             case PropertyDataType::FLOAT:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: float index " << index
-                           << " property '" << prop.name()
-                           << "' value " << static_cast<float>(sqlite3_column_double(statement_, cnt));
-
-                    buffer->get<float>(prop.name())
-                            .set(index, static_cast<float>(sqlite3_column_double(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: float index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(doubleColumnFill(statement, cnt, buffer.get<float>(prop.name())));
                 break;
             case PropertyDataType::DOUBLE:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
-                {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: double index " << index
-                           << " property '" << prop.name()
-                           << "' value " << static_cast<double>(sqlite3_column_double(statement_, cnt));
-
-                    buffer->get<double>(prop.name())
-                            .set(index, static_cast<double>(sqlite3_column_double(statement_, cnt)));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: double index " << index
-                           << " property '" << prop.name() << " is null";
+                columns.push_back(doubleColumnFill(statement, cnt, buffer.get<double>(prop.name())));
                 break;
             case PropertyDataType::STRING:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
+                columns.push_back(columnFill(statement, cnt, buffer.get<std::string>(prop.name()),
+                                             [] (sqlite3_stmt* stmt, int col, NullableVector<std::string>& vec,
+                                                 unsigned int index)
                 {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: string index " << index
-                           << " property '" << prop.name()
-                           << "' value "
-                           << std::string(reinterpret_cast<const char*>(sqlite3_column_text(statement_, cnt)));
-
-                    buffer->get<std::string>(prop.name())
-                            .set(index, std::string(reinterpret_cast<const char*>(
-                                                        sqlite3_column_text(statement_, cnt))));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: string index " << index
-                           << " property '" << prop.name() << " is null";
+                    // text first, then bytes of text
+                    const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+                    vec.fillRef(index).assign(text, sqlite3_column_bytes(stmt, col));
+                }));
                 break;
             case PropertyDataType::JSON:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
+                columns.push_back(columnFill(statement, cnt, buffer.get<nlohmann::json>(prop.name()),
+                                             [] (sqlite3_stmt* stmt, int col, NullableVector<nlohmann::json>& vec,
+                                                 unsigned int index)
                 {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: json index " << index
-                           << " property '" << prop.name()
-                           << "' value "
-                           << std::string(reinterpret_cast<const char*>(sqlite3_column_text(statement_, cnt)));
-
-                    buffer->get<nlohmann::json>(prop.name())
-                            .set(index, nlohmann::json::parse(std::string(reinterpret_cast<const char*>(
-                                                        sqlite3_column_text(statement_, cnt)))));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: string index " << index
-                           << " property '" << prop.name() << " is null";
+                    const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+                    vec.fillRef(index) = nlohmann::json::parse(text, text + sqlite3_column_bytes(stmt, col));
+                }));
                 break;
             case PropertyDataType::TIMESTAMP:
-                if (sqlite3_column_type(statement_, cnt) != SQLITE_NULL)
+                columns.push_back(columnFill(statement, cnt, buffer.get<boost::posix_time::ptime>(prop.name()),
+                                             [] (sqlite3_stmt* stmt, int col,
+                                                 NullableVector<boost::posix_time::ptime>& vec, unsigned int index)
                 {
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned int index " << index
-                           << " property '" << prop.name()
-                           << "' value " << Time::toStringLong(
-                                  static_cast<unsigned long>(sqlite3_column_int64(statement_, cnt)));
-
-                    buffer->get<boost::posix_time::ptime>(prop.name())
-                            .set(index, Time::fromLong(static_cast<unsigned long>(sqlite3_column_int64(statement_, cnt))));
-                }
-                else
-                    logdbg << "SQLiteConnection: readRowIntoBuffer: unsigned int index " << index
-                           << " property '" << prop.name() << " is null";
+                    vec.fill(index, Time::fromLong(static_cast<unsigned long>(sqlite3_column_int64(stmt, col))));
+                }));
                 break;
             default:
-                logerr << "MySQLppConnection: readRowIntoBuffer: unknown property type";
-                throw std::runtime_error(
-                            "MySQLppConnection: readRowIntoBuffer: unknown property type");
+                logerr << "SQLiteConnection: readRows: unknown property type";
+                throw std::runtime_error("SQLiteConnection: readRows: unknown property type");
                 break;
         }
     }
+
+    unsigned int index = buffer.size(); // append
+    unsigned int capacity = index;
+
+    if (max_rows)
+        capacity += max_rows;
+    else
+        capacity += READ_BLOCK_SIZE;
+
+    for (auto& column : columns)
+        column.prepare_(capacity);
+
+    unsigned int num_rows = 0;
+    int result = SQLITE_ROW;
+
+    // Now step throught the result lines
+    while ((!max_rows || num_rows < max_rows) && (result = sqlite3_step(statement)) == SQLITE_ROW)
+    {
+        if (index == capacity) // only if no max_rows
+        {
+            capacity *= 2;
+
+            for (auto& column : columns)
+                column.prepare_(capacity);
+        }
+
+        for (auto& column : columns)
+            column.read_(index);
+
+        ++index;
+        ++num_rows;
+    }
+
+    for (auto& column : columns)
+        column.finish_(index);
+
+    buffer.cutToSize(index);
+
+    if (result != SQLITE_ROW && result != SQLITE_DONE)
+    {
+        logerr << "SQLiteConnection: readRows: problem while stepping the result: "
+               << result << " " << sqlite3_errmsg(db_handle);
+        throw std::runtime_error("SQLiteConnection: readRows: problem while stepping the result");
+    }
+
+    if (done)
+        *done = result == SQLITE_DONE;
+
+    return num_rows;
 }
 
 void SQLiteConnection::prepareStatement(const std::string& sql)
@@ -546,54 +549,26 @@ std::shared_ptr<DBResult> SQLiteConnection::stepPreparedCommand(unsigned int max
     assert(prepared_command_);
     assert(!prepared_command_done_);
 
-    std::string sql = prepared_command_->get();
-    assert(prepared_command_->resultList().size() > 0);  // data should be returned
+    return stepStatement(db_handle_, statement_, *prepared_command_, max_results, prepared_command_done_);
+}
+
+std::shared_ptr<DBResult> SQLiteConnection::stepStatement(
+        sqlite3* db_handle, sqlite3_stmt* statement, const DBCommand& command, unsigned int max_results,
+        bool& done_flag)
+{
+    assert(command.resultList().size() > 0);  // data should be returned
 
-    std::shared_ptr<Buffer> buffer(new Buffer(prepared_command_->resultList()));
+    std::shared_ptr<Buffer> buffer(new Buffer(command.resultList()));
     assert(buffer->size() == 0);
     std::shared_ptr<DBResult> dbresult(new DBResult(buffer));
 
-    unsigned int num_properties = buffer->properties().size();
-    const PropertyList& list = buffer->properties();
+    bool done;
+    unsigned int num_rows = readRows(db_handle, statement, *buffer, max_results, &done);
 
-    unsigned int cnt = 0;
-    int result;
-    bool done = true;
-
-    max_results--;
-
-    // Now step throught the result lines
-    for (result = sqlite3_step(statement_); result == SQLITE_ROW; result = sqlite3_step(statement_))
+    if (done || !num_rows)
     {
-        readRowIntoBuffer(list, num_properties, buffer, cnt);
-
-        if (buffer->size())  // 0 == 1 otherwise
-            assert(buffer->size() == cnt + 1);
-
-        if (max_results != 0 && cnt >= max_results)
-        {
-            done = false;
-            break;
-        }
-
-        ++cnt;
-    }
-
-    if (result != SQLITE_ROW && result != SQLITE_DONE)
-    {
-        logerr << "SQLiteConnection: stepPreparedCommand: problem while stepping the result: "
-               << result << " " << sqlite3_errmsg(db_handle_);
-        throw std::runtime_error(
-                    "SQLiteConnection: stepPreparedCommand: problem while stepping the result");
-    }
-
-    assert(buffer->size() <= max_results + 1);  // because of max_results--
-
-    if (result == SQLITE_DONE || buffer->size() == 0 || done)
-    {
-        assert(done);
-        logdbg << "SQLiteConnection: stepPreparedCommand: reading done";
-        prepared_command_done_ = true;
+        logdbg << "SQLiteConnection: stepStatement: reading done";
+        done_flag = true;
 
         buffer->lastOne(true);
     }
@@ -724,3 +699,205 @@ std::string SQLiteConnection::status() const
         return "Not connected";
 }
 
+std::vector<std::string> SQLiteConnection::storageProfileNames() const
+{
+    std::vector<std::string> names;
+
+    for (auto& profile_it : storage_profiles_.items())
+        names.push_back(profile_it.key());
+
+    return names;
+}
+
+void SQLiteConnection::storageProfile(const std::string& name)
+{
+    loginf << "SQLiteConnection: storageProfile: name '" << name << "'";
+
+    if (!storage_profiles_.contains(name))
+        throw std::runtime_error("SQLiteConnection: storageProfile: unknown profile '" + name + "'");
+
+    storage_profile_ = name;
+
+    useStorageProfile(name);
+}
+
+void SQLiteConnection::useImportStorageProfile(bool live)
+{
+    useStorageProfile(live ? live_storage_profile_ : import_storage_profile_);
+}
+
+void SQLiteConnection::useConfiguredStorageProfile()
+{
+    useStorageProfile(storage_profile_);
+}
+
+void SQLiteConnection::useStorageProfile(const std::string& name)
+{
+    logdbg << "SQLiteConnection: useStorageProfile: name '" << name << "' active '"
+           << active_storage_profile_ << "'";
+
+    if (name == active_storage_profile_)
+        return;
+
+    active_storage_profile_ = name;
+
+    {
+        boost::mutex::scoped_lock locker(readers_mutex_);
+        idle_readers_.clear(); // re-created with new profile
+    }
+
+    if (db_opened_)
+        applyStorageProfile();
+}
+
+bool SQLiteConnection::parallelReadPossible()
+{
+    if (!db_opened_ || !storage_profiles_.contains(active_storage_profile_))
+        return false;
+
+    const nlohmann::json& profile = storage_profiles_.at(active_storage_profile_);
+
+    return !profile.contains("locking_mode")
+            || !boost::algorithm::iequals(profile.at("locking_mode").get<string>(), "EXCLUSIVE");
+}
+
+std::shared_ptr<SQLiteReader> SQLiteConnection::acquireReader()
+{
+    assert (db_opened_);
+
+    boost::mutex::scoped_lock locker(readers_mutex_);
+
+    std::shared_ptr<SQLiteReader> reader;
+
+    if (idle_readers_.size())
+    {
+        reader = idle_readers_.back();
+        idle_readers_.pop_back();
+    }
+    else
+    {
+        loginf << "SQLiteConnection: acquireReader: creating reader " << num_acquired_readers_ + 1;
+        reader = std::make_shared<SQLiteReader>(file_name_, storage_profiles_.at(active_storage_profile_));
+    }
+
+    ++num_acquired_readers_;
+
+    return reader;
+}
+
+void SQLiteConnection::releaseReader(std::shared_ptr<SQLiteReader> reader)
+{
+    assert (reader);
+
+    boost::mutex::scoped_lock locker(readers_mutex_);
+
+    assert (num_acquired_readers_);
+    --num_acquired_readers_;
+
+    if (db_opened_) // otherwise closed on delete
+        idle_readers_.push_back(reader);
+}
+
+std::string SQLiteConnection::pragmaValue(const std::string& pragma)
+{
+    assert (db_handle_);
+
+    std::string sql = "PRAGMA " + pragma + ";";
+    std::string value;
+
+    sqlite3_stmt* statement {nullptr};
+
+    if (sqlite3_prepare_v2(db_handle_, sql.c_str(), sql.size(), &statement, nullptr) != SQLITE_OK)
+    {
+        logerr << "SQLiteConnection: pragmaValue: error preparing '" << sql << "': "
+               << sqlite3_errmsg(db_handle_);
+        throw std::runtime_error("SQLiteConnection: pragmaValue: error preparing statement");
+    }
+
+    if (sqlite3_step(statement) == SQLITE_ROW && sqlite3_column_type(statement, 0) != SQLITE_NULL)
+        value = reinterpret_cast<const char*>(sqlite3_column_text(statement, 0));
+
+    sqlite3_finalize(statement);
+
+    return value;
+}
+
+nlohmann::json SQLiteConnection::defaultStorageProfiles()
+{
+    nlohmann::json profiles = nlohmann::json::object();
+
+    // single writer, no journal, as previously hard-coded but with larger cache
+    profiles["bulk import"] = {{"page_size", 65536}, {"cache_size_mb", 1024}, {"mmap_size_mb", 0},
+                               {"journal_mode", "OFF"}, {"synchronous", "OFF"},
+                               {"locking_mode", "EXCLUSIVE"}, {"temp_store", "MEMORY"}};
+
+    // default, pragmas and cache as previously hard-coded, but without exclusive locking to allow
+    // concurrent readers
+    profiles["interactive analysis"] = {{"cache_size_mb", 2}, {"mmap_size_mb", 0},
+                                        {"journal_mode", "OFF"}, {"synchronous", "OFF"},
+                                        {"locking_mode", "NORMAL"}, {"temp_store", "MEMORY"}};
+
+    // frequent small inserts & deletes with concurrent readers
+    profiles["live"] = {{"page_size", 4096}, {"cache_size_mb", 256}, {"mmap_size_mb", 1024},
+                        {"journal_mode", "WAL"}, {"synchronous", "NORMAL"},
+                        {"locking_mode", "NORMAL"}, {"temp_store", "MEMORY"}};
+
+    return profiles;
+}
+
+void SQLiteConnection::applyStorageProfile()
+{
+    assert (db_handle_);
+
+    if (!storage_profiles_.contains(active_storage_profile_))
+    {
+        logerr << "SQLiteConnection: applyStorageProfile: unknown profile '" << active_storage_profile_
+               << "', using 'interactive analysis'";
+        active_storage_profile_ = "interactive analysis";
+
+        if (!storage_profiles_.contains(active_storage_profile_))
+            storage_profiles_[active_storage_profile_] = defaultStorageProfiles().at(active_storage_profile_);
+    }
+
+    const nlohmann::json& profile = storage_profiles_.at(active_storage_profile_);
+
+    loginf << "SQLiteConnection: applyStorageProfile: profile '" << active_storage_profile_ << "' "
+           << profile.dump();
+
+    // page size only has effect before first table is created, or on VACUUM when not in WAL mode
+    if (profile.contains("page_size"))
+        executeSQL("PRAGMA page_size = " + to_string(profile.at("page_size").get<unsigned int>()));
+
+    if (profile.contains("locking_mode"))
+        executeSQL("PRAGMA locking_mode = " + profile.at("locking_mode").get<string>());
+
+    if (profile.contains("synchronous"))
+        executeSQL("PRAGMA synchronous = " + profile.at("synchronous").get<string>());
+
+    if (profile.contains("journal_mode"))
+    {
+        string journal_mode = profile.at("journal_mode").get<string>();
+        string set_mode = pragmaValue("journal_mode = " + journal_mode);
+
+        if (!boost::algorithm::iequals(set_mode, journal_mode))
+            logwrn << "SQLiteConnection: applyStorageProfile: journal mode '" << journal_mode
+                   << "' not applied, is '" << set_mode << "'";
+    }
+
+    if (profile.contains("cache_size_mb")) // negative is in KiB
+        executeSQL("PRAGMA cache_size = -"
+                   + to_string(profile.at("cache_size_mb").get<unsigned int>() * 1024));
+
+    if (profile.contains("mmap_size_mb"))
+        executeSQL("PRAGMA mmap_size = "
+                   + to_string(profile.at("mmap_size_mb").get<size_t>() * 1024 * 1024));
+
+    if (profile.contains("temp_store"))
+        executeSQL("PRAGMA temp_store = " + profile.at("temp_store").get<string>());
+
+    loginf << "SQLiteConnection: applyStorageProfile: page size " << pragmaValue("page_size")
+           << " journal mode " << pragmaValue("journal_mode")
+           << " cache size " << pragmaValue("cache_size")
+           << " mmap size " << pragmaValue("mmap_size");
+}
+
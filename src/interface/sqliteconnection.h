@@ -22,10 +22,14 @@
 
 #include <sqlite3.h>
 
+#include <boost/thread/mutex.hpp>
+
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "configurable.h"
+#include "json.hpp"
 
 #include "global.h"
 
@@ -42,6 +46,7 @@ class DBConnectionInfo;
 class Buffer;
 class DBTableInfo;
 class QWidget;
+class SQLiteReader;
 
 /**
  * @brief Interface for a SQLite3 database connection
@@ -74,9 +79,13 @@ public:
     void bindVariable(unsigned int index, int value);
     void bindVariable(unsigned int index, double value);
     void bindVariable(unsigned int index, const std::string& value);
+    // no copy, value must stay unchanged until statement was stepped
+    void bindVariableStatic(unsigned int index, const std::string& value);
     void bindVariable(unsigned int index, long value);
     void bindVariableNull(unsigned int index);
 
+    unsigned int maxBindVariables(); // per statement
+
     std::shared_ptr<DBResult> execute(const DBCommand& command);
     std::shared_ptr<DBResult> execute(const DBCommandList& command_list);
 
@@ -92,6 +101,30 @@ public:
 
     std::string status() const;
 
+    // storage profiles, named sets of pragmas applied on open or when switched
+    std::vector<std::string> storageProfileNames() const;
+    const std::string& storageProfile() const { return storage_profile_; }
+    void storageProfile(const std::string& name); // configured profile, applied directly if opened
+    const std::string& activeStorageProfile() const { return active_storage_profile_; }
+    // workload profiles, applied if opened but not stored as configured profile
+    void useImportStorageProfile(bool live);
+    void useConfiguredStorageProfile();
+    std::string pragmaValue(const std::string& pragma);
+
+    // steps statement of command into new result buffer, sets done flag if no more rows
+    static std::shared_ptr<DBResult> stepStatement(sqlite3* db_handle, sqlite3_stmt* statement,
+                                                   const DBCommand& command, unsigned int max_results,
+                                                   bool& done);
+    // read-only handles on the opened file, for parallel reads
+    bool parallelReadPossible(); // not if exclusive locking mode
+    std::shared_ptr<SQLiteReader> acquireReader(); // from pool, or newly created
+    void releaseReader(std::shared_ptr<SQLiteReader> reader); // back into pool
+
+    // appends up to max_rows (0 for all) result rows to buffer, columns are pre-sized and read with
+    // typed readers resolved once. returns number of read rows, done set if no more rows
+    static unsigned int readRows(sqlite3* db_handle, sqlite3_stmt* statement, Buffer& buffer,
+                                 unsigned int max_rows, bool* done = nullptr);
+
     bool dbOpened() { return db_opened_; }
 
 protected:
@@ -107,10 +140,27 @@ protected:
     std::shared_ptr<DBCommand> prepared_command_;
     bool prepared_command_done_;
 
+    // name -> page_size, cache_size_mb, mmap_size_mb, journal_mode, synchronous, locking_mode, temp_store
+    nlohmann::json storage_profiles_;
+    std::string storage_profile_; // configured, used on open and after imports
+    std::string import_storage_profile_;
+    std::string live_storage_profile_;
+    std::string active_storage_profile_;
+
+    static const unsigned int READ_BLOCK_SIZE {10000}; // initial size if no max rows
+
+    std::string file_name_;
+
+    boost::mutex readers_mutex_;
+    std::vector<std::shared_ptr<SQLiteReader>> idle_readers_;
+    unsigned int num_acquired_readers_ {0};
+
+    static nlohmann::json defaultStorageProfiles();
+    void useStorageProfile(const std::string& name);
+    void applyStorageProfile();
+
     void execute(const std::string& command);
     void execute(const std::string& command, std::shared_ptr<Buffer> buffer);
-    void readRowIntoBuffer(const PropertyList& list, unsigned int num_properties,
-                           std::shared_ptr<Buffer> buffer, unsigned int index);
 
     void prepareStatement(const std::string& sql);
     void finalizeStatement();
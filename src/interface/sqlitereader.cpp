@@ -0,0 +1,118 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "sqlitereader.h"
+#include "sqliteconnection.h"
+#include "dbcommand.h"
+#include "dbresult.h"
+#include "logger.h"
+
+using namespace std;
+
+SQLiteReader::SQLiteReader(const std::string& file_name, const nlohmann::json& storage_profile)
+{
+    logdbg << "SQLiteReader: constructor: file '" << file_name << "'";
+
+    int result = sqlite3_open_v2(file_name.c_str(), &db_handle_,
+                                 SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, NULL);
+
+    if (result != SQLITE_OK)
+    {
+        logerr << "SQLiteReader: constructor: error " << result << " " << sqlite3_errmsg(db_handle_);
+        sqlite3_close(db_handle_);
+        db_handle_ = nullptr;
+        throw runtime_error("SQLiteReader: constructor: error opening file");
+    }
+
+    sqlite3_busy_timeout(db_handle_, 5000); // wait on writer commits
+
+    string pragmas = "PRAGMA query_only = 1;";
+
+    if (storage_profile.contains("cache_size_mb")) // negative is in KiB
+        pragmas += " PRAGMA cache_size = -"
+                + to_string(storage_profile.at("cache_size_mb").get<unsigned int>() * 1024) + ";";
+
+    if (storage_profile.contains("mmap_size_mb"))
+        pragmas += " PRAGMA mmap_size = "
+                + to_string(storage_profile.at("mmap_size_mb").get<size_t>() * 1024 * 1024) + ";";
+
+    if (storage_profile.contains("temp_store"))
+        pragmas += " PRAGMA temp_store = " + storage_profile.at("temp_store").get<string>() + ";";
+
+    char* err_msg = nullptr;
+
+    if (sqlite3_exec(db_handle_, pragmas.c_str(), NULL, NULL, &err_msg) != SQLITE_OK)
+    {
+        logerr << "SQLiteReader: constructor: setting pragmas failed: " << err_msg;
+        sqlite3_free(err_msg);
+    }
+}
+
+SQLiteReader::~SQLiteReader()
+{
+    if (prepared_command_)
+        finalizeCommand();
+
+    if (db_handle_)
+    {
+        sqlite3_close(db_handle_);
+        db_handle_ = nullptr;
+    }
+}
+
+void SQLiteReader::prepareCommand(const std::shared_ptr<DBCommand> command)
+{
+    assert(!prepared_command_);
+    assert(command);
+
+    prepared_command_ = command;
+    prepared_command_done_ = false;
+
+    const string& sql = command->get();
+
+    logdbg << "SQLiteReader: prepareCommand: sql '" << sql << "'";
+
+    int result = sqlite3_prepare_v2(db_handle_, sql.c_str(), sql.size(), &statement_, NULL);
+
+    if (result != SQLITE_OK)
+    {
+        logerr << "SQLiteReader: prepareCommand: error " << result << " " << sqlite3_errmsg(db_handle_);
+        prepared_command_ = nullptr;
+        prepared_command_done_ = true;
+        throw runtime_error("SQLiteReader: prepareCommand: error");
+    }
+}
+
+std::shared_ptr<DBResult> SQLiteReader::stepPreparedCommand(unsigned int max_results)
+{
+    assert(prepared_command_);
+    assert(!prepared_command_done_);
+
+    return SQLiteConnection::stepStatement(db_handle_, statement_, *prepared_command_, max_results,
+                                           prepared_command_done_);
+}
+
+void SQLiteReader::finalizeCommand()
+{
+    assert(prepared_command_);
+
+    sqlite3_finalize(statement_);
+    statement_ = nullptr;
+
+    prepared_command_ = nullptr;
+    prepared_command_done_ = true;
+}
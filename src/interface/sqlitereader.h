@@ -0,0 +1,57 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SQLITEREADER_H
+#define SQLITEREADER_H
+
+#include "json.hpp"
+
+#include <sqlite3.h>
+
+#include <memory>
+#include <string>
+
+class DBCommand;
+class DBResult;
+
+/**
+ * @brief Read-only handle on the database file of a SQLiteConnection
+ *
+ * Owned by the reader pool of the SQLiteConnection, allows reading a prepared command in parallel
+ * to other readers (and the main connection if not in exclusive locking mode). Not thread-safe
+ * itself, must only be used by one thread at a time.
+ */
+class SQLiteReader
+{
+  public:
+    SQLiteReader(const std::string& file_name, const nlohmann::json& storage_profile);
+    virtual ~SQLiteReader();
+
+    void prepareCommand(const std::shared_ptr<DBCommand> command);
+    std::shared_ptr<DBResult> stepPreparedCommand(unsigned int max_results = 0);
+    void finalizeCommand();
+    bool getPreparedCommandDone() { return prepared_command_done_; }
+
+  protected:
+    sqlite3* db_handle_{nullptr};
+    sqlite3_stmt* statement_{nullptr};
+
+    std::shared_ptr<DBCommand> prepared_command_;
+    bool prepared_command_done_{true};
+};
+
+#endif // SQLITEREADER_H
@@ -26,8 +26,34 @@
 #include "logger.h"
 #include "stringconv.h"
 
+#include <functional>
+
 using namespace Utils;
 
+namespace
+{
+    // runs a job in the thread pool, calls finished when job run returned
+    class JobRunnable : public QRunnable
+    {
+      public:
+        JobRunnable(std::shared_ptr<Job> job, std::function<void()> finished)
+            : job_(job), finished_(finished)
+        {
+            setAutoDelete(true);
+        }
+
+        virtual void run() override
+        {
+            job_->run();
+            finished_();
+        }
+
+      private:
+        std::shared_ptr<Job> job_;
+        std::function<void()> finished_;
+    };
+}
+
 JobManager::JobManager()
     : Configurable("JobManager", "JobManager0", 0, "threads.json"),
       stop_requested_(false), stopped_(false)
@@ -42,6 +68,7 @@ void JobManager::addBlockingJob(std::shared_ptr<Job> job)
     logdbg << "JobManager: addJob: " << job->name() << " num " << blocking_jobs_.unsafe_size();
 
     blocking_jobs_.push(job);  // only add, do not start
+    wake();
 }
 
 void JobManager::addNonBlockingJob(std::shared_ptr<Job> job)
@@ -50,19 +77,39 @@ void JobManager::addNonBlockingJob(std::shared_ptr<Job> job)
            << non_blocking_jobs_.unsafe_size();
 
     non_blocking_jobs_.push(job);  // add and start
-    QThreadPool::globalInstance()->start(job.get());
+    startJob(job);
+    wake();
+}
+
+void JobManager::addConcurrentJob(std::shared_ptr<Job> job)
+{
+    logdbg << "JobManager: addConcurrentJob: " << job->name() << " num "
+           << queued_concurrent_jobs_.unsafe_size();
+
+    queued_concurrent_jobs_.push(job); // started by manager
+    wake();
 }
 
 void JobManager::addDBJob(std::shared_ptr<Job> job)
 {
     queued_db_jobs_.push(job);
+    wake();
 
     //emit databaseBusy();
 }
 
+void JobManager::addDBReadJob(std::shared_ptr<Job> job)
+{
+    queued_db_read_jobs_.push(job);
+    wake();
+}
+
 void JobManager::cancelJob(std::shared_ptr<Job> job) { job->setObsolete(); }
 
-bool JobManager::hasAnyJobs() { return hasBlockingJobs() || hasNonBlockingJobs() || hasDBJobs(); }
+bool JobManager::hasAnyJobs()
+{
+    return hasBlockingJobs() || hasNonBlockingJobs() || hasConcurrentJobs() || hasDBJobs();
+}
 
 bool JobManager::hasBlockingJobs() { return active_blocking_job_ || !blocking_jobs_.empty(); }
 
@@ -71,7 +118,16 @@ bool JobManager::hasNonBlockingJobs()
     return active_non_blocking_job_ || !non_blocking_jobs_.empty();
 }
 
-bool JobManager::hasDBJobs() { return active_db_job_ || !queued_db_jobs_.empty(); }
+bool JobManager::hasConcurrentJobs()
+{
+    return !active_concurrent_jobs_.empty() || !queued_concurrent_jobs_.empty();
+}
+
+bool JobManager::hasDBJobs()
+{
+    return active_db_job_ || !queued_db_jobs_.empty()
+            || !active_db_read_jobs_.empty() || !queued_db_read_jobs_.empty();
+}
 
 /**
  * Creates thread if possible.
@@ -98,6 +154,9 @@ void JobManager::run()
         if (hasNonBlockingJobs())
             handleNonBlockingJobs();
 
+        if (hasConcurrentJobs())
+            handleConcurrentJobs();
+
         if (hasDBJobs())
             handleDBJobs();
 
@@ -106,8 +165,12 @@ void JobManager::run()
 
         if (QCoreApplication::hasPendingEvents())
             QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
-        else
-            msleep(1);
+
+        // wait until jobs were added or finished, or stop was requested (all call wake). not on
+        // stop_requested_ alone, which would spin while remaining jobs finish
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        wake_condition_.wait(lock, [this] { return wake_; });
+        wake_ = false;
 
 //        if ((boost::posix_time::microsec_clock::local_time() - log_time_).total_seconds() > 1)
 //        {
@@ -118,6 +181,7 @@ void JobManager::run()
 
     assert(!hasBlockingJobs());
     assert(!hasNonBlockingJobs());
+    assert(!hasConcurrentJobs());
     assert(!hasDBJobs());
 
     stopped_ = true;
@@ -156,7 +220,7 @@ void JobManager::handleBlockingJobs()
         if (blocking_jobs_.try_pop(active_blocking_job_))
         {
             assert(!active_blocking_job_->started());
-            QThreadPool::globalInstance()->start(active_blocking_job_.get());
+            startJob(active_blocking_job_);
 
             //changed_ = true;
             //really_update_widget_ = !hasBlockingJobs();
@@ -210,6 +274,31 @@ void JobManager::handleNonBlockingJobs()
             break;
     }
 }
+void JobManager::handleConcurrentJobs()
+{
+    for (auto job_it = active_concurrent_jobs_.begin(); job_it != active_concurrent_jobs_.end();)
+    {
+        if ((*job_it)->done())
+        {
+            logdbg << "JobManager: run: flushing done concurrent job";
+
+            if (!stop_requested_)
+                (*job_it)->emitDone();
+
+            job_it = active_concurrent_jobs_.erase(job_it);
+        }
+        else
+            ++job_it;
+    }
+
+    std::shared_ptr<Job> job;
+
+    while (queued_concurrent_jobs_.try_pop(job))
+    {
+        active_concurrent_jobs_.push_back(job);
+        startJob(job);
+    }
+}
 void JobManager::handleDBJobs()
 {
     if (active_db_job_)  // see if active one exists
@@ -237,16 +326,42 @@ void JobManager::handleDBJobs()
         }
     }
 
-    if (!active_db_job_ && !queued_db_jobs_.empty())
+    for (auto job_it = active_db_read_jobs_.begin(); job_it != active_db_read_jobs_.end();)
+    {
+        if ((*job_it)->done())
+        {
+            logdbg << "JobManager: run: flushing done db read job";
+
+            if (!stop_requested_)
+                (*job_it)->emitDone();
+
+            job_it = active_db_read_jobs_.erase(job_it);
+        }
+        else
+            ++job_it;
+    }
+
+    if (!active_db_job_ && active_db_read_jobs_.empty() && !queued_db_jobs_.empty())
     {
         if (queued_db_jobs_.try_pop(active_db_job_))
         {
-            QThreadPool::globalInstance()->start(active_db_job_.get());
+            startJob(active_db_job_);
 
             //changed_ = true;
             //really_update_widget_ = !hasDBJobs();
         }
     }
+
+    if (!active_db_job_ && queued_db_jobs_.empty())
+    {
+        std::shared_ptr<Job> read_job;
+
+        while (queued_db_read_jobs_.try_pop(read_job))
+        {
+            active_db_read_jobs_.push_back(read_job);
+            startJob(read_job);
+        }
+    }
 }
 
 void JobManager::shutdown()
@@ -254,6 +369,7 @@ void JobManager::shutdown()
     loginf << "JobManager: shutdown: setting jobs obsolete";
 
     stop_requested_ = true;
+    wake();
 
     if (active_db_job_)
         active_db_job_->setObsolete();
@@ -262,6 +378,13 @@ void JobManager::shutdown()
          ++job_it)
         (*job_it)->setObsolete();
 
+    for (auto& job_it : active_db_read_jobs_)
+        job_it->setObsolete();
+
+    for (auto job_it = queued_db_read_jobs_.unsafe_begin(); job_it != queued_db_read_jobs_.unsafe_end();
+         ++job_it)
+        (*job_it)->setObsolete();
+
     if (active_blocking_job_)
         active_blocking_job_->setObsolete();
 
@@ -276,12 +399,20 @@ void JobManager::shutdown()
          ++job_it)
         (*job_it)->setObsolete();
 
+    for (auto& job_it : active_concurrent_jobs_)
+        job_it->setObsolete();
+
+    for (auto job_it = queued_concurrent_jobs_.unsafe_begin(); job_it != queued_concurrent_jobs_.unsafe_end();
+         ++job_it)
+        (*job_it)->setObsolete();
+
     loginf << "JobManager: shutdown: waiting on jobs to quit";
 
     while (hasAnyJobs())
     {
         loginf << "JobManager: shutdown: waiting on jobs to finish: db " << hasDBJobs()
-               << " blocking " << hasBlockingJobs() << " non-locking " << hasNonBlockingJobs();
+               << " blocking " << hasBlockingJobs() << " non-locking " << hasNonBlockingJobs()
+               << " concurrent " << hasConcurrentJobs();
 
         msleep(1000);
     }
@@ -300,12 +431,33 @@ void JobManager::shutdown()
     assert(!active_non_blocking_job_);
     assert(non_blocking_jobs_.empty());
 
+    assert(active_concurrent_jobs_.empty());
+    assert(queued_concurrent_jobs_.empty());
+
     assert(!active_db_job_);
     assert(queued_db_jobs_.empty());
 
+    assert(active_db_read_jobs_.empty());
+    assert(queued_db_read_jobs_.empty());
+
     loginf << "JobManager: shutdown: done";
 }
 
+void JobManager::wake()
+{
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        wake_ = true;
+    }
+
+    wake_condition_.notify_one();
+}
+
+void JobManager::startJob(std::shared_ptr<Job> job)
+{
+    QThreadPool::globalInstance()->start(new JobRunnable(job, [this] { wake(); }));
+}
+
 unsigned int JobManager::numBlockingJobs()
 {
     return active_blocking_job_ ? blocking_jobs_.unsafe_size() + 1 : blocking_jobs_.unsafe_size();
@@ -317,12 +469,18 @@ unsigned int JobManager::numNonBlockingJobs()
                                     : non_blocking_jobs_.unsafe_size();
 }
 
+unsigned int JobManager::numConcurrentJobs()
+{
+    return active_concurrent_jobs_.size() + queued_concurrent_jobs_.unsafe_size();
+}
+
 unsigned int JobManager::numDBJobs()
 {
-    return active_db_job_ ? queued_db_jobs_.unsafe_size() + 1 : queued_db_jobs_.unsafe_size();
+    return (active_db_job_ ? queued_db_jobs_.unsafe_size() + 1 : queued_db_jobs_.unsafe_size())
+            + active_db_read_jobs_.size() + queued_db_read_jobs_.unsafe_size();
 }
 
-unsigned int JobManager::numJobs() { return numBlockingJobs() + numNonBlockingJobs(); }
+unsigned int JobManager::numJobs() { return numBlockingJobs() + numNonBlockingJobs() + numConcurrentJobs(); }
 
 int JobManager::numThreads() { return QThreadPool::globalInstance()->activeThreadCount(); }
 
@@ -30,8 +30,10 @@
 
 #include "util/tbbhack.h"
 
+#include <condition_variable>
 #include <list>
 #include <memory>
+#include <mutex>
 
 class WorkerThread;
 class Job;
@@ -50,23 +52,32 @@ class JobManager : public QThread, public Singleton, public Configurable
     void addBlockingJob(std::shared_ptr<Job> job);
     // does not block start of later ones
     void addNonBlockingJob(std::shared_ptr<Job> job);
+    // runs in parallel to all other jobs, done is emitted independent of other jobs
+    void addConcurrentJob(std::shared_ptr<Job> job);
     // only one db job can be active
     void addDBJob(std::shared_ptr<Job> job);
+    // db read jobs run in parallel to each other, but not to other db jobs, which have precedence
+    void addDBReadJob(std::shared_ptr<Job> job);
     void cancelJob(std::shared_ptr<Job> job);
 
     bool hasAnyJobs();
     bool hasBlockingJobs();
     bool hasNonBlockingJobs();
+    bool hasConcurrentJobs();
     bool hasDBJobs();
 
     unsigned int numBlockingJobs();
     unsigned int numNonBlockingJobs();
+    unsigned int numConcurrentJobs();
     unsigned int numJobs();
     unsigned int numDBJobs();
     int numThreads();
 
     void shutdown();
 
+    // wakes up the manager thread, e.g. if a job was added or finished
+    void wake();
+
     static JobManager& instance()
     {
         static JobManager instance;
@@ -86,19 +97,33 @@ class JobManager : public QThread, public Singleton, public Configurable
     std::shared_ptr<Job> active_non_blocking_job_;
     tbb::concurrent_queue<std::shared_ptr<Job>> non_blocking_jobs_;
 
+    std::list<std::shared_ptr<Job>> active_concurrent_jobs_;
+    tbb::concurrent_queue<std::shared_ptr<Job>> queued_concurrent_jobs_;
+
     std::shared_ptr<Job> active_db_job_;
     tbb::concurrent_queue<std::shared_ptr<Job>> queued_db_jobs_;
 
+    std::list<std::shared_ptr<Job>> active_db_read_jobs_;
+    tbb::concurrent_queue<std::shared_ptr<Job>> queued_db_read_jobs_;
+
     boost::posix_time::ptime last_update_time_;
 
+    std::mutex wake_mutex_;
+    std::condition_variable wake_condition_;
+    bool wake_ {false};
+
     JobManager();
 
   private:
     void run();
 
+    // starts job in thread pool, wakes manager when job run returned
+    void startJob(std::shared_ptr<Job> job);
+
     // set change flags as appropriate
     void handleBlockingJobs();
     void handleNonBlockingJobs();
+    void handleConcurrentJobs();
     void handleDBJobs();
 };
 
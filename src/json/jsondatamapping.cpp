@@ -480,74 +480,62 @@ size_t row_cnt, bool debug) const;
 
 const nlohmann::json* JSONDataMapping::findKey(const nlohmann::json& j) const
 {
+    // single lookup per level, find on non-objects returns end
     const nlohmann::json* val_ptr = &j;
+    nlohmann::json::const_iterator val_it;
 
     if (has_sub_keys_)
     {
         for (auto sub_it = sub_keys_.begin(); sub_it != sub_keys_.end(); ++sub_it)
         {
-            if (val_ptr->contains(*sub_it))
-            {
-                if (sub_it == last_key_)  // last found
-                {
-                    val_ptr = &val_ptr->at(*sub_it);
-                    break;
-                }
+            val_it = val_ptr->find(*sub_it);
 
-                if (val_ptr->at(*sub_it).is_object())  // not last, step in
-                    val_ptr = &val_ptr->at(*sub_it);
-                else  // not last key, and not object
-                {
-                    val_ptr = nullptr;
-                    break;
-                }
-            }
-            else  // not found
-            {
-                val_ptr = nullptr;
+            if (val_it == val_ptr->end())  // not found
+                return nullptr;
+
+            val_ptr = &*val_it;
+
+            if (sub_it == last_key_)  // last found
                 break;
-            }
+
+            if (!val_ptr->is_object())  // not last key, and not object
+                return nullptr;
         }
     }
     else
     {
-        if (val_ptr->contains(json_key_))
-            val_ptr = &val_ptr->at(json_key_);
-        else
-            val_ptr = nullptr;
+        val_it = val_ptr->find(json_key_);
+
+        if (val_it == val_ptr->end())
+            return nullptr;
+
+        val_ptr = &*val_it;
     }
+
     return val_ptr;
 }
 
 const nlohmann::json* JSONDataMapping::findParentKey(const nlohmann::json& j) const
 {
     const nlohmann::json* val_ptr = &j;
+    nlohmann::json::const_iterator val_it;
 
     if (has_sub_keys_)
     {
         for (auto sub_it = sub_keys_.begin(); sub_it != sub_keys_.end(); ++sub_it)
         {
-            if (val_ptr->contains(*sub_it))
-            {
-                if (sub_it == second_to_last_key_)  // second to last found
-                {
-                    val_ptr = &val_ptr->at(*sub_it);
-                    break;
-                }
+            val_it = val_ptr->find(*sub_it);
 
-                if (val_ptr->at(*sub_it).is_object())  // not second to last, step in
-                    val_ptr = &val_ptr->at(*sub_it);
-                else  // not last key, and not object
-                {
-                    val_ptr = nullptr;
-                    break;
-                }
-            }
-            else  // not found
-            {
-                val_ptr = nullptr;
+            if (val_it == val_ptr->end())  // not found
+                return nullptr;
+
+            val_ptr = &*val_it;
+
+            if (sub_it == second_to_last_key_)  // second to last found
                 break;
-            }
+
+            if (!val_ptr->is_object())  // not second to last, and not object
+                return nullptr;
         }
     }  // else path means j is already parent
 
@@ -0,0 +1,155 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "jsonmappingplan.h"
+#include "jsondatamapping.h"
+#include "buffer.h"
+#include "dbcontent/variable/variable.h"
+#include "logger.h"
+
+#include <exception>
+
+using namespace std;
+using namespace nlohmann;
+
+template <typename T>
+void JSONMappingPlan::addEntry(const JSONDataMapping& mapping)
+{
+    const std::string& var_name = mapping.variable().name();
+
+    logdbg << "JSONMappingPlan: addEntry: " << var_name << " format '" << mapping.jsonValueFormat()
+           << "'";
+
+    assert(buffer_.has<T>(var_name));
+    NullableVector<T>* array_list = &buffer_.get<T>(var_name);
+
+    Entry entry;
+    entry.mapping_ = &mapping;
+    entry.setter_ = [&mapping, array_list](const json& tr, size_t row_cnt) -> bool {
+        return mapping.findAndSetValue(tr, *array_list, row_cnt);
+    };
+
+    entries_.push_back(std::move(entry));
+}
+
+JSONMappingPlan::JSONMappingPlan(const std::vector<std::unique_ptr<JSONDataMapping>>& data_mappings,
+                                 Buffer& buffer, const std::string& parser_name)
+    : buffer_(buffer), parser_name_(parser_name)
+{
+    entries_.reserve(data_mappings.size());
+
+    PropertyDataType data_type;
+
+    for (const auto& map_it : data_mappings)
+    {
+        if (!map_it->active())
+        {
+            assert(!map_it->mandatory());
+            continue;
+        }
+
+        data_type = map_it->variable().dataType();
+
+        switch (data_type)
+        {
+        case PropertyDataType::BOOL:
+            addEntry<bool>(*map_it);
+            break;
+        case PropertyDataType::CHAR:
+            addEntry<char>(*map_it);
+            break;
+        case PropertyDataType::UCHAR:
+            addEntry<unsigned char>(*map_it);
+            break;
+        case PropertyDataType::INT:
+            addEntry<int>(*map_it);
+            break;
+        case PropertyDataType::UINT:
+            addEntry<unsigned int>(*map_it);
+            break;
+        case PropertyDataType::LONGINT:
+            addEntry<long int>(*map_it);
+            break;
+        case PropertyDataType::ULONGINT:
+            addEntry<unsigned long>(*map_it);
+            break;
+        case PropertyDataType::FLOAT:
+            addEntry<float>(*map_it);
+            break;
+        case PropertyDataType::DOUBLE:
+            addEntry<double>(*map_it);
+            break;
+        case PropertyDataType::STRING:
+            addEntry<std::string>(*map_it);
+            break;
+        case PropertyDataType::JSON:
+            addEntry<json>(*map_it);
+            break;
+        case PropertyDataType::TIMESTAMP: // not possible for timestamp
+        default:
+        {
+            // fail on first use, as before
+            Entry entry;
+            entry.mapping_ = map_it.get();
+            entry.setter_ = [data_type](const json& tr, size_t row_cnt) -> bool {
+                logerr << "JSONMappingPlan: parseTargetReport: impossible for property type "
+                       << Property::asString(data_type);
+                throw std::runtime_error("JsonMapping: parseTargetReport: impossible property type "
+                                         + Property::asString(data_type));
+            };
+            entries_.push_back(std::move(entry));
+        }
+        }
+    }
+}
+
+bool JSONMappingPlan::parseTargetReport(const nlohmann::json& tr, size_t row_cnt) const
+{
+    bool mandatory_missing{false};
+
+    for (const auto& entry : entries_)
+    {
+        try
+        {
+            mandatory_missing = entry.setter_(tr, row_cnt);
+        }
+        catch (exception& e)
+        {
+            logerr << "JSONMappingPlan: parseTargetReport: caught exception '" << e.what() << "' in \n'"
+                   << tr.dump(4) << "' mapping " << entry.mapping_->jsonKey();
+            throw;
+        }
+
+        if (mandatory_missing)
+        {
+            // TODO make configurable
+            logdbg << "JSONMappingPlan '" << parser_name_ << "': parseTargetReport: mandatory variable '"
+                   << entry.mapping_->variable().name() << "' missing in: \n"
+                   << tr.dump(4);
+            break;
+        }
+    }
+
+    if (mandatory_missing)
+    {
+        // cleanup
+        if (buffer_.size() > row_cnt)
+            buffer_.cutToSize(row_cnt);
+    }
+
+    return !mandatory_missing;
+}
@@ -0,0 +1,66 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JSONMAPPINGPLAN_H
+#define JSONMAPPINGPLAN_H
+
+#include "json.hpp"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+class Buffer;
+class JSONDataMapping;
+
+/**
+ * @brief Data mappings of a parser bound to the columns of one buffer
+ *
+ * Resolves the data type switch and the buffer column lookup of each active mapping once, so
+ * parsing a target report only iterates the bound setters. Must be re-created if the buffer
+ * is replaced, adding further properties to the buffer does not invalidate it.
+ */
+class JSONMappingPlan
+{
+  public:
+    JSONMappingPlan(const std::vector<std::unique_ptr<JSONDataMapping>>& data_mappings,
+                    Buffer& buffer, const std::string& parser_name);
+
+    Buffer& buffer() { return buffer_; }
+
+    // returns false if mandatory variable was missing, buffer is cut to row_cnt in that case
+    bool parseTargetReport(const nlohmann::json& tr, size_t row_cnt) const;
+
+  protected:
+    struct Entry
+    {
+        const JSONDataMapping* mapping_ {nullptr};
+        // returns true if mandatory value was missing
+        std::function<bool(const nlohmann::json&, size_t)> setter_;
+    };
+
+    Buffer& buffer_;
+    std::string parser_name_;
+
+    std::vector<Entry> entries_;
+
+    template <typename T>
+    void addEntry(const JSONDataMapping& mapping);
+};
+
+#endif // JSONMAPPINGPLAN_H
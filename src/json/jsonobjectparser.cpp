@@ -22,6 +22,7 @@
 #include "configuration.h"
 #include "dbcontent/dbcontent.h"
 #include "dbcontent/dbcontentmanager.h"
+#include "jsonmappingplan.h"
 #include "stringconv.h"
 #include "unit.h"
 #include "unitmanager.h"
@@ -214,10 +215,17 @@ void JSONObjectParser::appendVariablesToBuffer(Buffer& buffer) const
 }
 
 bool JSONObjectParser::parseJSON(nlohmann::json& j, Buffer& buffer) const
+{
+    std::unique_ptr<JSONMappingPlan> plan = createMappingPlan(buffer);
+
+    return parseJSON(j, *plan);
+}
+
+bool JSONObjectParser::parseJSON(nlohmann::json& j, JSONMappingPlan& plan) const
 {
     assert(initialized_);
 
-    size_t row_cnt = buffer.size();
+    size_t row_cnt = plan.buffer().size();
     size_t skipped_cnt = 0;
 
     bool parsed_any = false;
@@ -240,7 +248,7 @@ bool JSONObjectParser::parseJSON(nlohmann::json& j, Buffer& buffer) const
                 json& tr = tr_it.value();
                 assert(tr.is_object());
 
-                parsed = parseTargetReport(tr, buffer, row_cnt);
+                parsed = parseTargetReport(tr, plan, row_cnt);
 
                 if (parsed)
                     ++row_cnt;
@@ -259,12 +267,19 @@ bool JSONObjectParser::parseJSON(nlohmann::json& j, Buffer& buffer) const
         logdbg << "JSONObjectParser: parseJSON: found single target report";
         assert(j.is_object());
 
-        parsed_any = parseTargetReport(j, buffer, row_cnt);
+        parsed_any = parseTargetReport(j, plan, row_cnt);
     }
 
     return parsed_any;
 }
 
+std::unique_ptr<JSONMappingPlan> JSONObjectParser::createMappingPlan(Buffer& buffer) const
+{
+    assert(initialized_);
+
+    return std::unique_ptr<JSONMappingPlan>(new JSONMappingPlan(data_mappings_, buffer, name_));
+}
+
 void JSONObjectParser::createMappingStubs(nlohmann::json& j)
 {
     assert(initialized_);
@@ -303,7 +318,7 @@ void JSONObjectParser::createMappingStubs(nlohmann::json& j)
     return;
 }
 
-bool JSONObjectParser::parseTargetReport(const nlohmann::json& tr, Buffer& buffer,
+bool JSONObjectParser::parseTargetReport(const nlohmann::json& tr, JSONMappingPlan& plan,
                                          size_t row_cnt) const
 {
     // check key match
@@ -329,176 +344,7 @@ bool JSONObjectParser::parseTargetReport(const nlohmann::json& tr, Buffer& buffe
         }
     }
 
-    PropertyDataType data_type;
-    std::string current_var_name;
-
-    bool mandatory_missing{false};
-
-    for (const auto& map_it : data_mappings_)
-    {
-        if (!map_it->active())
-        {
-            assert(!map_it->mandatory());
-            continue;
-        }
-
-        // logdbg << "setting data mapping key " << data_it.jsonKey();
-
-        try
-        {
-
-            data_type = map_it->variable().dataType();
-            current_var_name = map_it->variable().name();
-
-            switch (data_type)
-            {
-            case PropertyDataType::BOOL:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: bool " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<bool>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<bool>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::CHAR:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: char " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<char>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<char>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::UCHAR:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: uchar " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<unsigned char>(current_var_name));
-                mandatory_missing = map_it->findAndSetValue(
-                            tr, buffer.get<unsigned char>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::INT:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: int " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<int>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<int>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::UINT:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: uint " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<unsigned int>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<unsigned int>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::LONGINT:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: long " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<long int>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<long int>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::ULONGINT:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: ulong " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<unsigned long>(current_var_name));
-                mandatory_missing = map_it->findAndSetValue(
-                            tr, buffer.get<unsigned long>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::FLOAT:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: float " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<float>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<float>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::DOUBLE:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: double " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<double>(current_var_name));
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<double>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::STRING:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: string " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<std::string>(current_var_name));
-
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<std::string>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::JSON:
-            {
-                logdbg << "JSONObjectParser: parseTargetReport: json " << current_var_name
-                       << " format '" << map_it->jsonValueFormat() << "'";
-                assert(buffer.has<nlohmann::json>(current_var_name));
-
-                mandatory_missing =
-                        map_it->findAndSetValue(tr, buffer.get<nlohmann::json>(current_var_name), row_cnt);
-
-                break;
-            }
-            case PropertyDataType::TIMESTAMP: // not possible for timestamp
-            default:
-                logerr << "JSONObjectParser: parseTargetReport: impossible for property type "
-                       << Property::asString(data_type);
-                throw std::runtime_error(
-                            "JsonMapping: parseTargetReport: impossible property type " +
-                            Property::asString(data_type));
-            }
-
-        }
-        catch (exception& e)
-        {
-            logerr << "JSONObjectParser: parseTargetReport: caught exception '" << e.what() << "' in \n'"
-                   << tr.dump(4) << "' mapping " << map_it->jsonKey();
-            throw e;
-        }
-
-        if (mandatory_missing)
-        {
-            // TODO make configurable
-            logdbg << "JSONObjectParser '" << name_ << "': parseTargetReport: mandatory variable '"
-                   << current_var_name << "' missing in: \n"
-                   << tr.dump(4);
-            break;
-        }
-    }
-
-    if (mandatory_missing)
-    {
-        // cleanup
-        if (buffer.size() > row_cnt)
-            buffer.cutToSize(row_cnt);
-    }
-
-    return !mandatory_missing;
+    return plan.parseTargetReport(tr, row_cnt);
 }
 
 void JSONObjectParser::createMappingsFromTargetReport(const nlohmann::json& tr)
@@ -32,6 +32,7 @@
 
 class Buffer;
 class DBContent;
+class JSONMappingPlan;
 
 namespace dbContent {
 
@@ -71,6 +72,10 @@ class JSONObjectParser : public Configurable
 
     // returs true on successful parse
     bool parseJSON(nlohmann::json& j, Buffer& buffer) const;
+    // same as above, using a plan created for the buffer, to be preferred for repeated parsing
+    bool parseJSON(nlohmann::json& j, JSONMappingPlan& plan) const;
+    // buffer must contain all variables, see getNewBuffer/appendVariablesToBuffer
+    std::unique_ptr<JSONMappingPlan> createMappingPlan(Buffer& buffer) const;
     void createMappingStubs(nlohmann::json& j);
 
     const dbContent::VariableSet& variableList() const;
@@ -133,7 +138,7 @@ private:
     std::vector<std::unique_ptr<JSONDataMapping>> data_mappings_;
 
     // returns true on successful parse
-    bool parseTargetReport(const nlohmann::json& tr, Buffer& buffer, size_t row_cnt) const;
+    bool parseTargetReport(const nlohmann::json& tr, JSONMappingPlan& plan, size_t row_cnt) const;
     void createMappingsFromTargetReport(const nlohmann::json& tr);
 
     void checkIfKeysExistsInMappings(const std::string& location, const nlohmann::json& tr,
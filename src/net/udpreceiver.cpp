@@ -5,14 +5,72 @@
 
 #include <boost/bind.hpp>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#endif
+
 using namespace Utils;
 using namespace std;
 
+// max number of full batches read before other handlers of the io context get their turn
+const unsigned int MAX_BATCHES_PER_WAIT = 16;
+// requested kernel receive buffer size of socket
+const int RECEIVE_BUFFER_SIZE = 8*1024*1024;
+
 UDPReceiver::UDPReceiver(boost::asio::io_context& io_context, //const std::string& sender_ip, unsigned int port,
                          std::shared_ptr<DataSourceLineInfo> line_info,
                          std::function<void(const char*, unsigned int)> data_callback, unsigned int max_read_size)
+    : UDPReceiver(io_context, line_info,
+                  [data_callback](const std::vector<UDPDatagram>& batch) {
+                      for (auto& datagram : batch)
+                          data_callback(datagram.data, datagram.length);
+                  }, max_read_size)
+{
+}
+
+UDPReceiver::UDPReceiver(boost::asio::io_context& io_context, std::shared_ptr<DataSourceLineInfo> line_info,
+                         std::function<void(const std::vector<UDPDatagram>&)> batch_callback,
+                         unsigned int max_read_size)
     : line_info_(line_info), socket_(io_context),
-      data_callback_(data_callback), max_read_size_(max_read_size)
+      batch_callback_(batch_callback), max_read_size_(max_read_size)
+{
+    assert (max_read_size_ > 1024);
+
+    if (!setupSocket())
+        return;
+
+#if defined(__linux__)
+    int enable = 1;
+
+    if (setsockopt(socket_.native_handle(), SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0)
+        logwrn << "UDPReceiver: ctor: kernel receive timestamps not available: " << strerror(errno);
+
+    batched_ = true;
+
+    slot_size_ = std::min(max_read_size_, (unsigned int) MAX_DATAGRAM_SIZE);
+    slab_.resize(BATCH_SIZE * slot_size_);
+    names_.resize(BATCH_SIZE * sizeof(sockaddr_storage));
+    controls_.resize(BATCH_SIZE * CMSG_SPACE(sizeof(timespec)));
+    batch_.reserve(BATCH_SIZE);
+#else
+    data_ = new char[max_read_size_];
+#endif
+
+    receiveNext();
+}
+
+UDPReceiver::~UDPReceiver()
+{
+    delete[] data_;
+}
+
+bool UDPReceiver::setupSocket()
 {
     // udp::endpoint(boost::asio::ip::address_v4::any(), port)
 
@@ -27,13 +85,10 @@ UDPReceiver::UDPReceiver(boost::asio::io_context& io_context, //const std::strin
 
     if (ec)
     {
-        logerr << "UDPReceiver: ctor: mcast address error " << ec.message();
-        return;
+        logerr << "UDPReceiver: setupSocket: mcast address error " << ec.message();
+        return false;
     }
 
-    assert (max_read_size_ > 1024);
-    data_ = new char[max_read_size_];
-
     //    boost::asio::ip::address listen_addr = boost::asio::ip::address::from_string(address_listen, ec);
     bool has_listen_address = line_info_->hasListenIP();
     boost::asio::ip::address listen_addr;
@@ -44,8 +99,8 @@ UDPReceiver::UDPReceiver(boost::asio::io_context& io_context, //const std::strin
 
         if (ec)
         {
-            logerr << "UDPReceiver: ctor: listen address error " << ec.message();
-            return;
+            logerr << "UDPReceiver: setupSocket: listen address error " << ec.message();
+            return false;
         }
 
         //socket_endpoint_ = boost::asio::ip::udp::endpoint (listen_addr, line_info_->mcastPort());
@@ -58,24 +113,29 @@ UDPReceiver::UDPReceiver(boost::asio::io_context& io_context, //const std::strin
     socket_.open(socket_endpoint_.protocol(), ec);
     if (ec)
     {
-        logerr << "UDPReceiver: ctor: socket error " << ec.message();
-        return;
+        logerr << "UDPReceiver: setupSocket: socket error " << ec.message();
+        return false;
     }
 
     //    socket.set_option(boost::asio::ip::udp::socket::reuse_address(true), ec);
     socket_.set_option(boost::asio::ip::udp::socket::reuse_address(true), ec);
     if (ec)
     {
-        logerr << "UDPReceiver: ctor: socket reuse error " << ec.message();
-        return;
+        logerr << "UDPReceiver: setupSocket: socket reuse error " << ec.message();
+        return false;
     }
 
+    // larger kernel buffer for bursts, limited by net.core.rmem_max
+    socket_.set_option(boost::asio::socket_base::receive_buffer_size(RECEIVE_BUFFER_SIZE), ec);
+    if (ec)
+        logwrn << "UDPReceiver: setupSocket: socket receive buffer size error " << ec.message();
+
     //    socket.bind(listen_endpoint, ec);
     socket_.bind(socket_endpoint_, ec);
     if (ec)
     {
-        logerr << "UDPReceiver: ctor: socket bind error " << ec.message();
-        return;
+        logerr << "UDPReceiver: setupSocket: socket bind error " << ec.message();
+        return false;
     }
 
     //    socket.set_option(boost::asio::ip::multicast::join_group(mcast_addr.to_v4(), listen_addr.to_v4()), ec);
@@ -90,8 +150,8 @@ UDPReceiver::UDPReceiver(boost::asio::io_context& io_context, //const std::strin
                                    mcast_addr.to_v4()), ec);
         if (ec)
         {
-            logerr << "UDPReceiver: ctor: socket join group error " << ec.message();
-            return;
+            logerr << "UDPReceiver: setupSocket: socket join group error " << ec.message();
+            return false;
         }
     }
 
@@ -101,18 +161,14 @@ UDPReceiver::UDPReceiver(boost::asio::io_context& io_context, //const std::strin
 
         if (ec)
         {
-            logerr << "UDPReceiver: ctor: sender address error " << ec.message();
-            return;
+            logerr << "UDPReceiver: setupSocket: sender address error " << ec.message();
+            return false;
         }
 
         has_sender_address_ = true;
     }
 
-    socket_.async_receive_from(
-                boost::asio::buffer(data_, max_read_size_), sender_endpoint_,
-                boost::bind(&UDPReceiver::handle_receive_from, this,
-                            boost::asio::placeholders::error,
-                            boost::asio::placeholders::bytes_transferred));
+    return true;
 }
 
 void UDPReceiver::handle_receive_from(const boost::system::error_code& error,
@@ -129,21 +185,144 @@ void UDPReceiver::handle_receive_from(const boost::system::error_code& error,
     }
     else
     {
-        if (has_sender_address_) // check
+        // accept all if no sender address set
+        if (!has_sender_address_ || sender_endpoint_.address() == sender_addr_)
         {
-            //sender_endpoint_.address().to_string()+":"+to_string(sender_endpoint_.port()),
-            if (sender_endpoint_.address() == sender_addr_)
-                data_callback_(data_, bytes_recvd);
+            batch_.resize(1);
+            batch_.at(0).data = data_;
+            batch_.at(0).length = bytes_recvd;
+
+            ++num_batches_;
+            ++num_datagrams_;
+
+            batch_callback_(batch_);
         }
-        else // accept all
-            data_callback_(data_, bytes_recvd);
     }
 
     //sender_endpoint_.address() should be set to sender ip
 
+    receiveNext();
+}
+
+void UDPReceiver::handle_wait(const boost::system::error_code& error)
+{
+    if (error)
+    {
+        logerr << "UDPReceiver: handle_wait: error " << error;
+        return;
+    }
+
+    receiveBatches();
+
+    receiveNext();
+}
+
+void UDPReceiver::receiveNext()
+{
+    if (batched_)
+    {
+        socket_.async_wait(boost::asio::ip::udp::socket::wait_read,
+                           boost::bind(&UDPReceiver::handle_wait, this,
+                                       boost::asio::placeholders::error));
+        return;
+    }
+
     socket_.async_receive_from(
                 boost::asio::buffer(data_, max_read_size_), sender_endpoint_,
                 boost::bind(&UDPReceiver::handle_receive_from, this,
                             boost::asio::placeholders::error,
                             boost::asio::placeholders::bytes_transferred));
 }
+
+void UDPReceiver::receiveBatches()
+{
+#if defined(__linux__)
+    const unsigned int name_size = sizeof(sockaddr_storage);
+    const unsigned int control_size = CMSG_SPACE(sizeof(timespec));
+
+    mmsghdr msgs[BATCH_SIZE];
+    iovec iovs[BATCH_SIZE];
+
+    boost::asio::ip::udp::endpoint sender_endpoint;
+    int num_received;
+
+    for (unsigned int batch_cnt=0; batch_cnt < MAX_BATCHES_PER_WAIT; ++batch_cnt)
+    {
+        memset(msgs, 0, sizeof(msgs));
+
+        for (unsigned int cnt=0; cnt < BATCH_SIZE; ++cnt)
+        {
+            iovs[cnt].iov_base = &slab_[cnt * slot_size_];
+            iovs[cnt].iov_len = slot_size_;
+
+            msgs[cnt].msg_hdr.msg_iov = &iovs[cnt];
+            msgs[cnt].msg_hdr.msg_iovlen = 1;
+            msgs[cnt].msg_hdr.msg_name = &names_[cnt * name_size];
+            msgs[cnt].msg_hdr.msg_namelen = name_size;
+            msgs[cnt].msg_hdr.msg_control = &controls_[cnt * control_size];
+            msgs[cnt].msg_hdr.msg_controllen = control_size;
+        }
+
+        num_received = recvmmsg(socket_.native_handle(), msgs, BATCH_SIZE, MSG_DONTWAIT, nullptr);
+
+        if (num_received < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                logerr << "UDPReceiver: receiveBatches: receive error " << strerror(errno);
+
+            return;
+        }
+
+        batch_.clear();
+
+        for (int cnt=0; cnt < num_received; ++cnt)
+        {
+            msghdr& hdr = msgs[cnt].msg_hdr;
+
+            if (has_sender_address_) // check
+            {
+                if (hdr.msg_namelen > sender_endpoint.capacity())
+                    continue;
+
+                memcpy(sender_endpoint.data(), hdr.msg_name, hdr.msg_namelen);
+                sender_endpoint.resize(hdr.msg_namelen);
+
+                if (sender_endpoint.address() != sender_addr_)
+                    continue;
+            }
+
+            if (hdr.msg_flags & MSG_TRUNC)
+                logwrn << "UDPReceiver: receiveBatches: datagram truncated to " << slot_size_ << " bytes";
+
+            UDPDatagram datagram;
+            datagram.data = &slab_[cnt * slot_size_];
+            datagram.length = msgs[cnt].msg_len;
+
+            for (cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(&hdr, cmsg))
+            {
+                if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+                {
+                    timespec ts;
+                    memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+
+                    datagram.receive_time = boost::posix_time::from_time_t(ts.tv_sec)
+                            + boost::posix_time::microseconds(ts.tv_nsec / 1000);
+                }
+            }
+
+            batch_.push_back(datagram);
+        }
+
+        if (batch_.size())
+        {
+            ++num_batches_;
+            num_datagrams_ += batch_.size();
+
+            batch_callback_(batch_);
+        }
+
+        if (num_received < (int) BATCH_SIZE) // all available read
+            return;
+    }
+#endif
+}
@@ -4,18 +4,47 @@
 #include "datasourcelineinfo.h"
 
 #include <boost/asio.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
 
+#include <vector>
+
+// one received datagram, data only valid during batch callback
+struct UDPDatagram
+{
+    const char* data {nullptr};
+    unsigned int length {0};
+    boost::posix_time::ptime receive_time; // kernel receive time (UTC), not_a_date_time if not available
+};
+
+/**
+ * @brief Receives datagrams of a data source line
+ *
+ * On Linux, all datagrams available on the socket are read in batches with recvmmsg into a slab
+ * allocated once on construction, together with their kernel receive timestamps. Each batch is handed
+ * to the batch callback at once. On other platforms, each datagram is received separately and handed
+ * over as a batch of one.
+ */
 class UDPReceiver
 {
 public:
     UDPReceiver(boost::asio::io_context& io_context, std::shared_ptr<DataSourceLineInfo> line_info,
                 std::function<void(const char*, unsigned int)> data_callback, unsigned int max_read_size);
-
+    UDPReceiver(boost::asio::io_context& io_context, std::shared_ptr<DataSourceLineInfo> line_info,
+                std::function<void(const std::vector<UDPDatagram>&)> batch_callback,
+                unsigned int max_read_size);
+    virtual ~UDPReceiver();
 
     void handle_receive_from(const boost::system::error_code& error,
                              size_t bytes_recvd);
+    void handle_wait(const boost::system::error_code& error);
+
+    size_t numBatches() const { return num_batches_; }
+    size_t numDatagrams() const { return num_datagrams_; }
 
 private:
+    static const unsigned int BATCH_SIZE = 64; // max number of datagrams read in one system call
+    static const unsigned int MAX_DATAGRAM_SIZE = 65536;
+
     std::shared_ptr<DataSourceLineInfo> line_info_;
 
     boost::asio::ip::udp::endpoint socket_endpoint_;
@@ -25,10 +54,25 @@ private:
     bool has_sender_address_ {false};
     boost::asio::ip::address sender_addr_;
 
-    std::function<void(const char*, unsigned int)> data_callback_; // const std::string&,
+    std::function<void(const std::vector<UDPDatagram>&)> batch_callback_;
 
     unsigned int max_read_size_ {0};
     char* data_ {nullptr};
+
+    bool batched_ {false};
+    unsigned int slot_size_ {0}; // size of one datagram slot in slab
+    std::vector<char> slab_; // BATCH_SIZE slots
+    std::vector<char> names_; // sender addresses, per slot
+    std::vector<char> controls_; // control messages (timestamps), per slot
+    std::vector<UDPDatagram> batch_;
+
+    size_t num_batches_ {0};
+    size_t num_datagrams_ {0};
+
+    bool setupSocket();
+
+    void receiveNext();
+    void receiveBatches();
 };
 
 #endif // UDPRECEIVER_H
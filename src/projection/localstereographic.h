@@ -0,0 +1,187 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LOCALSTEREOGRAPHIC_H
+#define LOCALSTEREOGRAPHIC_H
+
+#include <cmath>
+#include <cstddef>
+
+/**
+ * @brief Closed-form WGS84 stereographic projection around a local origin
+ *
+ * Same projection as an OGRSpatialReference with SetStereographic(lat0, long0, 1.0, 0.0, 0.0) on
+ * WGS84 (the ellipsoidal oblique stereographic of PROJ's "stere", via the conformal latitude), so
+ * results match the OGR transformations it replaces. Setting a new origin only computes a few
+ * constants, no heap allocation is involved.
+ *
+ * Coordinates are in degrees, cartesian offsets in meters, x east and y north. The polar aspects are
+ * not supported, valid() is false for origins within 1e-6 degrees of a pole.
+ */
+class LocalStereographic
+{
+  public:
+    LocalStereographic() {}
+    LocalStereographic(double lat0, double long0) { origin(lat0, long0); }
+
+    void origin(double lat0, double long0)
+    {
+        lat0_ = lat0;
+        long0_ = long0;
+
+        double phi0 = lat0 * DEG2RAD;
+        double sin_phi0 = std::sin(phi0);
+        double chi0 = conformalLatitude(phi0, sin_phi0);
+
+        sin_chi0_ = std::sin(chi0);
+        cos_chi0_ = std::cos(chi0);
+
+        double t = E * sin_phi0;
+        akm1_ = 2.0 * std::cos(phi0) / std::sqrt(1.0 - t * t);
+
+        valid_ = std::fabs(lat0) < 90.0 - 1e-6;
+    }
+
+    double latitude0() const { return lat0_; }
+    double longitude0() const { return long0_; }
+
+    bool valid() const { return valid_; }
+
+    // false if not valid or position is the antipode of the origin
+    bool wgs2Cart(double lat, double lon, double& x, double& y) const
+    {
+        double phi = lat * DEG2RAD;
+        double lam = (lon - long0_) * DEG2RAD;
+
+        double chi = conformalLatitude(phi, std::sin(phi));
+        double sin_chi = std::sin(chi);
+        double cos_chi = std::cos(chi);
+        double cos_lam = std::cos(lam);
+
+        double denom = cos_chi0_ * (1.0 + sin_chi0_ * sin_chi + cos_chi0_ * cos_chi * cos_lam);
+
+        if (!valid_ || std::fabs(denom) < 1e-15)
+            return false;
+
+        double a = A * akm1_ / denom;
+
+        x = a * cos_chi * std::sin(lam);
+        y = a * (cos_chi0_ * sin_chi - sin_chi0_ * cos_chi * cos_lam);
+
+        return true;
+    }
+
+    // false if not valid or latitude iteration did not converge
+    bool cart2WGS(double x, double y, double& lat, double& lon) const
+    {
+        if (!valid_)
+            return false;
+
+        x /= A;
+        y /= A;
+
+        double rho = std::hypot(x, y);
+        double tp = 2.0 * std::atan2(rho * cos_chi0_, akm1_);
+        double cos_tp = std::cos(tp);
+        double sin_tp = std::sin(tp);
+
+        double phi_l;
+
+        if (rho == 0.0)
+            phi_l = std::asin(cos_tp * sin_chi0_);
+        else
+            phi_l = std::asin(cos_tp * sin_chi0_ + (y * sin_tp * cos_chi0_ / rho));
+
+        tp = std::tan(0.5 * (HALF_PI + phi_l));
+        x *= sin_tp;
+        y = rho * cos_chi0_ * cos_tp - y * sin_chi0_ * sin_tp;
+
+        double phi, sin_phi;
+
+        for (unsigned int cnt = 0; cnt < MAX_ITERATIONS; ++cnt)
+        {
+            sin_phi = E * std::sin(phi_l);
+            phi = 2.0 * std::atan(tp * std::pow((1.0 + sin_phi) / (1.0 - sin_phi), 0.5 * E)) - HALF_PI;
+
+            if (std::fabs(phi_l - phi) < 1e-12)
+            {
+                lat = phi * RAD2DEG;
+                lon = long0_ + ((x == 0.0 && y == 0.0) ? 0.0 : std::atan2(x, y) * RAD2DEG);
+
+                if (lon > 180.0)
+                    lon -= 360.0;
+                else if (lon < -180.0)
+                    lon += 360.0;
+
+                return true;
+            }
+
+            phi_l = phi;
+        }
+
+        return false;
+    }
+
+    // batch variants, arrays of size num, return true if all positions ok
+    bool wgs2Cart(const double* lat, const double* lon, double* x, double* y, size_t num) const
+    {
+        bool ok = true;
+
+        for (size_t cnt = 0; cnt < num; ++cnt)
+            ok &= wgs2Cart(lat[cnt], lon[cnt], x[cnt], y[cnt]);
+
+        return ok;
+    }
+
+    bool cart2WGS(const double* x, const double* y, double* lat, double* lon, size_t num) const
+    {
+        bool ok = true;
+
+        for (size_t cnt = 0; cnt < num; ++cnt)
+            ok &= cart2WGS(x[cnt], y[cnt], lat[cnt], lon[cnt]);
+
+        return ok;
+    }
+
+  protected:
+    // WGS84 semi-major axis and eccentricity
+    static constexpr double A = 6378137.0;
+    static constexpr double E = 0.0818191908426215;
+
+    static constexpr double HALF_PI = M_PI / 2.0;
+    static constexpr double DEG2RAD = M_PI / 180.0;
+    static constexpr double RAD2DEG = 180.0 / M_PI;
+
+    static constexpr unsigned int MAX_ITERATIONS = 15;
+
+    double lat0_ {0};
+    double long0_ {0};
+
+    bool valid_ {false};
+
+    double sin_chi0_ {0};
+    double cos_chi0_ {1};
+    double akm1_ {2.0};
+
+    static double conformalLatitude(double phi, double sin_phi)
+    {
+        return 2.0 * std::atan(std::tan(0.5 * (HALF_PI + phi))
+                               * std::pow((1.0 - E * sin_phi) / (1.0 + E * sin_phi), 0.5 * E)) - HALF_PI;
+    }
+};
+
+#endif // LOCALSTEREOGRAPHIC_H
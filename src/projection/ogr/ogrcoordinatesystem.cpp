@@ -142,6 +142,41 @@ bool OGRCoordinateSystem::cartesian2WGS84(double x_pos, double y_pos, double& la
     return ret;
 }
 
+size_t OGRCoordinateSystem::cartesian2WGS84(std::vector<double>& x_pos_m_longitude_deg,
+                                            std::vector<double>& y_pos_m_latitude_deg,
+                                            std::vector<bool>& ok)
+{
+    size_t num = x_pos_m_longitude_deg.size();
+
+    assert (y_pos_m_latitude_deg.size() == num);
+    assert (ok.size() == num);
+
+    if (!num)
+        return 0;
+
+    std::vector<int> success (num, 0);
+
+    ogr_cart2geo_->Transform(num, x_pos_m_longitude_deg.data(), y_pos_m_latitude_deg.data(), nullptr,
+                             success.data());
+
+    size_t num_errors = 0;
+
+    for (size_t cnt = 0; cnt < num; ++cnt)
+    {
+        if (!success[cnt])
+        {
+            ok[cnt] = false;
+            ++num_errors;
+        }
+    }
+
+    if (num_errors)
+        logerr << "OGRCoordinateSystem: cartesian2WGS84: " << num_errors << " errors in " << num
+               << " positions";
+
+    return num_errors;
+}
+
 double OGRCoordinateSystem::getRadiusAt(double latitude_rad)
 {
     // see https://en.wikipedia.org/wiki/Reference_ellipsoid
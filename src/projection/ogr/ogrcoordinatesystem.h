@@ -21,6 +21,7 @@
 #include <ogr_spatialref.h>
 
 #include <memory>
+#include <vector>
 
 // class OGRProjection;
 
@@ -43,6 +44,10 @@ class OGRCoordinateSystem
     /// @brief Projects cartesian coordinate to geo-coordinate in WGS-84, returns false on error
     bool cartesian2WGS84(double x_pos_m, double y_pos_m, double& latitude_deg,
                          double& longitude_deg);
+    /// @brief Projects cartesian coordinates to geo-coordinates in WGS-84 in one transformation call,
+    /// in place (x to longitude, y to latitude). Clears ok flag of failed positions, returns number of them
+    size_t cartesian2WGS84(std::vector<double>& x_pos_m_longitude_deg,
+                           std::vector<double>& y_pos_m_latitude_deg, std::vector<bool>& ok);
 
   protected:
     unsigned int id_{0};
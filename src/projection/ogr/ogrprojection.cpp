@@ -22,6 +22,8 @@
 #include "ogrcoordinatesystem.h"
 #include "projectionmanager.h"
 
+#include <algorithm>
+
 //#include "cpl_conv.h"
 
 OGRProjection::OGRProjection(const std::string& class_id, const std::string& instance_id,
@@ -99,3 +101,24 @@ bool OGRProjection::polarToWGS84(unsigned int id, double azimuth_rad, double sla
 
     return ret;
 }
+
+void OGRProjection::polarToWGS84Batch(PolarPositionBatch& batch)
+{
+    assert(hasCoordinateSystem(batch.id_));
+
+    OGRCoordinateSystem& coord_sys = *coordinate_systems_.at(batch.id_);
+
+    // cartesian positions are stored in longitudes/latitudes, transformed in place afterwards
+    for (size_t cnt = 0; cnt < batch.size(); ++cnt)
+    {
+        batch.ok_[cnt] = coord_sys.polarSlantToCartesian(
+                    batch.azimuths_rad_[cnt], batch.slant_ranges_m_[cnt], batch.has_baro_altitudes_[cnt],
+                    batch.baro_altitudes_ft_[cnt] * FT2M, batch.longitudes_[cnt], batch.latitudes_[cnt]);
+    }
+
+    coord_sys.cartesian2WGS84(batch.longitudes_, batch.latitudes_, batch.ok_);
+
+    // TODO altitude
+
+    batch.num_errors_ = std::count(batch.ok_.begin(), batch.ok_.end(), false);
+}
@@ -45,6 +45,8 @@ class OGRProjection : public Projection
     std::map<unsigned int, std::unique_ptr<OGRCoordinateSystem>> coordinate_systems_;
 
     virtual void checkSubConfigurables() override;
+
+    virtual void polarToWGS84Batch(PolarPositionBatch& batch) override;
 };
 
 #endif  // OGRPROJECTION_H
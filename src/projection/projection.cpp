@@ -19,6 +19,7 @@
 
 #include "logger.h"
 #include "projectionmanager.h"
+#include "util/tbbhack.h"
 
 Projection::Projection(const std::string& class_id, const std::string& instance_id,
                        ProjectionManager& proj_manager)
@@ -38,6 +39,42 @@ void Projection::generateSubConfigurable(const std::string& class_id,
 {
 }
 
+void Projection::polarToWGS84Batches(std::vector<PolarPositionBatch>& batches)
+{
+    for (auto& batch_it : batches)
+    {
+        assert (hasCoordinateSystem(batch_it.id_));
+        batch_it.prepareResults();
+    }
+
+    tbb::parallel_for(size_t(0), batches.size(), [&](size_t batch_cnt)
+    {
+        polarToWGS84Batch(batches[batch_cnt]);
+    });
+}
+
+void Projection::polarToWGS84Batch(PolarPositionBatch& batch)
+{
+    double lat, lon;
+    bool ok;
+
+    for (size_t cnt = 0; cnt < batch.size(); ++cnt)
+    {
+        ok = polarToWGS84(batch.id_, batch.azimuths_rad_[cnt], batch.slant_ranges_m_[cnt],
+                          batch.has_baro_altitudes_[cnt], batch.baro_altitudes_ft_[cnt], lat, lon);
+
+        batch.ok_[cnt] = ok;
+
+        if (ok)
+        {
+            batch.latitudes_[cnt] = lat;
+            batch.longitudes_[cnt] = lon;
+        }
+        else
+            ++batch.num_errors_;
+    }
+}
+
 std::string Projection::name() const { return name_; }
 
 void Projection::name(const std::string& name) { name_ = name; }
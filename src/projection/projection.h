@@ -20,8 +20,54 @@
 
 #include "configurable.h"
 
+#include <vector>
+
 class ProjectionManager;
 
+/**
+ * @brief Polar positions of one coordinate system (data source) for batch conversion, with results
+ */
+class PolarPositionBatch
+{
+  public:
+    PolarPositionBatch(unsigned int id) : id_(id) {}
+
+    unsigned int id_ {0}; // coordinate system id
+
+    std::vector<unsigned int> indexes_; // index of each position in its source, not used in conversion
+    std::vector<double> azimuths_rad_;
+    std::vector<double> slant_ranges_m_;
+    std::vector<bool> has_baro_altitudes_;
+    std::vector<double> baro_altitudes_ft_;
+
+    // results, set in conversion
+    std::vector<double> latitudes_;
+    std::vector<double> longitudes_;
+    std::vector<bool> ok_;
+    size_t num_errors_ {0};
+
+    void add(unsigned int index, double azimuth_rad, double slant_range_m, bool has_baro_altitude,
+             double baro_altitude_ft)
+    {
+        indexes_.push_back(index);
+        azimuths_rad_.push_back(azimuth_rad);
+        slant_ranges_m_.push_back(slant_range_m);
+        has_baro_altitudes_.push_back(has_baro_altitude);
+        baro_altitudes_ft_.push_back(baro_altitude_ft);
+    }
+
+    size_t size() const { return indexes_.size(); }
+
+    // sizes result vectors
+    void prepareResults()
+    {
+        latitudes_.assign(size(), 0);
+        longitudes_.assign(size(), 0);
+        ok_.assign(size(), false);
+        num_errors_ = 0;
+    }
+};
+
 class Projection : public Configurable
 {
   public:
@@ -40,6 +86,9 @@ class Projection : public Configurable
                               bool has_baro_altitude, double baro_altitude_ft, double& latitude,
                               double& longitude) = 0;
 
+    // converts all batches, in parallel with one task per batch. coordinate systems must exist
+    void polarToWGS84Batches(std::vector<PolarPositionBatch>& batches);
+
     std::string name() const;
     void name(const std::string& name);
 
@@ -49,6 +98,10 @@ class Projection : public Configurable
     std::string name_;
 
     virtual void checkSubConfigurables();
+
+    // converts one batch, default calls polarToWGS84 per position. called concurrently for different
+    // coordinate systems
+    virtual void polarToWGS84Batch(PolarPositionBatch& batch);
 };
 
 #endif  // PROJECTION_H
@@ -59,6 +59,40 @@ bool RS2GProjection::polarToWGS84(unsigned int id, double azimuth_rad, double sl
 {
     assert(hasCoordinateSystem(id));
 
+    return polarToWGS84(*coordinate_systems_.at(id), azimuth_rad, slant_range_m, has_baro_altitude,
+                        baro_altitude_ft, latitude, longitude);
+}
+
+void RS2GProjection::polarToWGS84Batch(PolarPositionBatch& batch)
+{
+    assert(hasCoordinateSystem(batch.id_));
+
+    RS2GCoordinateSystem& coord_sys = *coordinate_systems_.at(batch.id_);
+
+    double lat, lon;
+    bool ok;
+
+    for (size_t cnt = 0; cnt < batch.size(); ++cnt)
+    {
+        ok = polarToWGS84(coord_sys, batch.azimuths_rad_[cnt], batch.slant_ranges_m_[cnt],
+                          batch.has_baro_altitudes_[cnt], batch.baro_altitudes_ft_[cnt], lat, lon);
+
+        batch.ok_[cnt] = ok;
+
+        if (ok)
+        {
+            batch.latitudes_[cnt] = lat;
+            batch.longitudes_[cnt] = lon;
+        }
+        else
+            ++batch.num_errors_;
+    }
+}
+
+bool RS2GProjection::polarToWGS84(RS2GCoordinateSystem& coord_sys, double azimuth_rad,
+                                  double slant_range_m, bool has_baro_altitude,
+                                  double baro_altitude_ft, double& latitude, double& longitude)
+{
     double x1, y1, z1;
     bool ret;
 
@@ -74,8 +108,7 @@ bool RS2GProjection::polarToWGS84(unsigned int id, double azimuth_rad, double sl
 
     logdbg << "RS2GProjection: polarToWGS84: local x " << x1 << " y " << y1 << " z " << z1;
 
-    ret =
-        coordinate_systems_.at(id)->calculateRadSlt2Geocentric(x1, y1, z1, pos, has_baro_altitude);
+    ret = coord_sys.calculateRadSlt2Geocentric(x1, y1, z1, pos, has_baro_altitude);
 
     if (ret)
     {
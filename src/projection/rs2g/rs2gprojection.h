@@ -45,6 +45,12 @@ class RS2GProjection : public Projection
     std::map<unsigned int, std::unique_ptr<RS2GCoordinateSystem>> coordinate_systems_;
 
     virtual void checkSubConfigurables() override;
+
+    virtual void polarToWGS84Batch(PolarPositionBatch& batch) override;
+
+    static bool polarToWGS84(RS2GCoordinateSystem& coord_sys, double azimuth_rad, double slant_range_m,
+                             bool has_baro_altitude, double baro_altitude_ft, double& latitude,
+                             double& longitude);
 };
 
 #endif  // RS2GPROJECTION_H
@@ -1,22 +1,12 @@
 #include "transformation.h"
 #include "logger.h"
-#include "compass.h"
 
-#include <ogr_spatialref.h>
+#include <cmath>
 
-bool Transformation::in_appimage_ = COMPASS::isAppImage();
 const double Transformation::max_wgs_dist_ {0.5};
 
 Transformation::Transformation()
-    : wgs84_{new OGRSpatialReference()}, local_{new OGRSpatialReference()}
 {
-    wgs84_->SetWellKnownGeogCS("WGS84");
-}
-
-Transformation::Transformation (const Transformation& a)
-    : wgs84_{new OGRSpatialReference()}, local_{new OGRSpatialReference()}
-{
-    wgs84_->SetWellKnownGeogCS("WGS84");
 }
 
 
@@ -33,44 +23,15 @@ std::tuple<bool, double, double> Transformation::distanceCart (double lat1, doub
     updateIfRequired(lat1, long1);
 
     double x_pos1, y_pos1, x_pos2, y_pos2;
-    bool ok;
     std::tuple<bool, double, double> ret {false, 0, 0};
 
-    if (in_appimage_) // inside appimage
-    {
-        x_pos1 = long1;
-        y_pos1 = lat1;
-
-        x_pos2 = long2;
-        y_pos2 = lat2;
-    }
-    else
-    {
-        x_pos1 = lat1;
-        y_pos1 = long1;
-
-        x_pos2 = lat2;
-        y_pos2 = long2;
-    }
-
-    ok = ogr_geo2cart_->Transform(1, &x_pos1, &y_pos1); // wgs84 to cartesian offsets
-
-    if (!ok)
-    {
+    if (!local_.wgs2Cart(lat1, long1, x_pos1, y_pos1)) // wgs84 to cartesian offsets
         return ret;
-    }
-
-    ok = ogr_geo2cart_->Transform(1, &x_pos2, &y_pos2); // wgs84 to cartesian offsets
 
-    if (!ok)
-    {
+    if (!local_.wgs2Cart(lat2, long2, x_pos2, y_pos2)) // wgs84 to cartesian offsets
         return ret;
-    }
 
-//    if (in_appimage_) // inside appimage
-//        ret = std::tuple<bool, double, double>(true, y_pos2-y_pos1, x_pos2-x_pos1);
-//    else
-        ret = std::tuple<bool, double, double>(true, x_pos2-x_pos1, y_pos2-y_pos1);
+    ret = std::tuple<bool, double, double>(true, x_pos2-x_pos1, y_pos2-y_pos1);
 
     logdbg << "Transformation: distanceCart: x_pos1 " << x_pos1 << " y_pos1 " << y_pos1
            << " x_pos2 " << x_pos2 << " y_pos2 " << y_pos2;
@@ -86,30 +47,13 @@ std::tuple<bool, double, double> Transformation::wgsAddCartOffset (
 
     updateIfRequired(lat1, long1);
 
-    bool ok;
     std::tuple<bool, double, double> ret {false, 0, 0};
 
     // calc pos 1 cart
     double x_pos1, y_pos1;
 
-    if (in_appimage_) // inside appimage
-    {
-        x_pos1 = long1;
-        y_pos1 = lat1;
-    }
-    else
-    {
-        x_pos1 = lat1;
-        y_pos1 = long1;
-    }
-
-    ok = ogr_geo2cart_->Transform(1, &x_pos1, &y_pos1); // wgs84 to cartesian offsets
-
-    if (!ok)
-    {
-        //loginf << "UGA1";
+    if (!local_.wgs2Cart(lat1, long1, x_pos1, y_pos1)) // wgs84 to cartesian offsets
         return ret;
-    }
 
     logdbg << "Transformation: wgsAddCartOffset: x_pos1 " << x_pos1 << " y_pos1 " << y_pos1
            << " x_pos2 " << x_pos2 << " y_pos2 " << y_pos2;
@@ -118,26 +62,10 @@ std::tuple<bool, double, double> Transformation::wgsAddCartOffset (
     x_pos2 += x_pos1;
     y_pos2 += y_pos1;
 
-    ok = ogr_cart2geo_->Transform(1, &x_pos2, &y_pos2);
-
-    if (!ok)
-    {
-        //loginf << "UGA2";
-        return ret;
-    }
-
     double lat2, long2;
 
-    if (in_appimage_) // inside appimage
-    {
-        lat2 = y_pos2;
-        long2 = x_pos2;
-    }
-    else
-    {
-        lat2 = x_pos2;
-        long2 = y_pos2;
-    }
+    if (!local_.cart2WGS(x_pos2, y_pos2, lat2, long2))
+        return ret;
 
     ret = std::tuple<bool, double, double>(true, lat2, long2);
 
@@ -152,27 +80,16 @@ void Transformation::updateIfRequired(double lat1, double long1)
         lat1_ = lat1;
         long1_ = long1;
 
-        local_->SetStereographic(lat1_, long1_, 1.0, 0.0, 0.0);
-
-        ogr_geo2cart_.reset(OGRCreateCoordinateTransformation(wgs84_.get(), local_.get()));
-        ogr_cart2geo_.reset(OGRCreateCoordinateTransformation(local_.get(), wgs84_.get()));
+        local_.origin(lat1_, long1_);
     }
 }
 
 
 //////////////////////////////////////////////
-bool FixedTransformation::in_appimage_ = COMPASS::isAppImage();
-const double FixedTransformation::max_wgs_dist_ {0.5};
 
 FixedTransformation::FixedTransformation(double lat1, double long1)
-    : wgs84_{new OGRSpatialReference()}, local_{new OGRSpatialReference()}
+    : local_(lat1, long1)
 {
-    wgs84_->SetWellKnownGeogCS("WGS84");
-
-    local_->SetStereographic(lat1, long1, 1.0, 0.0, 0.0);
-
-    ogr_geo2cart_.reset(OGRCreateCoordinateTransformation(wgs84_.get(), local_.get()));
-    ogr_cart2geo_.reset(OGRCreateCoordinateTransformation(local_.get(), wgs84_.get()));
 }
 
 FixedTransformation::~FixedTransformation()
@@ -184,26 +101,10 @@ std::tuple<bool, double, double> FixedTransformation::distanceCart (double lat2,
     logdbg << "FixedTransformation: distanceCart: lat2 " << lat2 << " long2 " << long2;
 
     double x_pos2, y_pos2;
-    bool ok;
     std::tuple<bool, double, double> ret {false, 0, 0};
 
-    if (in_appimage_) // inside appimage
-    {
-        x_pos2 = long2;
-        y_pos2 = lat2;
-    }
-    else
-    {
-        x_pos2 = lat2;
-        y_pos2 = long2;
-    }
-
-    ok = ogr_geo2cart_->Transform(1, &x_pos2, &y_pos2); // wgs84 to cartesian offsets
-
-    if (!ok)
-    {
+    if (!local_.wgs2Cart(lat2, long2, x_pos2, y_pos2)) // wgs84 to cartesian offsets
         return ret;
-    }
 
     ret = std::tuple<bool, double, double>(true, x_pos2, y_pos2);
 
@@ -216,33 +117,14 @@ std::tuple<bool, double, double> FixedTransformation::wgsAddCartOffset (double x
 {
     logdbg << "FixedTransformation: wgsAddCartOffset: x_pos2 " << x_pos2 << " y_pos2 " << y_pos2;
 
-    bool ok;
     std::tuple<bool, double, double> ret {false, 0, 0};
 
-    ok = ogr_cart2geo_->Transform(1, &x_pos2, &y_pos2);
-
-    if (!ok)
-    {
-        //loginf << "UGA2";
-        return ret;
-    }
-
     double lat2, long2;
 
-    if (in_appimage_) // inside appimage
-    {
-        lat2 = y_pos2;
-        long2 = x_pos2;
-    }
-    else
-    {
-        lat2 = x_pos2;
-        long2 = y_pos2;
-    }
+    if (!local_.cart2WGS(x_pos2, y_pos2, lat2, long2))
+        return ret;
 
     ret = std::tuple<bool, double, double>(true, lat2, long2);
 
     return ret;
 }
-
-
@@ -1,16 +1,14 @@
 #ifndef TRANSFORMATION_H
 #define TRANSFORMATION_H
 
-#include <memory>
+#include "localstereographic.h"
 
-class OGRSpatialReference;
-class OGRCoordinateTransformation;
+#include <tuple>
 
 class Transformation
 {
 public:
     Transformation();
-    Transformation (const Transformation& a); // only called during creation, slightly hacky
     virtual ~Transformation();
 
 
@@ -20,13 +18,9 @@ public:
     // ok, lat, long
 
 protected:
-    static bool in_appimage_;
     static const double max_wgs_dist_;
 
-    std::unique_ptr<OGRSpatialReference> wgs84_;
-    std::unique_ptr<OGRSpatialReference> local_;
-    std::unique_ptr<OGRCoordinateTransformation> ogr_geo2cart_;
-    std::unique_ptr<OGRCoordinateTransformation> ogr_cart2geo_;
+    LocalStereographic local_;
 
     bool has_pos1_ {false};
     double lat1_;
@@ -47,13 +41,7 @@ public:
     // ok, lat, long
 
 protected:
-    static bool in_appimage_;
-    static const double max_wgs_dist_;
-
-    std::unique_ptr<OGRSpatialReference> wgs84_;
-    std::unique_ptr<OGRSpatialReference> local_;
-    std::unique_ptr<OGRCoordinateTransformation> ogr_geo2cart_;
-    std::unique_ptr<OGRCoordinateTransformation> ogr_cart2geo_;
+    LocalStereographic local_;
 };
 
 #endif // TRANSFORMATION_H
@@ -0,0 +1,146 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "preparedpolygon.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace std;
+
+PreparedPolygon::PreparedPolygon(const std::vector<std::pair<double, double>>& points)
+{
+    prepare(points);
+}
+
+void PreparedPolygon::prepare(const std::vector<std::pair<double, double>>& points)
+{
+    edges_.clear();
+    band_offsets_.clear();
+    band_edges_.clear();
+
+    min_latitude_ = 1.0;
+    max_latitude_ = -1.0;
+    min_longitude_ = 1.0;
+    max_longitude_ = -1.0;
+
+    num_bands_ = 0;
+    band_scale_ = 0;
+
+    if (points.size() < 3)
+        return;
+
+    min_latitude_ = max_latitude_ = points.begin()->first;
+    min_longitude_ = max_longitude_ = points.begin()->second;
+
+    for (auto& point_it : points)
+    {
+        min_latitude_ = min(min_latitude_, point_it.first);
+        max_latitude_ = max(max_latitude_, point_it.first);
+        min_longitude_ = min(min_longitude_, point_it.second);
+        max_longitude_ = max(max_longitude_, point_it.second);
+    }
+
+    // ring is closed implicitly, edges of constant latitude never count as crossing
+    size_t num_points = points.size();
+
+    for (size_t cnt = 0; cnt < num_points; ++cnt)
+    {
+        const pair<double, double>& p1 = points.at(cnt);
+        const pair<double, double>& p2 = points.at((cnt + 1) % num_points);
+
+        if (p1.first == p2.first)
+            continue;
+
+        edges_.push_back({p1.first, p1.second, p2.first, p2.second});
+    }
+
+    num_bands_ = edges_.size();
+
+    if (num_bands_ > MAX_NUM_BANDS)
+        num_bands_ = MAX_NUM_BANDS;
+    if (!num_bands_)
+        num_bands_ = 1;
+
+    if (max_latitude_ > min_latitude_)
+        band_scale_ = num_bands_ / (max_latitude_ - min_latitude_);
+
+    // count edges per band, then fill
+    band_offsets_.assign(num_bands_ + 1, 0);
+
+    unsigned int band_min, band_max;
+
+    for (auto& edge_it : edges_)
+    {
+        band_min = band(min(edge_it.lat1, edge_it.lat2));
+        band_max = band(max(edge_it.lat1, edge_it.lat2));
+
+        for (unsigned int band_cnt = band_min; band_cnt <= band_max; ++band_cnt)
+            ++band_offsets_[band_cnt + 1];
+    }
+
+    for (unsigned int band_cnt = 0; band_cnt < num_bands_; ++band_cnt)
+        band_offsets_[band_cnt + 1] += band_offsets_[band_cnt];
+
+    band_edges_.resize(band_offsets_.back());
+
+    vector<unsigned int> band_fill (band_offsets_.begin(), band_offsets_.end() - 1);
+
+    for (unsigned int edge_cnt = 0; edge_cnt < edges_.size(); ++edge_cnt)
+    {
+        band_min = band(min(edges_[edge_cnt].lat1, edges_[edge_cnt].lat2));
+        band_max = band(max(edges_[edge_cnt].lat1, edges_[edge_cnt].lat2));
+
+        for (unsigned int band_cnt = band_min; band_cnt <= band_max; ++band_cnt)
+            band_edges_[band_fill[band_cnt]++] = edge_cnt;
+    }
+}
+
+bool PreparedPolygon::isInside(double latitude, double longitude) const
+{
+    if (!isInsideBoundingBox(latitude, longitude))
+        return false;
+
+    assert (num_bands_);
+
+    unsigned int band_index = band(latitude);
+    bool inside = false;
+
+    for (unsigned int cnt = band_offsets_[band_index]; cnt < band_offsets_[band_index + 1]; ++cnt)
+    {
+        const Edge& edge = edges_[band_edges_[cnt]];
+
+        if ((edge.lat1 > latitude) != (edge.lat2 > latitude)
+                && longitude < edge.lon1 + (latitude - edge.lat1) * (edge.lon2 - edge.lon1) / (edge.lat2 - edge.lat1))
+            inside = !inside;
+    }
+
+    return inside;
+}
+
+unsigned int PreparedPolygon::band(double latitude) const
+{
+    double band_pos = (latitude - min_latitude_) * band_scale_;
+
+    if (band_pos <= 0)
+        return 0;
+
+    if (band_pos >= num_bands_ - 1)
+        return num_bands_ - 1;
+
+    return static_cast<unsigned int>(band_pos);
+}
@@ -0,0 +1,78 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PREPAREDPOLYGON_H
+#define PREPAREDPOLYGON_H
+
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Point-in-polygon structure prepared once from a sector's (latitude, longitude) points
+ *
+ * Positions outside the bounding box are rejected directly. Otherwise the polygon edges are bucketed
+ * into latitude bands, so the crossing-number test only visits the edges spanning the band of the
+ * position instead of all edges.
+ */
+class PreparedPolygon
+{
+  public:
+    PreparedPolygon() {}
+    PreparedPolygon(const std::vector<std::pair<double, double>>& points);
+
+    void prepare(const std::vector<std::pair<double, double>>& points);
+
+    bool isInsideBoundingBox(double latitude, double longitude) const
+    {
+        return latitude >= min_latitude_ && latitude <= max_latitude_
+                && longitude >= min_longitude_ && longitude <= max_longitude_;
+    }
+
+    bool isInside(double latitude, double longitude) const;
+
+    double minLatitude() const { return min_latitude_; }
+    double maxLatitude() const { return max_latitude_; }
+    double minLongitude() const { return min_longitude_; }
+    double maxLongitude() const { return max_longitude_; }
+
+  protected:
+    static const unsigned int MAX_NUM_BANDS = 1024;
+
+    struct Edge
+    {
+        double lat1, lon1, lat2, lon2;
+    };
+
+    // empty polygon contains nothing
+    double min_latitude_ {1.0};
+    double max_latitude_ {-1.0};
+    double min_longitude_ {1.0};
+    double max_longitude_ {-1.0};
+
+    std::vector<Edge> edges_;
+
+    unsigned int num_bands_ {0};
+    double band_scale_ {0}; // bands per degree latitude
+
+    // edge indexes of band b are band_edges_[band_offsets_[b]] to band_edges_[band_offsets_[b+1]]
+    std::vector<unsigned int> band_offsets_;
+    std::vector<unsigned int> band_edges_;
+
+    unsigned int band(double latitude) const;
+};
+
+#endif // PREPAREDPOLYGON_H
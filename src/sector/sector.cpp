@@ -259,8 +259,7 @@ bool Sector::isInside(const EvaluationTargetPosition& pos, bool has_ground_bit,
     if (has_ground_bit && ground_bit_set && has_min_altitude_)
         return false;
 
-    OGRPoint ogr_pos (pos.latitude_, pos.longitude_);
-    return ogr_polygon_->Contains(&ogr_pos);
+    return polygon_.isInside(pos.latitude_, pos.longitude_);
 }
 
 
@@ -322,16 +321,5 @@ void Sector::exclude(bool value)
 
 void Sector::createPolygon()
 {
-    ogr_polygon_.reset(new OGRPolygon());
-    //ogr_polygon_->addRingDirectly()
-    OGRLinearRing* ring = new OGRLinearRing();
-
-    for (auto& point_it : points_)
-        ring->addPoint(point_it.first, point_it.second);
-
-    if (*points_.begin() != *points_.rbegin())
-        ring->addPoint(points_.begin()->first, points_.begin()->second); // close if not not closed
-
-    ogr_polygon_->addRingDirectly(ring);
+    polygon_.prepare(points_);
 }
-
@@ -19,11 +19,10 @@
 #define SECTOR_H
 
 #include "json.hpp"
+#include "preparedpolygon.h"
 
 #include <QColor>
 
-#include <ogr_geometry.h>
-
 #include <memory>
 
 class DBInterface;
@@ -73,6 +72,7 @@ public:
     void save();
 
     bool isInside(const EvaluationTargetPosition& pos, bool has_ground_bit, bool ground_bit_set) const;
+    const PreparedPolygon& polygon() const { return polygon_; }
 
     std::pair<double, double> getMinMaxLatitude() const;
     std::pair<double, double> getMinMaxLongitude() const;
@@ -93,7 +93,7 @@ protected:
     bool has_max_altitude_ {false};
     double max_altitude_{0.0};
 
-    std::unique_ptr<OGRPolygon> ogr_polygon_;
+    PreparedPolygon polygon_;
 
     void createPolygon();
 };
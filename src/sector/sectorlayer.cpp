@@ -20,6 +20,7 @@
 #include "evaluationtargetposition.h"
 #include "logger.h"
 
+#include <algorithm>
 #include <cassert>
 
 using namespace std;
@@ -49,7 +50,7 @@ void SectorLayer::addSector (std::shared_ptr<Sector> sector)
     assert (sector->layerName() == name_);
     sectors_.push_back(sector);
 
-    has_exclude_sector_ |= sector->exclude();
+    updateBounds();
 }
 
 std::shared_ptr<Sector> SectorLayer::sector (const std::string& name)
@@ -74,6 +75,8 @@ void SectorLayer::removeSector (std::shared_ptr<Sector> sector)
 
     sectors_.erase(iter);
     assert (!hasSector(sector->name()));
+
+    updateBounds();
 }
 
 bool SectorLayer::isInside(const EvaluationTargetPosition& pos,
@@ -82,6 +85,9 @@ bool SectorLayer::isInside(const EvaluationTargetPosition& pos,
     bool is_inside = false;
     bool is_inside_exclude = false;
 
+    if (!isInsideBoundingBox(pos))
+        return false;
+
     // check if inside normal ones
     for (auto& sec_it : sectors_)
     {
@@ -125,6 +131,79 @@ bool SectorLayer::isInside(const EvaluationTargetPosition& pos,
     return !is_inside_exclude; // true if in no exlcude, false if in include
 }
 
+std::vector<bool> SectorLayer::isInside(const std::vector<EvaluationTargetPosition>& positions,
+                                        const std::vector<bool>& has_ground_bits,
+                                        const std::vector<bool>& ground_bits_set) const
+{
+    assert (has_ground_bits.size() == positions.size());
+    assert (ground_bits_set.size() == positions.size());
+
+    size_t num_positions = positions.size();
+    vector<bool> inside (num_positions, false);
+
+    // indexes of positions still to be checked
+    vector<size_t> candidates;
+    candidates.reserve(num_positions);
+
+    for (size_t cnt = 0; cnt < num_positions; ++cnt)
+    {
+        if (isInsideBoundingBox(positions[cnt]))
+            candidates.push_back(cnt);
+    }
+
+    // sector by sector, positions found inside a normal one are not checked again
+    for (auto& sec_it : sectors_)
+    {
+        if (!candidates.size())
+            break;
+
+        if (sec_it->exclude())
+            continue;
+
+        auto not_inside_end = std::remove_if(candidates.begin(), candidates.end(),
+            [&](size_t index) {
+                if (!sec_it->isInside(positions[index], has_ground_bits[index], ground_bits_set[index]))
+                    return false;
+                inside[index] = true;
+                return true;
+            });
+
+        candidates.erase(not_inside_end, candidates.end());
+    }
+
+    if (!has_exclude_sector_)
+        return inside;
+
+    candidates.clear();
+
+    for (size_t cnt = 0; cnt < num_positions; ++cnt)
+    {
+        if (inside[cnt])
+            candidates.push_back(cnt);
+    }
+
+    for (auto& sec_it : sectors_)
+    {
+        if (!candidates.size())
+            break;
+
+        if (!sec_it->exclude())
+            continue;
+
+        auto not_inside_end = std::remove_if(candidates.begin(), candidates.end(),
+            [&](size_t index) {
+                if (!sec_it->isInside(positions[index], has_ground_bits[index], ground_bits_set[index]))
+                    return false;
+                inside[index] = false;
+                return true;
+            });
+
+        candidates.erase(not_inside_end, candidates.end());
+    }
+
+    return inside;
+}
+
 std::pair<double, double> SectorLayer::getMinMaxLatitude() const
 {
     double min, max;
@@ -176,3 +255,41 @@ std::pair<double, double> SectorLayer::getMinMaxLongitude() const
 
     return {min, max};
 }
+
+void SectorLayer::updateBounds()
+{
+    has_exclude_sector_ = false;
+
+    min_latitude_ = 1.0;
+    max_latitude_ = -1.0;
+    min_longitude_ = 1.0;
+    max_longitude_ = -1.0;
+
+    bool first = true;
+
+    for (auto& sec_it : sectors_)
+    {
+        has_exclude_sector_ |= sec_it->exclude();
+
+        const PreparedPolygon& polygon = sec_it->polygon();
+
+        if (polygon.minLatitude() > polygon.maxLatitude()) // empty
+            continue;
+
+        if (first)
+        {
+            min_latitude_ = polygon.minLatitude();
+            max_latitude_ = polygon.maxLatitude();
+            min_longitude_ = polygon.minLongitude();
+            max_longitude_ = polygon.maxLongitude();
+            first = false;
+        }
+        else
+        {
+            min_latitude_ = std::min(min_latitude_, polygon.minLatitude());
+            max_latitude_ = std::max(max_latitude_, polygon.maxLatitude());
+            min_longitude_ = std::min(min_longitude_, polygon.minLongitude());
+            max_longitude_ = std::max(max_longitude_, polygon.maxLongitude());
+        }
+    }
+}
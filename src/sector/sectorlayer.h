@@ -22,8 +22,9 @@
 #include <vector>
 #include <memory>
 
+#include "evaluationtargetposition.h"
+
 class Sector;
-class EvaluationTargetPosition;
 
 class SectorLayer
 {
@@ -43,6 +44,10 @@ public:
 
     bool isInside(const EvaluationTargetPosition& pos,
                   bool has_ground_bit, bool ground_bit_set) const;
+    // classifies all positions at once, ground bit vectors must have the size of positions
+    std::vector<bool> isInside(const std::vector<EvaluationTargetPosition>& positions,
+                               const std::vector<bool>& has_ground_bits,
+                               const std::vector<bool>& ground_bits_set) const;
 
     std::pair<double, double> getMinMaxLatitude() const;
     std::pair<double, double> getMinMaxLongitude() const;
@@ -52,6 +57,20 @@ protected:
 
     std::vector<std::shared_ptr<Sector>> sectors_;
     bool has_exclude_sector_ {false};
+
+    // bounding box of all sectors, empty if no sectors
+    double min_latitude_ {1.0};
+    double max_latitude_ {-1.0};
+    double min_longitude_ {1.0};
+    double max_longitude_ {-1.0};
+
+    bool isInsideBoundingBox(const EvaluationTargetPosition& pos) const
+    {
+        return pos.latitude_ >= min_latitude_ && pos.latitude_ <= max_latitude_
+                && pos.longitude_ >= min_longitude_ && pos.longitude_ <= max_longitude_;
+    }
+
+    void updateBounds();
 };
 
 #endif // SECTORLAYER_H
@@ -369,126 +369,59 @@ void CreateARTASAssociationsJob::saveAssociations()
 
     DBContentManager& dbcontent_man = COMPASS::instance().dbContentManager();
 
-    // write association info to buffers
+    // write association info to association table, replaces previous ones of all loaded dbcontents
 
     unsigned int rec_num;
 
-    for (auto& cont_assoc_it : associations_) // dbcontent -> rec_nums
+    for (auto& buf_it : buffers_)
     {
-        unsigned int num_associated {0};
-        unsigned int num_not_associated {0};
-
-        string dbcontent_name = cont_assoc_it.first;
-        std::map<unsigned int,
-                std::tuple<unsigned int, std::vector<std::pair<std::string, unsigned int>>>>& associations
-                = cont_assoc_it.second;
+        string dbcontent_name = buf_it.first;
 
         loginf << "CreateARTASAssociationsJob: saveAssociations: db content " << dbcontent_name;
 
-        assert (buffers_.count(dbcontent_name));
-
         assert (dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).existsIn(dbcontent_name));
-        assert (dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).existsIn(dbcontent_name));
 
         string rec_num_var_name =
                 dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).name();
-        string assoc_var_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).getFor(dbcontent_name).name();
-
-        assert (buffers_.at(dbcontent_name)->has<unsigned int>(rec_num_var_name));
-        assert (buffers_.at(dbcontent_name)->has<json>(assoc_var_name));
-
-        NullableVector<unsigned int>& rec_num_vec = buffers_.at(dbcontent_name)->get<unsigned int>(rec_num_var_name);
-        NullableVector<json>& assoc_vec = buffers_.at(dbcontent_name)->get<json>(assoc_var_name);
-
-        for (unsigned int cnt=0; cnt < buffers_.at(dbcontent_name)->size(); ++cnt)
-        {
-            assert (!rec_num_vec.isNull(cnt));
-
-            rec_num = rec_num_vec.get(cnt);
-
-            if (associations.count(rec_num))
-            {
-                if (assoc_vec.isNull(cnt))
-                    assoc_vec.set(cnt, {get<0>(associations.at(rec_num))});
-                else
-                    assoc_vec.getRef(cnt).push_back(get<0>(associations.at(rec_num)));
 
-                ++num_associated;
-            }
-            else
-                ++num_not_associated;
-        }
+        assert (buf_it.second->has<unsigned int>(rec_num_var_name));
 
-        association_counts_[dbcontent_name] = {buffers_.at(dbcontent_name)->size(), num_associated};
+        NullableVector<unsigned int>& rec_num_vec = buf_it.second->get<unsigned int>(rec_num_var_name);
 
-        loginf << "CreateARTASAssociationsJob: saveAssociations: dcontent " << dbcontent_name
-               <<  " assoc " << num_associated << " not assoc " << num_not_associated;
-    }
+        std::map<unsigned int, unsigned int> rec_num_utns;
 
-    // delete all data from buffer except rec_nums and associations, rename to db column names
-    for (auto& buf_it : buffers_)
-    {
-        string dbcontent_name = buf_it.first;
-
-        string rec_num_var_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).name();
-        string rec_num_col_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).dbColumnName();
-
-        string assoc_var_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).getFor(dbcontent_name).name();
-        string assoc_col_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).getFor(dbcontent_name).dbColumnName();
-
-
-        PropertyList properties = buf_it.second->properties();
-
-        for (auto& prop_it : properties.properties())
+        if (associations_.count(dbcontent_name))
         {
-            if (prop_it.name() == rec_num_var_name)
-                buf_it.second->rename<unsigned int>(rec_num_var_name, rec_num_col_name);
-            else if (prop_it.name() == assoc_var_name)
-                buf_it.second->rename<json>(assoc_var_name, assoc_col_name);
-            else
-                buf_it.second->deleteProperty(prop_it);
-        }
-    }
-
-    // actually save data, ok since DB job
-    for (auto& buf_it : buffers_)
-    {
-        string dbcontent_name = buf_it.first;
+            std::map<unsigned int,
+                    std::tuple<unsigned int, std::vector<std::pair<std::string, unsigned int>>>>& associations
+                    = associations_.at(dbcontent_name);
 
-        loginf << "CreateARTASAssociationsJob: saveAssociations: saving for " << dbcontent_name;
+            unsigned int num_associated {0};
+            unsigned int num_not_associated {0};
 
-        DBContent& dbcontent = dbcontent_man.dbContent(buf_it.first);
-        dbContent::Variable& key_var =
-                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name);
-
-        unsigned int chunk_size = 50000;
-
-        unsigned int steps = buf_it.second->size() / chunk_size;
-
-        unsigned int index_from = 0;
-        unsigned int index_to = 0;
-
-        for (unsigned int cnt = 0; cnt <= steps; cnt++)
-        {
-            index_from = cnt * chunk_size;
-            index_to = index_from + chunk_size;
+            for (unsigned int cnt=0; cnt < buf_it.second->size(); ++cnt)
+            {
+                assert (!rec_num_vec.isNull(cnt));
 
-            if (index_to > buf_it.second->size() - 1)
-                index_to = buf_it.second->size() - 1;
+                rec_num = rec_num_vec.get(cnt);
 
-            loginf << "CreateARTASAssociationsJob: saveAssociations: step " << cnt << " steps " << steps << " from "
-                   << index_from << " to " << index_to;
+                if (associations.count(rec_num))
+                {
+                    rec_num_utns[rec_num] = get<0>(associations.at(rec_num));
+                    ++num_associated;
+                }
+                else
+                    ++num_not_associated;
+            }
 
-            db_interface_.updateBuffer(dbcontent.dbTableName(), key_var.dbColumnName(),
-                                       buf_it.second, index_from, index_to);
+            association_counts_[dbcontent_name] = {buf_it.second->size(), num_associated};
 
+            loginf << "CreateARTASAssociationsJob: saveAssociations: dcontent " << dbcontent_name
+                   <<  " assoc " << num_associated << " not assoc " << num_not_associated;
         }
 
+        // actually save data, ok since DB job
+        db_interface_.saveAssociations(dbcontent_name, rec_num_utns);
     }
 
     buffers_.clear();
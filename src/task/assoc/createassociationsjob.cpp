@@ -28,6 +28,7 @@
 #include "dbcontent/variable/variable.h"
 #include "stringconv.h"
 #include "projection/transformation.h"
+#include "assoc/targetpositionindex.h"
 #include "evaluationmanager.h"
 #include "util/timeconv.h"
 
@@ -558,9 +559,6 @@ void CreateAssociationsJob::createNonTrackerUTNS(std::map<unsigned int, Associat
     DataSourceManager& ds_man = COMPASS::instance().dataSourceManager();
 
     const bool associate_non_mode_s = task_.associateNonModeS();
-    const time_duration max_time_diff_sensor = Time::partialSeconds(task_.maxTimeDiffSensor());
-    const double max_altitude_diff_sensor = task_.maxAltitudeDiffSensor();
-    const double max_distance_acceptable_sensor = task_.maxDistanceAcceptableSensor();
 
     unsigned int ds_cnt = 0;
     unsigned int done_perc;
@@ -629,133 +627,53 @@ void CreateAssociationsJob::createNonTrackerUTNS(std::map<unsigned int, Associat
                     return;
                 }
 
-                // tr non mode s
-
-                if (!associate_non_mode_s)
-                    return;
-
-                ptime timestamp;
-                vector<tuple<bool, unsigned int, double>> results;
-                // usable, utn, distance
-
-                results.resize(targets.size());
-
-                timestamp = tr_it.timestamp_;
-
-                EvaluationTargetPosition tst_pos;
-
-                tst_pos.latitude_ = tr_it.latitude_;
-                tst_pos.longitude_ = tr_it.longitude_;
-                tst_pos.has_altitude_ = tr_it.has_mc_;
-                tst_pos.altitude_ = tr_it.mc_;
-
-                FixedTransformation trafo (tst_pos.latitude_, tst_pos.longitude_);
-
-                //loginf << "UGA: checking tr a/c/pos";
+                // tr non mode s, done below
+            });
 
-                double x_pos, y_pos;
-                double distance;
+            if (associate_non_mode_s)
+            {
+                // position based association of non mode s, indexed
+                ptime index_start_time = microsec_clock::local_time();
 
-                EvaluationTargetPosition ref_pos;
-                bool ok;
+                associateByPosition(target_reports, targets, true, tmp_assoc_utns);
 
-                unsigned int target_cnt=0;
-                for (auto& target_it : targets)
+                if (task_.benchmarkPositionIndex())
                 {
-                    //Association::Target& other = std::next(targets.begin(), target_cnt)->second;
+                    time_duration index_time = microsec_clock::local_time() - index_start_time;
 
-                    Association::Target& other = target_it.second;
+                    vector<int> brute_force_utns (num_target_reports, -1);
 
-                    results[target_cnt] = tuple<bool, unsigned int, double>(false, other.utn_, 0);
+                    ptime brute_force_start_time = microsec_clock::local_time();
 
-                    if ((tr_it.has_ta_ && other.hasTA())) // only try if not both mode s
-                    {
-                        ++target_cnt;
-                        continue;
-                    }
+                    associateByPosition(target_reports, targets, false, brute_force_utns);
 
-                    if (!other.isTimeInside(timestamp))
-                    {
-                        ++target_cnt;
-                        continue;
-                    }
+                    time_duration brute_force_time = microsec_clock::local_time() - brute_force_start_time;
 
-                    if (tr_it.has_ma_ || tr_it.has_mc_) // mode a/c based
-                    {
-                        // check mode a code
-                        Association::CompareResult ma_res = other.compareModeACode(tr_it.has_ma_, tr_it.ma_, timestamp,
-                                                                                   max_time_diff_sensor);
+                    unsigned int num_checked {0};
+                    unsigned int num_differences {0};
 
-                        if (ma_res != Association::CompareResult::SAME)
-                        {
-                            target_cnt++;
-                            continue;
-                        }
-                        //loginf << "UGA3 same mode a";
-
-                        // check mode c code
-                        Association::CompareResult mc_res = other.compareModeCCode(
-                                    tr_it.has_mc_, tr_it.mc_, timestamp,
-                                    max_time_diff_sensor, max_altitude_diff_sensor, false);
-
-                        if (mc_res != Association::CompareResult::SAME)
-                        {
-                            target_cnt++;
+                    for (unsigned int tr_cnt=0; tr_cnt < num_target_reports; ++tr_cnt)
+                    {
+                        if (target_reports.at(tr_cnt).has_ta_)
                             continue;
-                        }
-                    }
-
-                    // check positions
 
-                    tie(ref_pos, ok) = other.interpolatedPosForTimeFast(timestamp, max_time_diff_sensor);
+                        ++num_checked;
 
-                    tie(ok, x_pos, y_pos) = trafo.distanceCart(ref_pos.latitude_, ref_pos.longitude_);
-
-                    if (!ok)
-                    {
-                        ++target_cnt;
-                        continue;
+                        if (tmp_assoc_utns.at(tr_cnt) != brute_force_utns.at(tr_cnt))
+                            ++num_differences;
                     }
 
-                    distance = sqrt(pow(x_pos,2)+pow(y_pos,2));
+                    loginf << "CreateAssociationsJob: createNonTrackerUTNS: ds " << ds_name
+                           << " benchmark: target reports " << num_checked << " targets " << targets.size()
+                           << " indexed " << Time::toString(index_time)
+                           << " brute force " << Time::toString(brute_force_time);
 
-                    //loginf << "UGA3 distance " << distance;
-
-                    if (distance < max_distance_acceptable_sensor)
-                        results[target_cnt] = tuple<bool, unsigned int, double>(true, other.utn_, distance);
-
-                    ++target_cnt;
+                    if (num_differences)
+                        logerr << "CreateAssociationsJob: createNonTrackerUTNS: ds " << ds_name
+                               << " benchmark: " << num_differences << " differences between indexed"
+                               << " and brute force association";
                 }
-
-                // find best match
-                bool usable;
-                unsigned int other_utn;
-
-                bool first = true;
-                unsigned int best_other_utn;
-                double best_distance;
-
-                for (auto& res_it : results) // usable, other utn, num updates, avg distance
-                {
-                    tie(usable, other_utn, distance) = res_it;
-
-                    if (!usable)
-                        continue;
-
-                    if (first || distance < best_distance)
-                    {
-                        best_other_utn = other_utn;
-                        best_distance = distance;
-
-                        first = false;
-                    }
-                }
-
-                if (!first)
-                {
-                    tmp_assoc_utns[tr_cnt] = best_other_utn;
-                }
-            });
+            }
 
             emit statusSignal(("Creating "+dbo_it.first+" "+ds_name+" Associations ("
                                +to_string(done_perc)+"%)").c_str());
@@ -811,154 +729,209 @@ void CreateAssociationsJob::createNonTrackerUTNS(std::map<unsigned int, Associat
     loginf << "CreateAssociationsJob: createNonTrackerUTNS: done";
 }
 
-void CreateAssociationsJob::createAssociations()
+void CreateAssociationsJob::associateByPosition(
+        std::vector<Association::TargetReport>& target_reports,
+        const std::map<unsigned int, Association::Target>& targets, bool use_index,
+        std::vector<int>& assoc_utns)
 {
-    loginf << "CreateAssociationsJob: createAssociations";
+    const time_duration max_time_diff_sensor = Time::partialSeconds(task_.maxTimeDiffSensor());
+    const double max_altitude_diff_sensor = task_.maxAltitudeDiffSensor();
+    const double max_distance_acceptable_sensor = task_.maxDistanceAcceptableSensor();
 
-    for (auto& dbo_it : target_reports_)
+    unsigned int num_target_reports = target_reports.size();
+    assert (assoc_utns.size() == num_target_reports);
+
+    vector<const Association::Target*> all_targets; // in utn order
+
+    for (auto& target_it : targets)
+        all_targets.push_back(&target_it.second);
+
+    std::unique_ptr<Association::TargetPositionIndex> index;
+
+    if (use_index)
+        index.reset(new Association::TargetPositionIndex(
+                        targets, max_time_diff_sensor, max_distance_acceptable_sensor));
+
+    tbb::parallel_for(uint(0), num_target_reports, [&](unsigned int tr_cnt)
     {
-        for (auto& ds_it : dbo_it.second) // ds_id -> trs
+        Association::TargetReport& tr_it = target_reports[tr_cnt];
+
+        if (tr_it.has_ta_) // mode s done by target address
+            return;
+
+        if (use_index)
         {
-            for (auto& tr_it : ds_it.second)
-            {
-                for (auto& utn_ptr_it : tr_it.assoc_targets_)
-                {
-                    //dbo.addAssociation(tr_it.rec_num_, utn_ptr_it->utn_, false, 0);
+            vector<const Association::Target*> candidates;
 
-                    associations_[dbo_it.first][tr_it.rec_num_] =
-                            std::make_tuple(utn_ptr_it->utn_, std::vector<std::pair<std::string, unsigned int>>());
-                }
+            if (index->candidates(tr_it.timestamp_, tr_it.latitude_, tr_it.longitude_, candidates))
+            {
+                assoc_utns[tr_cnt] = findUTNByPosition(
+                            tr_it, candidates, max_time_diff_sensor, max_altitude_diff_sensor,
+                            max_distance_acceptable_sensor);
+                return;
             }
         }
-    }
+
+        assoc_utns[tr_cnt] = findUTNByPosition(
+                    tr_it, all_targets, max_time_diff_sensor, max_altitude_diff_sensor,
+                    max_distance_acceptable_sensor);
+    });
 }
 
-void CreateAssociationsJob::saveAssociations()
+int CreateAssociationsJob::findUTNByPosition (
+        const Association::TargetReport& tr, const std::vector<const Association::Target*>& targets,
+        boost::posix_time::time_duration max_time_diff, double max_altitude_diff,
+        double max_distance_acceptable)
 {
-    loginf << "CreateAssociationsJob: saveAssociations";
+    if (!targets.size())
+        return -1;
 
-    DBContentManager& dbcontent_man = COMPASS::instance().dbContentManager();
+    ptime timestamp = tr.timestamp_;
 
-    // write association info to buffers
+    FixedTransformation trafo (tr.latitude_, tr.longitude_);
 
-    unsigned int rec_num;
+    double x_pos, y_pos;
+    double distance;
+
+    EvaluationTargetPosition ref_pos;
+    bool ok;
+
+    bool first = true;
+    unsigned int best_other_utn;
+    double best_distance;
 
-    for (auto& cont_assoc_it : associations_) // dbcontent -> rec_nums
+    for (const Association::Target* other : targets) // in utn order, first best match is used
     {
-        unsigned int num_associated {0};
-        unsigned int num_not_associated {0};
+        if ((tr.has_ta_ && other->hasTA())) // only try if not both mode s
+            continue;
 
-        string dbcontent_name = cont_assoc_it.first;
-        std::map<unsigned int,
-                std::tuple<unsigned int, std::vector<std::pair<std::string, unsigned int>>>>& associations
-                = cont_assoc_it.second;
+        if (!other->isTimeInside(timestamp))
+            continue;
 
-        loginf << "CreateAssociationsJob: saveAssociations: db content " << dbcontent_name;
+        if (tr.has_ma_ || tr.has_mc_) // mode a/c based
+        {
+            // check mode a code
+            Association::CompareResult ma_res = other->compareModeACode(tr.has_ma_, tr.ma_, timestamp,
+                                                                        max_time_diff);
 
-        assert (buffers_.count(dbcontent_name));
+            if (ma_res != Association::CompareResult::SAME)
+                continue;
 
-        assert (dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).existsIn(dbcontent_name));
-        assert (dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).existsIn(dbcontent_name));
+            // check mode c code
+            Association::CompareResult mc_res = other->compareModeCCode(
+                        tr.has_mc_, tr.mc_, timestamp, max_time_diff, max_altitude_diff, false);
 
-        string rec_num_var_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).name();
-        string assoc_var_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).getFor(dbcontent_name).name();
+            if (mc_res != Association::CompareResult::SAME)
+                continue;
+        }
 
-        assert (buffers_.at(dbcontent_name)->has<unsigned int>(rec_num_var_name));
-        assert (buffers_.at(dbcontent_name)->has<json>(assoc_var_name));
+        // check positions
 
-        NullableVector<unsigned int>& rec_num_vec = buffers_.at(dbcontent_name)->get<unsigned int>(rec_num_var_name);
-        NullableVector<json>& assoc_vec = buffers_.at(dbcontent_name)->get<json>(assoc_var_name);
+        tie(ref_pos, ok) = other->interpolatedPosForTimeFast(timestamp, max_time_diff);
 
-        for (unsigned int cnt=0; cnt < buffers_.at(dbcontent_name)->size(); ++cnt)
-        {
-            assert (!rec_num_vec.isNull(cnt));
+        tie(ok, x_pos, y_pos) = trafo.distanceCart(ref_pos.latitude_, ref_pos.longitude_);
+
+        if (!ok)
+            continue;
 
-            rec_num = rec_num_vec.get(cnt);
+        distance = sqrt(pow(x_pos,2)+pow(y_pos,2));
 
-            if (associations.count(rec_num))
-            {
-                if (assoc_vec.isNull(cnt))
-                    assoc_vec.set(cnt, {get<0>(associations.at(rec_num))});
-                else
-                    assoc_vec.getRef(cnt).push_back(get<0>(associations.at(rec_num)));
+        if (distance < max_distance_acceptable && (first || distance < best_distance))
+        {
+            best_other_utn = other->utn_;
+            best_distance = distance;
 
-                ++num_associated;
-            }
-            else
-                ++num_not_associated;
+            first = false;
         }
+    }
 
-        association_counts_[dbcontent_name] = {buffers_.at(dbcontent_name)->size(), num_associated};
+    if (first)
+        return -1;
 
-        loginf << "CreateAssociationsJob: saveAssociations: dcontent " << dbcontent_name
-               <<  " assoc " << num_associated << " not assoc " << num_not_associated;
-    }
+    return best_other_utn;
+}
 
-    // delete all data from buffer except rec_nums and associations, rename to db column names
-    for (auto& buf_it : buffers_)
+void CreateAssociationsJob::createAssociations()
+{
+    loginf << "CreateAssociationsJob: createAssociations";
+
+    for (auto& dbo_it : target_reports_)
     {
-        string dbcontent_name = buf_it.first;
+        for (auto& ds_it : dbo_it.second) // ds_id -> trs
+        {
+            for (auto& tr_it : ds_it.second)
+            {
+                for (auto& utn_ptr_it : tr_it.assoc_targets_)
+                {
+                    //dbo.addAssociation(tr_it.rec_num_, utn_ptr_it->utn_, false, 0);
 
-        string rec_num_var_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).name();
-        string rec_num_col_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).dbColumnName();
+                    associations_[dbo_it.first][tr_it.rec_num_] =
+                            std::make_tuple(utn_ptr_it->utn_, std::vector<std::pair<std::string, unsigned int>>());
+                }
+            }
+        }
+    }
+}
 
-        string assoc_var_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).getFor(dbcontent_name).name();
-        string assoc_col_name =
-                dbcontent_man.metaVariable(DBContent::meta_var_associations_.name()).getFor(dbcontent_name).dbColumnName();
+void CreateAssociationsJob::saveAssociations()
+{
+    loginf << "CreateAssociationsJob: saveAssociations";
 
+    DBContentManager& dbcontent_man = COMPASS::instance().dbContentManager();
 
-        PropertyList properties = buf_it.second->properties();
+    // write association info to association table, replaces previous ones of all loaded dbcontents
 
-        for (auto& prop_it : properties.properties())
-        {
-            if (prop_it.name() == rec_num_var_name)
-                buf_it.second->rename<unsigned int>(rec_num_var_name, rec_num_col_name);
-            else if (prop_it.name() == assoc_var_name)
-                buf_it.second->rename<json>(assoc_var_name, assoc_col_name);
-            else
-                buf_it.second->deleteProperty(prop_it);
-        }
-    }
+    unsigned int rec_num;
 
-    // actually save data, ok since DB job
     for (auto& buf_it : buffers_)
     {
         string dbcontent_name = buf_it.first;
 
-        loginf << "CreateAssociationsJob: saveAssociations: saving for " << dbcontent_name;
+        loginf << "CreateAssociationsJob: saveAssociations: db content " << dbcontent_name;
+
+        assert (dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).existsIn(dbcontent_name));
 
-        DBContent& dbcontent = dbcontent_man.dbContent(buf_it.first);
-        dbContent::Variable& key_var =
-                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name);
+        string rec_num_var_name =
+                dbcontent_man.metaVariable(DBContent::meta_var_rec_num_.name()).getFor(dbcontent_name).name();
 
-        unsigned int chunk_size = 50000;
+        assert (buf_it.second->has<unsigned int>(rec_num_var_name));
 
-        unsigned int steps = buf_it.second->size() / chunk_size;
+        NullableVector<unsigned int>& rec_num_vec = buf_it.second->get<unsigned int>(rec_num_var_name);
 
-        unsigned int index_from = 0;
-        unsigned int index_to = 0;
+        std::map<unsigned int, unsigned int> rec_num_utns;
 
-        for (unsigned int cnt = 0; cnt <= steps; cnt++)
+        if (associations_.count(dbcontent_name))
         {
-            index_from = cnt * chunk_size;
-            index_to = index_from + chunk_size;
+            std::map<unsigned int,
+                    std::tuple<unsigned int, std::vector<std::pair<std::string, unsigned int>>>>& associations
+                    = associations_.at(dbcontent_name);
+
+            unsigned int num_associated {0};
+            unsigned int num_not_associated {0};
+
+            for (unsigned int cnt=0; cnt < buf_it.second->size(); ++cnt)
+            {
+                assert (!rec_num_vec.isNull(cnt));
 
-            if (index_to > buf_it.second->size() - 1)
-                index_to = buf_it.second->size() - 1;
+                rec_num = rec_num_vec.get(cnt);
 
-            loginf << "CreateAssociationsJob: saveAssociations: step " << cnt << " steps " << steps << " from "
-                   << index_from << " to " << index_to;
+                if (associations.count(rec_num))
+                {
+                    rec_num_utns[rec_num] = get<0>(associations.at(rec_num));
+                    ++num_associated;
+                }
+                else
+                    ++num_not_associated;
+            }
 
-            db_interface_.updateBuffer(dbcontent.dbTableName(), key_var.dbColumnName(),
-                                       buf_it.second, index_from, index_to);
+            association_counts_[dbcontent_name] = {buf_it.second->size(), num_associated};
 
+            loginf << "CreateAssociationsJob: saveAssociations: dcontent " << dbcontent_name
+                   <<  " assoc " << num_associated << " not assoc " << num_not_associated;
         }
 
+        // actually save data, ok since DB job
+        db_interface_.saveAssociations(dbcontent_name, rec_num_utns);
     }
 
     buffers_.clear();
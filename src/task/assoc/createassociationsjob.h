@@ -70,6 +70,10 @@ protected:
     void createTrackerUTNs(std::map<unsigned int, Association::Target>& sum_targets);
 
     void createNonTrackerUTNS(std::map<unsigned int, Association::Target>& targets);
+    void associateByPosition(std::vector<Association::TargetReport>& target_reports,
+                             const std::map<unsigned int, Association::Target>& targets, bool use_index,
+                             std::vector<int>& assoc_utns);
+    // sets utns for non mode s target reports, using a position index or checking all targets
     void createAssociations();
     void saveAssociations();
     void saveTargets(std::map<unsigned int, Association::Target>& targets);
@@ -97,6 +101,11 @@ protected:
     int findUTNForTargetByTA (const Association::Target& target,
                               const std::map<unsigned int, Association::Target>& targets);
     // tries to find existing utn for target by target address, -1 if failed
+    int findUTNByPosition (const Association::TargetReport& tr,
+                           const std::vector<const Association::Target*>& targets,
+                           boost::posix_time::time_duration max_time_diff, double max_altitude_diff,
+                           double max_distance_acceptable);
+    // tries to find closest utn by mode a/c and position, -1 if failed
 
     std::map<unsigned int, unsigned int> getTALookupMap (
             const std::map<unsigned int, Association::Target>& targets);
@@ -80,6 +80,9 @@ CreateAssociationsTask::CreateAssociationsTask(const std::string& class_id,
     registerParameter("max_distance_acceptable_sensor", &max_distance_acceptable_sensor_, 2*NM2M);
     registerParameter("max_altitude_diff_sensor", &max_altitude_diff_sensor_, 300.0);
 
+    // debug
+    registerParameter("benchmark_position_index", &benchmark_position_index_, false);
+
     // target id? kb: nope
     // kb: TODO ma 1bit hamming distance, especially g (1bit wrong)/v (!->at least 1bit wrong)
 }
@@ -468,6 +471,17 @@ void CreateAssociationsTask::contMaxDistanceAcceptableTracker(double cont_max_di
     cont_max_distance_acceptable_tracker_ = cont_max_distance_acceptable_tracker;
 }
 
+bool CreateAssociationsTask::benchmarkPositionIndex() const
+{
+    return benchmark_position_index_;
+}
+
+void CreateAssociationsTask::benchmarkPositionIndex(bool value)
+{
+    loginf << "CreateAssociationsTask: benchmarkPositionIndex: value " << value;
+    benchmark_position_index_ = value;
+}
+
 void CreateAssociationsTask::loadedDataSlot(
         const std::map<std::string, std::shared_ptr<Buffer>>& data, bool requires_reset)
 {
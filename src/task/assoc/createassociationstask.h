@@ -143,6 +143,10 @@ public:
     double contMaxDistanceAcceptableTracker() const;
     void contMaxDistanceAcceptableTracker(double value);
 
+    // also runs brute force non mode s association, logs timings and differences
+    bool benchmarkPositionIndex() const;
+    void benchmarkPositionIndex(bool value);
+
 protected:
     dbContent::MetaVariable* rec_num_var_{nullptr};
     dbContent::MetaVariable* ds_id_var_{nullptr};
@@ -187,6 +191,9 @@ protected:
     double max_distance_acceptable_sensor_ {2*NM2M};
     double max_altitude_diff_sensor_ {300.0};
 
+    // debug
+    bool benchmark_position_index_ {false};
+
     boost::posix_time::ptime start_time_;
     boost::posix_time::ptime stop_time_;
 
@@ -0,0 +1,490 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "liveassociator.h"
+#include "compass.h"
+#include "buffer.h"
+#include "createassociationstask.h"
+#include "dbcontent/dbcontent.h"
+#include "dbcontent/dbcontentmanager.h"
+#include "dbcontent/variable/variable.h"
+#include "projection/transformation.h"
+#include "logger.h"
+#include "util/timeconv.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+using namespace Utils;
+using namespace nlohmann;
+using namespace boost::posix_time;
+
+namespace
+{
+// returns vector of meta variable in buffer using db column names, nullptr if not existing
+template <typename T>
+NullableVector<T>* metaVector (const std::string& dbcontent_name, Buffer& buffer, const Property& meta_property)
+{
+    DBContentManager& dbcont_man = COMPASS::instance().dbContentManager();
+
+    if (!dbcont_man.metaCanGetVariable(dbcontent_name, meta_property))
+        return nullptr;
+
+    string col_name = dbcont_man.metaGetVariable(dbcontent_name, meta_property).dbColumnName();
+
+    if (!buffer.has<T>(col_name))
+        return nullptr;
+
+    return &buffer.get<T>(col_name);
+}
+
+// returns if mode a/c of tr and other are the same, as in Target::compareModeACode/compareModeCCode
+bool sameModeAC (const Association::TargetReport& tr, const Association::TargetReport& other,
+                 double max_altitude_diff)
+{
+    if (tr.has_ma_ != other.has_ma_ || (tr.has_ma_ && tr.ma_ != other.ma_))
+        return false;
+
+    if (tr.has_mc_ != other.has_mc_ || (tr.has_mc_ && fabs(tr.mc_ - other.mc_) >= max_altitude_diff))
+        return false;
+
+    return true;
+}
+}
+
+const unsigned int LiveAssociator::EXPIRE_SLACK_S;
+
+LiveAssociator::LiveAssociator(CreateAssociationsTask& task, unsigned int first_utn)
+    : task_(task), next_utn_(first_utn)
+{
+}
+
+void LiveAssociator::associate(std::map<std::string, std::shared_ptr<Buffer>>& buffers)
+{
+    logdbg << "LiveAssociator: associate: buffers " << buffers.size();
+
+    DBContentManager& dbcont_man = COMPASS::instance().dbContentManager();
+
+    // new target reports of all buffers, with assoc vector and buffer index
+    vector<tuple<Association::TargetReport*, NullableVector<json>*, size_t>> batch;
+
+    for (auto& buf_it : buffers)
+    {
+        if (!dbcont_man.metaCanGetVariable(buf_it.first, DBContent::meta_var_associations_))
+            continue;
+
+        dbContent::Variable& assoc_var = dbcont_man.metaGetVariable(buf_it.first, DBContent::meta_var_associations_);
+        Property assoc_prop (assoc_var.dbColumnName(), assoc_var.dataType());
+
+        if (!buf_it.second->hasProperty(assoc_prop))
+            buf_it.second->addProperty(assoc_prop);
+
+        NullableVector<json>& assoc_vec = buf_it.second->get<json>(assoc_var.dbColumnName());
+
+        size_t num_before = target_reports_.size();
+        vector<size_t> indexes = addTargetReports(buf_it.first, *buf_it.second);
+
+        assert (target_reports_.size() - num_before == indexes.size());
+
+        for (size_t cnt=0; cnt < indexes.size(); ++cnt)
+            batch.emplace_back(&target_reports_[num_before + cnt], &assoc_vec, indexes.at(cnt));
+    }
+
+    if (!batch.size())
+        return;
+
+    // associate in time order
+    stable_sort(batch.begin(), batch.end(),
+                [](const tuple<Association::TargetReport*, NullableVector<json>*, size_t>& a,
+                   const tuple<Association::TargetReport*, NullableVector<json>*, size_t>& b)
+                { return get<0>(a)->timestamp_ < get<0>(b)->timestamp_; });
+
+    updatePositionIndex();
+
+    unsigned int num_associated {0};
+    unsigned int num_created {0};
+
+    for (auto& batch_it : batch)
+    {
+        Association::TargetReport& tr = *get<0>(batch_it);
+        int utn;
+
+        if (tr.has_ta_)
+        {
+            if (ta_2_utn_.count(tr.ta_))
+                utn = ta_2_utn_.at(tr.ta_);
+            else
+            {
+                utn = createTarget();
+                ta_2_utn_[tr.ta_] = utn;
+                ++num_created;
+            }
+        }
+        else
+        {
+            utn = findUTN(tr);
+
+            if (utn == -1 && tr.has_tn_ && (tr.dbcontent_name_ == "CAT062" || tr.dbcontent_name_ == "RefTraj"))
+            {
+                // new tracker target
+                utn = createTarget();
+                ++num_created;
+            }
+        }
+
+        if (utn == -1)
+            continue;
+
+        addAssociated(utn, tr);
+
+        get<1>(batch_it)->set(get<2>(batch_it), json::array({(unsigned int) utn}));
+
+        ++num_associated;
+    }
+
+    logdbg << "LiveAssociator: associate: target reports " << batch.size() << " associated " << num_associated
+           << " new targets " << num_created << " targets " << targets_.size();
+}
+
+void LiveAssociator::expire(boost::posix_time::ptime timestamp)
+{
+    logdbg << "LiveAssociator: expire: before " << Time::toString(timestamp);
+
+    // only rebuild targets with enough expired target reports
+    ptime rebuild_before = timestamp - seconds(EXPIRE_SLACK_S);
+
+    while (targets_by_time_.size() && targets_by_time_.begin()->first < rebuild_before)
+    {
+        unsigned int utn = targets_by_time_.begin()->second;
+        targets_by_time_.erase(targets_by_time_.begin());
+
+        assert (targets_.count(utn));
+        Association::Target& target = targets_.at(utn);
+
+        std::set<unsigned int> tas = target.tas_; // cleared if no target reports remain
+        target.removeAssociatedBefore(timestamp);
+
+        if (target.numAssociated())
+        {
+            assert (target.timestamp_min_ >= timestamp);
+            targets_by_time_.insert({target.timestamp_min_, utn});
+        }
+        else
+            removeTarget(utn, tas);
+    }
+
+    if (position_index_)
+        position_index_->removeBefore(timestamp);
+
+    // targets only reference target reports not before rebuild_before
+    while (target_reports_.size() && target_reports_.front().timestamp_ < rebuild_before)
+        target_reports_.pop_front();
+
+    logdbg << "LiveAssociator: expire: targets " << targets_.size()
+           << " target reports " << target_reports_.size();
+}
+
+std::vector<size_t> LiveAssociator::addTargetReports(const std::string& dbcontent_name, Buffer& buffer)
+{
+    vector<size_t> indexes;
+
+    NullableVector<unsigned int>* ds_ids = metaVector<unsigned int>(
+                dbcontent_name, buffer, DBContent::meta_var_datasource_id_);
+    NullableVector<ptime>* ts_vec = metaVector<ptime>(dbcontent_name, buffer, DBContent::meta_var_timestamp_);
+    NullableVector<double>* lats = metaVector<double>(dbcontent_name, buffer, DBContent::meta_var_latitude_);
+    NullableVector<double>* longs = metaVector<double>(dbcontent_name, buffer, DBContent::meta_var_longitude_);
+
+    if (!ds_ids || !ts_vec || !lats || !longs)
+    {
+        logwrn << "LiveAssociator: addTargetReports: " << dbcontent_name << " without required variables";
+        return indexes;
+    }
+
+    // optional
+    NullableVector<unsigned int>* line_ids = metaVector<unsigned int>(
+                dbcontent_name, buffer, DBContent::meta_var_line_id_);
+    NullableVector<unsigned int>* tas = metaVector<unsigned int>(dbcontent_name, buffer, DBContent::meta_var_ta_);
+    NullableVector<string>* tis = metaVector<string>(dbcontent_name, buffer, DBContent::meta_var_ti_);
+    NullableVector<unsigned int>* tns = metaVector<unsigned int>(
+                dbcontent_name, buffer, DBContent::meta_var_track_num_);
+    NullableVector<bool>* tr_ends = metaVector<bool>(dbcontent_name, buffer, DBContent::meta_var_track_end_);
+    NullableVector<unsigned int>* m3as = metaVector<unsigned int>(dbcontent_name, buffer, DBContent::meta_var_m3a_);
+    NullableVector<float>* mcs = metaVector<float>(dbcontent_name, buffer, DBContent::meta_var_mc_);
+
+    size_t buffer_size = buffer.size();
+
+    for (size_t cnt = 0; cnt < buffer_size; ++cnt)
+    {
+        if (ds_ids->isNull(cnt) || ts_vec->isNull(cnt) || lats->isNull(cnt) || longs->isNull(cnt))
+            continue;
+
+        target_reports_.emplace_back();
+        Association::TargetReport& tr = target_reports_.back();
+
+        tr.dbcontent_name_ = dbcontent_name;
+        tr.ds_id_ = ds_ids->get(cnt);
+        tr.line_id_ = line_ids && !line_ids->isNull(cnt) ? line_ids->get(cnt) : 0;
+        tr.timestamp_ = ts_vec->get(cnt);
+
+        tr.has_ta_ = tas && !tas->isNull(cnt);
+        tr.ta_ = tr.has_ta_ ? tas->get(cnt) : 0;
+
+        tr.has_ti_ = tis && !tis->isNull(cnt);
+        tr.ti_ = tr.has_ti_ ? tis->get(cnt) : "";
+
+        tr.has_tn_ = tns && !tns->isNull(cnt);
+        tr.tn_ = tr.has_tn_ ? tns->get(cnt) : 0;
+
+        tr.has_track_end_ = tr_ends && !tr_ends->isNull(cnt);
+        tr.track_end_ = tr.has_track_end_ ? tr_ends->get(cnt) : false;
+
+        tr.has_ma_ = m3as && !m3as->isNull(cnt);
+        tr.ma_ = tr.has_ma_ ? m3as->get(cnt) : 0;
+
+        tr.has_mc_ = mcs && !mcs->isNull(cnt);
+        tr.mc_ = tr.has_mc_ ? mcs->get(cnt) : 0;
+
+        tr.latitude_ = lats->get(cnt);
+        tr.longitude_ = longs->get(cnt);
+
+        indexes.push_back(cnt);
+    }
+
+    return indexes;
+}
+
+void LiveAssociator::updatePositionIndex()
+{
+    if (position_index_ && index_max_time_diff_ == task_.maxTimeDiffSensor()
+            && index_max_distance_ == task_.maxDistanceAcceptableSensor())
+        return;
+
+    index_max_time_diff_ = task_.maxTimeDiffSensor();
+    index_max_distance_ = task_.maxDistanceAcceptableSensor();
+
+    position_index_.reset(new Association::TargetPositionIndex(
+                              Time::partialSeconds(index_max_time_diff_), index_max_distance_));
+
+    for (auto& target_it : targets_)
+    {
+        for (auto tr_it : target_it.second.assoc_trs_)
+            position_index_->add(target_it.second, tr_it->timestamp_, tr_it->latitude_, tr_it->longitude_);
+    }
+}
+
+int LiveAssociator::findUTN (const Association::TargetReport& tr)
+{
+    assert (!tr.has_ta_);
+
+    if (tr.has_tn_) // continue track
+    {
+        auto track_it = track_2_utn_.find(make_tuple(tr.ds_id_, tr.line_id_, tr.tn_));
+
+        if (track_it != track_2_utn_.end())
+        {
+            assert (targets_.count(track_it->second));
+            const Association::Target& target = targets_.at(track_it->second);
+
+            if (tr.timestamp_ - target.timestamp_max_ <= Time::partialSeconds(task_.maxTimeDiffTracker()))
+                return track_it->second;
+        }
+    }
+
+    if (!task_.associateNonModeS())
+        return -1;
+
+    return findUTNByPosition(tr);
+}
+
+int LiveAssociator::findUTNByPosition (const Association::TargetReport& tr)
+{
+    const time_duration max_time_diff = Time::partialSeconds(task_.maxTimeDiffSensor());
+    const double max_altitude_diff = task_.maxAltitudeDiffSensor();
+    const double max_distance_acceptable = task_.maxDistanceAcceptableSensor();
+
+    FixedTransformation trafo (tr.latitude_, tr.longitude_);
+
+    double x_pos, y_pos;
+    double distance;
+
+    EvaluationTargetPosition ref_pos;
+    bool ok;
+
+    vector<const Association::Target*> candidates;
+
+    assert (position_index_);
+
+    if (position_index_->candidates(tr.timestamp_, tr.latitude_, tr.longitude_, candidates))
+    {
+        sort(candidates.begin(), candidates.end(),
+             [](const Association::Target* a, const Association::Target* b) { return a->utn_ < b->utn_; });
+    }
+    else // all targets have to be checked
+    {
+        for (auto& target_it : targets_)
+            candidates.push_back(&target_it.second);
+    }
+
+    bool first = true;
+    unsigned int best_other_utn {0};
+    double best_distance {0};
+
+    for (const Association::Target* other : candidates) // in creation order, first best match is used
+    {
+        if (!other->numAssociated())
+            continue;
+
+        if (other->isTimeInside(tr.timestamp_)) // as in CreateAssociationsJob::findUTNByPosition
+        {
+            if (tr.has_ma_ || tr.has_mc_) // mode a/c based
+            {
+                if (other->compareModeACode(tr.has_ma_, tr.ma_, tr.timestamp_, max_time_diff)
+                        != Association::CompareResult::SAME)
+                    continue;
+
+                if (other->compareModeCCode(tr.has_mc_, tr.mc_, tr.timestamp_, max_time_diff,
+                                            max_altitude_diff, false) != Association::CompareResult::SAME)
+                    continue;
+            }
+
+            tie(ref_pos, ok) = other->interpolatedPosForTimeFast(tr.timestamp_, max_time_diff);
+
+            if (!ok)
+                continue;
+        }
+        else if (tr.timestamp_ > other->timestamp_max_
+                 && tr.timestamp_ - other->timestamp_max_ <= max_time_diff) // newer, use last update
+        {
+            const Association::TargetReport& other_last_tr = other->dataForExactTime(other->timestamp_max_);
+
+            if ((tr.has_ma_ || tr.has_mc_) && !sameModeAC(tr, other_last_tr, max_altitude_diff))
+                continue;
+
+            ref_pos.latitude_ = other_last_tr.latitude_;
+            ref_pos.longitude_ = other_last_tr.longitude_;
+        }
+        else
+            continue;
+
+        tie(ok, x_pos, y_pos) = trafo.distanceCart(ref_pos.latitude_, ref_pos.longitude_);
+
+        if (!ok)
+            continue;
+
+        distance = sqrt(pow(x_pos,2)+pow(y_pos,2));
+
+        if (distance < max_distance_acceptable && (first || distance < best_distance))
+        {
+            best_other_utn = other->utn_;
+            best_distance = distance;
+
+            first = false;
+        }
+    }
+
+    if (first)
+        return -1;
+
+    return best_other_utn;
+}
+
+unsigned int LiveAssociator::createTarget ()
+{
+    unsigned int utn = next_utn_++;
+
+    assert (!targets_.count(utn));
+
+    targets_.emplace(
+                std::piecewise_construct,
+                std::forward_as_tuple(utn),   // args for key
+                std::forward_as_tuple(utn, true));  // args for mapped value, no back references in target reports
+
+    return utn;
+}
+
+void LiveAssociator::addAssociated (unsigned int utn, Association::TargetReport& tr)
+{
+    assert (targets_.count(utn));
+    Association::Target& target = targets_.at(utn);
+
+    bool had_timestamps = target.has_timestamps_;
+    ptime timestamp_min = target.timestamp_min_;
+
+    target.addAssociated(&tr);
+
+    if (!had_timestamps || target.timestamp_min_ != timestamp_min)
+    {
+        if (had_timestamps)
+            targets_by_time_.erase({timestamp_min, utn});
+
+        targets_by_time_.insert({target.timestamp_min_, utn});
+    }
+
+    assert (position_index_);
+    position_index_->add(target, tr.timestamp_, tr.latitude_, tr.longitude_);
+
+    if (tr.has_tn_)
+    {
+        tuple<unsigned int, unsigned int, unsigned int> track = make_tuple(tr.ds_id_, tr.line_id_, tr.tn_);
+        auto track_it = track_2_utn_.find(track);
+
+        if (track_it != track_2_utn_.end()) // remove previous
+        {
+            utn_2_tracks_[track_it->second].erase(track);
+            track_2_utn_.erase(track_it);
+        }
+
+        if (!tr.has_track_end_ || !tr.track_end_)
+        {
+            track_2_utn_[track] = utn;
+            utn_2_tracks_[utn].insert(track);
+        }
+    }
+}
+
+void LiveAssociator::removeTarget (unsigned int utn, const std::set<unsigned int>& tas)
+{
+    assert (targets_.count(utn));
+    Association::Target& target = targets_.at(utn);
+
+    assert (!target.numAssociated());
+
+    for (auto ta : tas)
+    {
+        auto ta_it = ta_2_utn_.find(ta);
+
+        if (ta_it != ta_2_utn_.end() && ta_it->second == utn)
+            ta_2_utn_.erase(ta_it);
+    }
+
+    auto tracks_it = utn_2_tracks_.find(utn);
+
+    if (tracks_it != utn_2_tracks_.end())
+    {
+        for (auto& track_it : tracks_it->second)
+            track_2_utn_.erase(track_it);
+
+        utn_2_tracks_.erase(tracks_it);
+    }
+
+    if (position_index_)
+        position_index_->remove(target);
+
+    targets_.erase(utn);
+}
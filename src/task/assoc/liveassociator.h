@@ -0,0 +1,104 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIVEASSOCIATOR_H
+#define LIVEASSOCIATOR_H
+
+#include "assoc/targetreport.h"
+#include "assoc/target.h"
+#include "assoc/targetpositionindex.h"
+
+#include "boost/date_time/posix_time/ptime.hpp"
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+class Buffer;
+class CreateAssociationsTask;
+
+/**
+ * @brief Incremental association of live data
+ *
+ * Keeps the Association::Target state across inserted batches and sets the associations of each
+ * new batch, so live data is shown with UTNs without re-running the CreateAssociationsJob over the
+ * whole database. Per target report:
+ * - mode S: by target address, creating a new target if none exists
+ * - tracker updates: continued by data source, line and track number while the track is updated
+ *   within the tracker max time difference, else as new track target
+ * - other sensor data (if non mode S association is active): closest target by mode A/C and position
+ *   among the position index candidates
+ *
+ * Target reports and targets older than the cache age are removed using expire(), which only rebuilds
+ * targets whose first update lies more than the expire slack before the given time, so each target is
+ * rebuilt at most once per slack. The UTNs are only set in the cached buffers, the DB associations are
+ * still created by the CreateAssociationsTask.
+ */
+class LiveAssociator
+{
+  public:
+    LiveAssociator(CreateAssociationsTask& task, unsigned int first_utn);
+
+    // sets associations in buffers (dbcontent name -> buffer), which have to use db column names
+    void associate(std::map<std::string, std::shared_ptr<Buffer>>& buffers);
+    // removes target reports (and targets without target reports) before timestamp, with slack
+    void expire(boost::posix_time::ptime timestamp);
+
+    size_t numTargets() const { return targets_.size(); }
+    size_t numTargetReports() const { return target_reports_.size(); }
+
+  protected:
+    static const unsigned int EXPIRE_SLACK_S = 60; // target reports kept up to slack longer
+
+    CreateAssociationsTask& task_;
+
+    std::deque<Association::TargetReport> target_reports_; // in insertion order, elements do not move
+    std::map<unsigned int, Association::Target> targets_; // utn -> target
+
+    std::set<std::pair<boost::posix_time::ptime, unsigned int>> targets_by_time_; // (timestamp min, utn)
+
+    std::map<unsigned int, unsigned int> ta_2_utn_;
+    std::map<std::tuple<unsigned int, unsigned int, unsigned int>, unsigned int> track_2_utn_;
+    // (ds_id, line_id, track num) -> utn
+    std::map<unsigned int, std::set<std::tuple<unsigned int, unsigned int, unsigned int>>> utn_2_tracks_;
+
+    std::unique_ptr<Association::TargetPositionIndex> position_index_;
+    double index_max_time_diff_ {0};
+    double index_max_distance_ {0};
+
+    unsigned int next_utn_ {0};
+
+    // adds target reports of buffer, returns buffer indexes of added ones
+    std::vector<size_t> addTargetReports(const std::string& dbcontent_name, Buffer& buffer);
+
+    // creates position index if not existing or if sensor parameters changed
+    void updatePositionIndex();
+
+    // finds utn for tracker update or by position, -1 if failed
+    int findUTN (const Association::TargetReport& tr);
+    int findUTNByPosition (const Association::TargetReport& tr);
+    unsigned int createTarget ();
+    void addAssociated (unsigned int utn, Association::TargetReport& tr);
+    // removes target without target reports, with its previous target addresses
+    void removeTarget (unsigned int utn, const std::set<unsigned int>& tas);
+};
+
+#endif // LIVEASSOCIATOR_H
@@ -248,7 +248,6 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot()
         std::shared_ptr<Buffer> update_buffer =
                 std::make_shared<Buffer>(update_buffer_list, dbcontent_name);
 
-        unsigned int rec_num;
         unsigned int ds_id;
 
         double pos_azm_deg;
@@ -258,14 +257,12 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot()
         double altitude_ft;
         bool has_altitude;
 
-        double lat, lon;
         unsigned int update_cnt = 0;
 
         assert(msg_box_);
         std::string msg;
 
         loginf << "RadarPlotPositionCalculatorTask: loadingDoneSlot: writing update_buffer";
-        bool ret;
 
         size_t transformation_errors = 0;
 
@@ -290,15 +287,43 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot()
         assert (read_ds_id_vec.isNeverNull());
         assert (read_rec_num_vec.isNeverNull());
 
+        // group positions by data source, projected in parallel per data source
+        std::map<unsigned int, size_t> batch_indexes; // ds_id -> index in batches
+        std::vector<PolarPositionBatch> batches;
+
         for (unsigned int cnt = 0; cnt < read_size; cnt++)
         {
-            rec_num = read_rec_num_vec.get(cnt);
-
             ds_id = read_ds_id_vec.get(cnt);
 
             if (read_azimuth_vec.isNull(cnt) || read_range_vec.isNull(cnt))
                 continue;
 
+            if (ds_wo_full_pos.count(ds_id))
+                continue;
+
+            if (!batch_indexes.count(ds_id))
+            {
+                if (!projection.hasCoordinateSystem(ds_id))
+                {
+                    assert (ds_man.hasDBDataSource(ds_id));
+
+                    dbContent::DBDataSource& ds = ds_man.dbDataSource(ds_id);
+
+                    if (!ds.hasFullPosition())
+                    {
+                        logwrn << "RadarPlotPositionCalculatorTask: loadingDoneSlot: data source " << ds.name()
+                               << " does not have full position information, skipping";
+                        ds_wo_full_pos.insert(ds_id);
+                        continue;
+                    }
+
+                    projection.addCoordinateSystem(ds_id, ds.latitude(), ds.longitude(), ds.altitude());
+                }
+
+                batch_indexes[ds_id] = batches.size();
+                batches.emplace_back(ds_id);
+            }
+
             pos_azm_deg = read_azimuth_vec.get(cnt);
             pos_range_nm = read_range_vec.get(cnt);
 
@@ -313,42 +338,44 @@ void RadarPlotPositionCalculatorTask::loadingDoneSlot()
 
             pos_range_m = 1852.0 * pos_range_nm;
 
-            if (!projection.hasCoordinateSystem(ds_id) && !ds_wo_full_pos.count(ds_id))
-            {
-                assert (ds_man.hasDBDataSource(ds_id));
+            batches.at(batch_indexes.at(ds_id)).add(cnt, pos_azm_rad, pos_range_m, has_altitude, altitude_ft);
+        }
 
-                dbContent::DBDataSource& ds = ds_man.dbDataSource(ds_id);
+        projection.polarToWGS84Batches(batches);
 
-                if (!ds.hasFullPosition())
-                {
-                    logwrn << "RadarPlotPositionCalculatorTask: loadingDoneSlot: data source " << ds.name()
-                           << " does not have full position information, skipping";
-                    ds_wo_full_pos.insert(ds_id);
-                    continue;
-                }
+        size_t num_ok = 0;
 
-                projection.addCoordinateSystem(ds_id, ds.latitude(), ds.longitude(), ds.altitude());
-            }
+        for (auto& batch_it : batches)
+        {
+            num_ok += batch_it.size() - batch_it.num_errors_;
+            transformation_errors += batch_it.num_errors_;
+        }
 
-            ret = projection.polarToWGS84(ds_id, pos_azm_rad, pos_range_m, has_altitude,
-                                          altitude_ft, lat, lon);
+        write_lat_vec.prepareFill(num_ok);
+        write_lon_vec.prepareFill(num_ok);
+        write_rec_num_vec.prepareFill(num_ok);
 
-            if (!ret)
+        for (auto& batch_it : batches)
+        {
+            for (size_t cnt = 0; cnt < batch_it.size(); ++cnt)
             {
-                transformation_errors++;
-                continue;
-            }
-
-            write_lat_vec.set(update_cnt, lat);
-            write_lon_vec.set(update_cnt, lon);
-            write_rec_num_vec.set(update_cnt, rec_num);
+                if (!batch_it.ok_[cnt])
+                    continue;
 
-            update_cnt++;
+                write_lat_vec.fill(update_cnt, batch_it.latitudes_[cnt]);
+                write_lon_vec.fill(update_cnt, batch_it.longitudes_[cnt]);
+                write_rec_num_vec.fill(update_cnt, read_rec_num_vec.get(batch_it.indexes_[cnt]));
 
-            // loginf << "uga cnt " << update_cnt << " rec_num " << rec_num << " lat " << lat << " long
-            // " << lon;
+                update_cnt++;
+            }
         }
 
+        assert (update_cnt == num_ok);
+
+        write_lat_vec.finishFill(update_cnt);
+        write_lon_vec.finishFill(update_cnt);
+        write_rec_num_vec.finishFill(update_cnt);
+
         logdbg << "RadarPlotPositionCalculatorTask: loadingDoneSlot: update_buffer size "
            << update_buffer->size() << ", " << transformation_errors << " transformation errors";
 
@@ -17,6 +17,8 @@
 
 #include "asterixdecodejob.h"
 #include "asteriximporttask.h"
+#include "asterixrecordmapper.h"
+#include "buffer.h"
 #include "json.h"
 #include "logger.h"
 #include "stringconv.h"
@@ -32,8 +34,15 @@
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include "util/tbbhack.h"
 
 #include <chrono>
+#include <cstring>
+#include <fstream>
+#include <future>
 #include <thread>
 #include <memory>
 
@@ -58,12 +67,13 @@ ASTERIXDecodeJob::~ASTERIXDecodeJob()
 }
 
 void ASTERIXDecodeJob::setDecodeFile (const std::string& filename,
-                                      const std::string& framing)
+                                      const std::string& framing, unsigned int line_id)
 {
-    loginf << "ASTERIXDecodeJob: setDecodeFile: file '" << filename << "' framing '" << framing << "'";
+    loginf << "ASTERIXDecodeJob: setDecodeFile: file '" << filename << "' framing '" << framing
+           << "' line " << line_id;
 
     filename_ = filename;
-    file_line_id_ = task_.fileLineID();
+    file_line_id_ = line_id;
     framing_ = framing;
 
     assert (Files::fileExists(filename));
@@ -95,6 +105,32 @@ void ASTERIXDecodeJob::setDecodeUDPStreams (
     framing_ = ""; // only netto content
 }
 
+void ASTERIXDecodeJob::setDecoders (const std::vector<std::shared_ptr<jASTERIX::jASTERIX>>& decoders)
+{
+    assert (!started_);
+    assert (decoders.size());
+
+    decoders_ = decoders;
+}
+
+void ASTERIXDecodeJob::maxExtractedQueued (unsigned int value)
+{
+    {
+        std::lock_guard<std::mutex> lock(extracted_mutex_);
+        max_extracted_queued_ = value;
+    }
+
+    extracted_condition_.notify_all();
+}
+
+jASTERIX::jASTERIX& ASTERIXDecodeJob::decoder()
+{
+    if (decoders_.size())
+        return *decoders_.at(0);
+
+    return *task_.jASTERIX();
+}
+
 void ASTERIXDecodeJob::run()
 {
     loginf << "ASTERIXDecodeJob: run";
@@ -103,6 +139,14 @@ void ASTERIXDecodeJob::run()
 
     start_time_ = boost::posix_time::microsec_clock::local_time();;
 
+    direct_mapping_ = task_.directBufferMapping();
+
+    if (direct_mapping_)
+    {
+        assert (task_.schema());
+        record_mapper_.reset(new ASTERIXRecordMapper(task_.schema()->parsers()));
+    }
+
     started_ = true;
     done_ = false;
 
@@ -111,8 +155,13 @@ void ASTERIXDecodeJob::run()
     else if (decode_udp_streams_)
         doUDPStreamDecoding();
 
+    if (direct_mapping_) // last mapped data
+        handOutBuffers(finishMapping());
+
+    waitForExtraction(true); // queued data
+
     if (!obsolete_)
-        assert(extracted_data_.size() == 0);
+        assert(extracted_data_.size() == 0 && extracted_buffers_.size() == 0);
 
     done_ = true;
 
@@ -123,10 +172,15 @@ void ASTERIXDecodeJob::setObsolete()
 {
     loginf << "ASTERIXDecodeJob: setObsolete";
 
-    Job::setObsolete();
+    {
+        std::lock_guard<std::mutex> lock(extracted_mutex_);
+        Job::setObsolete();
+    }
+
+    extracted_condition_.notify_all();
 
     if (decode_file_)
-        task_.jASTERIX()->stopFileDecoding();
+        decoder().stopFileDecoding();
     else
         receive_semaphore_.post(); // wake up loop
 }
@@ -137,6 +191,25 @@ void ASTERIXDecodeJob::doFileDecoding()
 
     assert (decode_file_);
 
+    unsigned int num_threads = decoders_.size() ? decoders_.size() : task_.numFileDecodeThreads();
+
+    if (num_threads > 1 && file_size_ > 4 * PARALLEL_DECODE_CHUNK_SIZE)
+    {
+        if (framing_ == "")
+        {
+            doParallelFileDecoding(num_threads, nullptr);
+            return;
+        }
+
+        FrameLayout layout;
+
+        if (frameLayout(layout) && doParallelFileDecoding(num_threads, &layout))
+            return;
+
+        logwrn << "ASTERIXDecodeJob: doFileDecoding: framing '" << framing_
+               << "' can not be split at frame borders, decoding serially";
+    }
+
     auto callback = [this](std::unique_ptr<nlohmann::json> data, size_t num_frames,
             size_t num_records, size_t numErrors) {
         this->fileJasterixCallback(std::move(data), this->file_line_id_, num_frames, num_records, numErrors);
@@ -145,9 +218,9 @@ void ASTERIXDecodeJob::doFileDecoding()
     try
     {
         if (framing_ == "")
-            task_.jASTERIX()->decodeFile(filename_, callback);
+            decoder().decodeFile(filename_, callback);
         else
-            task_.jASTERIX()->decodeFile(filename_, framing_, callback);
+            decoder().decodeFile(filename_, framing_, callback);
     }
     catch (std::exception& e)
     {
@@ -157,6 +230,398 @@ void ASTERIXDecodeJob::doFileDecoding()
     }
 }
 
+bool ASTERIXDecodeJob::doParallelFileDecoding(unsigned int num_threads, const FrameLayout* layout)
+{
+    // current wave is processed while next one is decoded
+    num_threads = std::min(num_threads, PARALLEL_DECODE_MAX_CHUNKS / 2);
+
+    loginf << "ASTERIXDecodeJob: doParallelFileDecoding: file '" << filename_ << "' framing '" << framing_
+           << "' threads " << num_threads;
+
+    assert ((framing_ == "") == (layout == nullptr));
+
+    std::unique_ptr<boost::interprocess::file_mapping> mapping;
+    std::unique_ptr<boost::interprocess::mapped_region> region;
+
+    try
+    {
+        // private pages, since decodeData takes non-const data. the file is never written
+        mapping.reset(new boost::interprocess::file_mapping(filename_.c_str(), boost::interprocess::read_only));
+        region.reset(new boost::interprocess::mapped_region(*mapping, boost::interprocess::copy_on_write));
+        region->advise(boost::interprocess::mapped_region::advice_sequential);
+    }
+    catch (std::exception& e)
+    {
+        logerr << "ASTERIXDecodeJob: doParallelFileDecoding: mapping error '" << e.what() << "'";
+        error_ = true;
+        error_message_ = e.what();
+        return true;
+    }
+
+    char* file_data = static_cast<char*>(region->get_address());
+    size_t file_size = region->get_size();
+
+    // frames are checked up front, since a serial fallback is only possible before anything is processed
+    if (layout && !checkFrames(file_data, file_size, *layout))
+        return false;
+
+    // frame contents are decoded as netto data
+    decoded_unframed_ = layout != nullptr;
+
+    // one decoder per thread
+    std::vector<std::shared_ptr<jASTERIX::jASTERIX>> decoders =
+            decoders_.size() ? decoders_ : task_.fileDecoders(num_threads);
+    assert (decoders.size() >= num_threads);
+
+    // only used by one wave at a time
+    size_t next_chunk_start = layout ? layout->file_header_size : 0;
+
+    // finds the next num_threads chunks of whole data blocks or frames and decodes them in parallel
+    auto decode_wave = [&] (std::vector<DecodedChunk>& chunks)
+    {
+        std::vector<std::pair<size_t, size_t>> ranges; // offset, size
+
+        while (ranges.size() < num_threads && next_chunk_start < file_size)
+        {
+            size_t index = next_chunk_start;
+
+            if (layout)
+            {
+                size_t content_begin, content_size, frame_end;
+
+                while (index < file_size && index - next_chunk_start < PARALLEL_DECODE_CHUNK_SIZE)
+                {
+                    bool frame_ok = readFrame(file_data, file_size, index, *layout, content_begin, content_size,
+                                              frame_end);
+                    assert (frame_ok); // checked before
+                    index = frame_end;
+                }
+
+                ranges.emplace_back(next_chunk_start, index - next_chunk_start);
+                next_chunk_start = index;
+                continue;
+            }
+
+            while (index + 3 <= file_size && index - next_chunk_start < PARALLEL_DECODE_CHUNK_SIZE)
+            {
+                size_t length = ((unsigned char) file_data[index+1] << 8) + (unsigned char) file_data[index+2];
+
+                if (length < 3 || index + length > file_size) // invalid, remainder is decoded as one chunk
+                {
+                    index = file_size;
+                    break;
+                }
+
+                index += length;
+            }
+
+            if (index + 3 > file_size) // add trailing bytes
+                index = file_size;
+
+            ranges.emplace_back(next_chunk_start, index - next_chunk_start);
+            next_chunk_start = index;
+        }
+
+        chunks.clear();
+        chunks.resize(ranges.size());
+
+        tbb::parallel_for(uint(0), (unsigned int) ranges.size(), [&](unsigned int cnt)
+        {
+            DecodedChunk& chunk = chunks.at(cnt);
+            chunk.offset = ranges.at(cnt).first;
+
+            if (obsolete_)
+                return;
+
+            auto callback = [&chunk](std::unique_ptr<nlohmann::json> data, size_t num_frames,
+                    size_t num_records, size_t num_errors)
+            {
+                size_t num_data_records = 0;
+
+                if (data && data->contains("data_blocks"))
+                {
+                    for (json& data_block : data->at("data_blocks"))
+                    {
+                        if (data_block.contains("content") && data_block.at("content").contains("records"))
+                            num_data_records += data_block.at("content").at("records").size();
+                    }
+                }
+
+                chunk.data.emplace_back(std::move(data));
+                chunk.num_records.push_back(num_data_records);
+                chunk.num_errors = num_errors;
+            };
+
+            char* chunk_data = file_data + chunk.offset;
+            size_t chunk_size = ranges.at(cnt).second;
+
+            if (layout) // collect frame contents
+            {
+                size_t index = chunk.offset;
+                size_t content_begin, content_size, frame_end;
+
+                chunk.frame_contents.reserve(chunk_size);
+
+                while (index < chunk.offset + chunk_size)
+                {
+                    readFrame(file_data, file_size, index, *layout, content_begin, content_size, frame_end);
+                    chunk.frame_contents.insert(chunk.frame_contents.end(), file_data + content_begin,
+                                                file_data + content_begin + content_size);
+                    index = frame_end;
+                }
+
+                if (!chunk.frame_contents.size())
+                    return;
+
+                chunk_data = chunk.frame_contents.data();
+                chunk_size = chunk.frame_contents.size();
+            }
+
+            try
+            {
+                decoders.at(cnt)->decodeData(chunk_data, chunk_size, callback);
+            }
+            catch (std::exception& e)
+            {
+                chunk.error = true;
+                chunk.error_message = e.what();
+            }
+        });
+    };
+
+    std::vector<DecodedChunk> chunks;
+    std::vector<DecodedChunk> next_chunks;
+    std::future<void> next_wave;
+
+    size_t total_records = 0;
+    size_t total_errors = 0;
+
+    decode_wave(chunks);
+
+    while (chunks.size())
+    {
+        // decode next wave while processing the current one
+        if (next_chunk_start < file_size && !obsolete_)
+            next_wave = std::async(std::launch::async, decode_wave, std::ref(next_chunks));
+        else
+            next_chunks.clear();
+
+        for (auto& chunk : chunks)
+        {
+            if (obsolete_ || error_)
+                break;
+
+            if (chunk.error)
+            {
+                logerr << "ASTERIXDecodeJob: doParallelFileDecoding: decoding error '" << chunk.error_message
+                       << "' at offset " << chunk.offset;
+                error_ = true;
+                error_message_ = chunk.error_message;
+                break;
+            }
+
+            index_offset_ = chunk.offset;
+
+            for (size_t cnt = 0; cnt < chunk.data.size(); ++cnt)
+            {
+                total_records += chunk.num_records.at(cnt);
+
+                fileJasterixCallback(std::move(chunk.data.at(cnt)), file_line_id_, 0, total_records,
+                                     total_errors + chunk.num_errors);
+            }
+
+            total_errors += chunk.num_errors;
+        }
+
+        if (next_wave.valid())
+            next_wave.wait();
+
+        if (obsolete_ || error_)
+            break;
+
+        std::swap(chunks, next_chunks);
+    }
+
+    index_offset_ = 0;
+
+    loginf << "ASTERIXDecodeJob: doParallelFileDecoding: done, records " << total_records
+           << " errors " << total_errors;
+
+    return true;
+}
+
+bool ASTERIXDecodeJob::frameLayout (FrameLayout& layout)
+{
+    std::string filename = HOME_DATA_DIRECTORY + "jasterix_definitions/framings/" + framing_ + ".json";
+
+    if (!Files::fileExists(filename))
+    {
+        logwrn << "ASTERIXDecodeJob: frameLayout: framing definition '" << filename << "' not found";
+        return false;
+    }
+
+    json definition;
+
+    try
+    {
+        std::ifstream input_file(filename, std::ifstream::in);
+        definition = json::parse(input_file);
+    }
+    catch (json::exception& e)
+    {
+        logwrn << "ASTERIXDecodeJob: frameLayout: could not load framing definition '" << filename
+               << "': " << e.what();
+        return false;
+    }
+
+    layout = FrameLayout();
+
+    // only fixed size file header and frame items, except one content item with a preceding uint length
+
+    if (definition.contains("file_header_items"))
+    {
+        for (const json& item : definition.at("file_header_items"))
+        {
+            std::string type = item.value("type", std::string());
+
+            if ((type != "fixed_bytes" && type != "skip_bytes") || !item.contains("length"))
+                return false;
+
+            layout.file_header_size += item.at("length").get<size_t>();
+        }
+    }
+
+    if (!definition.contains("frame_items"))
+        return false;
+
+    std::map<std::string, std::pair<size_t, const json*>> fixed_items; // name -> offset, item
+    size_t offset = 0;
+    bool content_found = false;
+
+    for (const json& item : definition.at("frame_items"))
+    {
+        std::string type = item.value("type", std::string());
+
+        if (type == "fixed_bytes" || type == "skip_bytes")
+        {
+            if (!item.contains("length"))
+                return false;
+
+            size_t length = item.at("length").get<size_t>();
+
+            if (content_found)
+            {
+                layout.trailer_size += length;
+                continue;
+            }
+
+            if (item.contains("name"))
+                fixed_items[item.at("name").get<std::string>()] = {offset, &item};
+
+            offset += length;
+        }
+        else if (type == "dynamic_bytes" && !content_found)
+        {
+            std::string length_variable = item.value("length_variable", std::string());
+
+            if (!fixed_items.count(length_variable))
+                return false;
+
+            const json& length_item = *fixed_items.at(length_variable).second;
+
+            if (length_item.value("type", std::string()) != "fixed_bytes"
+                    || length_item.value("data_type", std::string()) != "uint")
+                return false;
+
+            layout.length_offset = fixed_items.at(length_variable).first;
+            layout.length_size = length_item.at("length").get<size_t>();
+            layout.length_reverse = length_item.value("reverse_bytes", false);
+
+            if (!layout.length_size || layout.length_size > 4)
+                return false;
+
+            layout.content_offset = offset;
+            layout.content_length_add = item.value("additative_factor", 0);
+
+            if (item.value("substract_previous", false))
+                layout.content_length_add -= (long) offset;
+
+            content_found = true;
+        }
+        else
+            return false;
+    }
+
+    return content_found;
+}
+
+bool ASTERIXDecodeJob::readFrame (const char* data, size_t size, size_t index, const FrameLayout& layout,
+                                  size_t& content_begin, size_t& content_size, size_t& frame_end)
+{
+    if (index + layout.content_offset > size)
+        return false;
+
+    size_t length = 0;
+
+    for (size_t cnt = 0; cnt < layout.length_size; ++cnt)
+    {
+        size_t byte_index = layout.length_reverse ? layout.length_size - 1 - cnt : cnt;
+        length = (length << 8) + (unsigned char) data[index + layout.length_offset + byte_index];
+    }
+
+    long content_length = (long) length + layout.content_length_add;
+
+    if (content_length < 0)
+        return false;
+
+    content_begin = index + layout.content_offset;
+    content_size = content_length;
+    frame_end = content_begin + content_size + layout.trailer_size;
+
+    return frame_end <= size;
+}
+
+bool ASTERIXDecodeJob::checkFrames (const char* data, size_t size, const FrameLayout& layout)
+{
+    if (layout.file_header_size > size)
+        return false;
+
+    size_t index = layout.file_header_size;
+    size_t content_begin, content_size, frame_end;
+
+    while (index < size)
+    {
+        if (!readFrame(data, size, index, layout, content_begin, content_size, frame_end))
+        {
+            loginf << "ASTERIXDecodeJob: checkFrames: invalid frame at offset " << index;
+            return false;
+        }
+
+        size_t content_end = content_begin + content_size;
+        size_t block_index = content_begin;
+
+        while (block_index < content_end) // whole data blocks
+        {
+            if (block_index + 3 > content_end)
+                return false;
+
+            size_t length = ((unsigned char) data[block_index+1] << 8) + (unsigned char) data[block_index+2];
+
+            if (length < 3 || block_index + length > content_end)
+            {
+                loginf << "ASTERIXDecodeJob: checkFrames: invalid data block in frame at offset " << index;
+                return false;
+            }
+
+            block_index += length;
+        }
+
+        index = frame_end;
+    }
+
+    return true;
+}
+
 void ASTERIXDecodeJob::doUDPStreamDecoding()
 {
     assert (decode_udp_streams_);
@@ -186,11 +651,11 @@ void ASTERIXDecodeJob::doUDPStreamDecoding()
             loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: setting up ds_id " << ds_it.first
                    << " line " << line << " info " << line_it.second->asString();
 
-            auto data_callback = [this,line](const char* data, unsigned int length) {
-                this->storeReceivedData(line, data, length);
+            auto batch_callback = [this,line](const std::vector<UDPDatagram>& batch) {
+                this->storeReceivedData(line, batch);
             };
 
-            udp_receivers.emplace_back(new UDPReceiver(io_context, line_it.second, data_callback, MAX_UDP_READ_SIZE));
+            udp_receivers.emplace_back(new UDPReceiver(io_context, line_it.second, batch_callback, MAX_UDP_READ_SIZE));
 
             ++line_cnt;
 
@@ -222,24 +687,41 @@ void ASTERIXDecodeJob::doUDPStreamDecoding()
                     && (boost::posix_time::microsec_clock::local_time()
                         - last_receive_decode_time_).total_milliseconds() > 1000)
             {
-                loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: copying data "
-                       << receive_buffer_sizes_.size() << " buffers  max " << MAX_ALL_RECEIVE_SIZE;
+                loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: swapping data "
+                       << receive_buffer_sizes_.size() << " buffers";
 
-                // copy data
-                for (auto& size_it : receive_buffer_sizes_)
+                for (auto& dropped_it : num_dropped_datagrams_)
                 {
-                    line_id = size_it.first;
+                    logwrn << "ASTERIXDecodeJob: doUDPStreamDecoding: line " << dropped_it.first
+                           << " dropped " << dropped_it.second << " datagrams with "
+                           << num_dropped_bytes_.at(dropped_it.first) << " bytes, receive buffer full";
+                }
 
-                    assert (receive_buffers_.count(line_id));
+                num_dropped_datagrams_.clear();
+                num_dropped_bytes_.clear();
 
-                    assert (receive_buffer_sizes_.at(line_id) <= MAX_ALL_RECEIVE_SIZE);
+                if (num_receive_latencies_)
+                {
+                    logdbg << "ASTERIXDecodeJob: doUDPStreamDecoding: receive latency avg "
+                           << String::doubleToStringPrecision(receive_latency_sum_ms_ / num_receive_latencies_, 2)
+                           << " ms max " << String::doubleToStringPrecision(receive_latency_max_ms_, 2)
+                           << " ms over " << num_receive_latencies_ << " datagrams";
+
+                    num_receive_latencies_ = 0;
+                    receive_latency_sum_ms_ = 0;
+                    receive_latency_max_ms_ = 0;
+                }
 
-                    if (!receive_buffers_copy_.count(line_id))
-                        receive_buffers_copy_[line_id].reset(new boost::array<char, MAX_ALL_RECEIVE_SIZE>());
+                // move received data into decode buffers, receiving continues in new chunks
+                for (auto& size_it : receive_buffer_sizes_)
+                {
+                    line_id = size_it.first;
 
-                    *receive_buffers_copy_.at(line_id) = *receive_buffers_.at(line_id);
-                    receive_copy_buffer_sizes_[line_id] = size_it.second;
+                    assert (receive_buffers_.count(line_id));
+                    assert (size_it.second <= MAX_ALL_RECEIVE_SIZE);
 
+                    receive_buffers_copy_[line_id].swap(receive_buffers_.at(line_id));
+                    assert (!receive_buffers_.at(line_id).size());
                 }
 
                 receive_buffer_sizes_.clear();
@@ -248,32 +730,56 @@ void ASTERIXDecodeJob::doUDPStreamDecoding()
 
                 last_receive_decode_time_ = boost::posix_time::microsec_clock::local_time();
 
-                loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: processing copied data";
+                loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: processing swapped data";
 
-                for (auto& size_it : receive_copy_buffer_sizes_)
+                for (auto& chunks_it : receive_buffers_copy_)
                 {
-                    line_id = size_it.first;
-
-                    assert (receive_buffers_copy_.count(line_id));
+                    line_id = chunks_it.first;
 
                     auto callback = [this, line_id](std::unique_ptr<nlohmann::json> data, size_t num_frames,
                             size_t num_records, size_t numErrors) {
                         this->netJasterixCallback(std::move(data), line_id, num_frames, num_records, numErrors);
                     };
 
-                    task_.jASTERIX()->decodeData((char*) receive_buffers_copy_.at(line_id)->data(),
-                                                 size_it.second, callback);
+                    for (auto& chunk : chunks_it.second) // contain whole datagrams
+                        task_.jASTERIX()->decodeData(chunk.data(), chunk.size(), callback);
                 }
 
                 loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: done";
 
-                receive_copy_buffer_sizes_.clear();
+                // keep some chunks for reuse
+                {
+                    boost::mutex::scoped_lock free_lock(receive_buffers_mutex_);
+
+                    for (auto& chunks_it : receive_buffers_copy_)
+                    {
+                        for (auto& chunk : chunks_it.second)
+                        {
+                            if (free_receive_chunks_.size() == MAX_FREE_RECEIVE_CHUNKS)
+                                break;
+
+                            chunk.clear();
+                            free_receive_chunks_.push_back(std::move(chunk));
+                        }
+                    }
+                }
+
+                receive_buffers_copy_.clear();
 
-                loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: emitting signal";
-                emit decodedASTERIXSignal();
+                if (direct_mapping_) // handed out without delay
+                {
+                    startMapping(std::move(net_mapping_data_), {"data_blocks", "content", "records"});
+                    net_mapping_data_.clear();
 
-                while (!obsolete_ && extracted_data_.size())  // block decoder until extracted records have been moved out
-                    QThread::msleep(1);
+                    handOutBuffers(finishMapping()); // meanwhile received data is buffered
+                }
+                else
+                {
+                    loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: emitting signal";
+                    emit decodedASTERIXSignal();
+
+                    waitForExtraction(); // meanwhile received data is buffered
+                }
 
             }
         }
@@ -291,36 +797,198 @@ void ASTERIXDecodeJob::doUDPStreamDecoding()
     loginf << "ASTERIXDecodeJob: doUDPStreamDecoding: done";
 }
 
-void ASTERIXDecodeJob::storeReceivedData (unsigned int line, const char* data, unsigned int length) // const std::string& sender_id,
+void ASTERIXDecodeJob::storeReceivedData (unsigned int line, const std::vector<UDPDatagram>& batch)
 {
     if (obsolete_)
         return;
 
-    //loginf << "ASTERIXDecodeJob: storeReceivedData: sender " << sender_id;
+    boost::posix_time::ptime now = boost::posix_time::microsec_clock::universal_time();
 
-    boost::mutex::scoped_lock lock(receive_buffers_mutex_);
+    boost::mutex::scoped_lock lock(receive_buffers_mutex_); // once per batch
+
+    std::vector<std::vector<char>>& chunks = receive_buffers_[line];
+    size_t& buffer_size = receive_buffer_sizes_[line];
+    double latency_ms;
 
-    if (length + receive_buffer_sizes_[line] >= MAX_ALL_RECEIVE_SIZE)
+    for (auto& datagram : batch)
     {
-        logerr << "ASTERIXDecodeJob: storeReceivedData: overload, too much data in buffer";
-        return;
-    }
+        if (datagram.length + buffer_size > MAX_ALL_RECEIVE_SIZE) // counted, reported on next decode
+        {
+            ++num_dropped_datagrams_[line];
+            num_dropped_bytes_[line] += datagram.length;
+            ++num_dropped_datagrams_total_;
+            num_dropped_bytes_total_ += datagram.length;
+            continue;
+        }
 
-    if (!receive_buffers_.count(line))
-        receive_buffers_[line].reset(new boost::array<char, MAX_ALL_RECEIVE_SIZE>());
+        // datagrams are not split over chunks
+        if (!chunks.size() || chunks.back().size() + datagram.length > chunks.back().capacity())
+            chunks.push_back(receiveChunk(datagram.length));
 
-    assert (receive_buffers_[line]);
+        chunks.back().insert(chunks.back().end(), datagram.data, datagram.data + datagram.length);
+        buffer_size += datagram.length;
 
-    for (unsigned int cnt=0; cnt < length; ++cnt)
-        receive_buffers_[line]->at(receive_buffer_sizes_[line]+cnt) = data[cnt];
+        if (!datagram.receive_time.is_not_a_date_time())
+        {
+            latency_ms = (now - datagram.receive_time).total_microseconds() / 1000.0;
 
-    receive_buffer_sizes_[line] += length;
+            ++num_receive_latencies_;
+            receive_latency_sum_ms_ += latency_ms;
+            receive_latency_max_ms_ = max(receive_latency_max_ms_, latency_ms);
+        }
+    }
 
     lock.unlock();
 
     receive_semaphore_.post();
 }
 
+void ASTERIXDecodeJob::waitForExtraction(bool all)
+{
+    std::unique_lock<std::mutex> lock(extracted_mutex_);
+
+    extracted_condition_.wait(lock, [this, all] {
+        return obsolete_ || num_extracted_queued_ <= (all ? 0 : max_extracted_queued_); });
+}
+
+void ASTERIXDecodeJob::startMapping(std::vector<std::unique_ptr<nlohmann::json>> data,
+                                    const std::vector<std::string>& keys)
+{
+    assert (direct_mapping_ && record_mapper_);
+    assert (!mapping_.valid());
+
+    mapping_data_ = std::move(data);
+
+    mapping_ = std::async(std::launch::async, [this, keys] ()
+    {
+        auto map_lambda = [this](nlohmann::json& record) {
+            if (obsolete_)
+                return;
+
+            record_mapper_->mapRecord(record);
+        };
+
+        for (auto& data_slice : mapping_data_)
+        {
+            if (data_slice)
+                JSON::applyFunctionToValues(*data_slice, keys, keys.begin(), map_lambda, false);
+        }
+
+        mapping_data_.clear(); // decoded json not required anymore
+    });
+}
+
+std::map<std::string, std::shared_ptr<Buffer>> ASTERIXDecodeJob::finishMapping()
+{
+    if (!mapping_.valid())
+        return {};
+
+    try
+    {
+        mapping_.get();
+    }
+    catch (std::exception& e)
+    {
+        logerr << "ASTERIXDecodeJob: finishMapping: mapping error '" << e.what() << "'";
+        error_ = true;
+        error_message_ = e.what();
+    }
+
+    return record_mapper_->buffers();
+}
+
+void ASTERIXDecodeJob::handOutBuffers(std::map<std::string, std::shared_ptr<Buffer>> buffers)
+{
+    if (obsolete_ || !buffers.size())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(extracted_mutex_);
+
+        for (auto& buf_it : buffers) // append to queued buffers
+        {
+            if (extracted_buffers_.count(buf_it.first))
+                extracted_buffers_.at(buf_it.first)->seizeBuffer(*buf_it.second);
+            else
+                extracted_buffers_[buf_it.first] = buf_it.second;
+        }
+
+        ++num_extracted_queued_;
+    }
+
+    emit decodedASTERIXSignal();
+
+    waitForExtraction();
+}
+
+bool ASTERIXDecodeJob::hasData()
+{
+    std::lock_guard<std::mutex> lock(extracted_mutex_);
+
+    return extracted_data_.size() || extracted_buffers_.size();
+}
+
+std::vector<std::unique_ptr<nlohmann::json>> ASTERIXDecodeJob::extractedData()
+{
+    std::vector<std::unique_ptr<nlohmann::json>> data;
+
+    {
+        std::lock_guard<std::mutex> lock(extracted_mutex_);
+        data = std::move(extracted_data_);
+        extracted_data_.clear(); // defined state after move
+        num_extracted_queued_ = 0;
+    }
+
+    extracted_condition_.notify_all();
+
+    return data;
+}
+
+std::map<std::string, std::shared_ptr<Buffer>> ASTERIXDecodeJob::extractedBuffers()
+{
+    std::map<std::string, std::shared_ptr<Buffer>> buffers;
+
+    {
+        std::lock_guard<std::mutex> lock(extracted_mutex_);
+        buffers = std::move(extracted_buffers_);
+        extracted_buffers_.clear();
+        num_extracted_queued_ = 0;
+    }
+
+    extracted_condition_.notify_all();
+
+    return buffers;
+}
+
+std::vector<char> ASTERIXDecodeJob::receiveChunk (size_t size)
+{
+    std::vector<char> chunk;
+
+    if (free_receive_chunks_.size() && free_receive_chunks_.back().capacity() >= size)
+    {
+        chunk = std::move(free_receive_chunks_.back());
+        free_receive_chunks_.pop_back();
+    }
+    else
+        chunk.reserve(std::max(size, (size_t) RECEIVE_CHUNK_SIZE));
+
+    assert (!chunk.size());
+
+    return chunk;
+}
+
+size_t ASTERIXDecodeJob::numDroppedDatagrams()
+{
+    boost::mutex::scoped_lock lock(receive_buffers_mutex_);
+    return num_dropped_datagrams_total_;
+}
+
+size_t ASTERIXDecodeJob::numDroppedBytes()
+{
+    boost::mutex::scoped_lock lock(receive_buffers_mutex_);
+    return num_dropped_bytes_total_;
+}
+
 void ASTERIXDecodeJob::fileJasterixCallback(std::unique_ptr<nlohmann::json> data, unsigned int line_id, size_t num_frames,
                                          size_t num_records, size_t num_errors)
 {
@@ -342,11 +1010,8 @@ void ASTERIXDecodeJob::fileJasterixCallback(std::unique_ptr<nlohmann::json> data
         return;
     }
 
-    assert(!extracted_data_.size());
-    extracted_data_.emplace_back(std::move(data));
-    assert(extracted_data_.size());
-    assert(extracted_data_.back());
-    assert(extracted_data_.back()->is_object());
+    assert(data);
+    assert(data->is_object());
 
     num_frames_ = num_frames;
     num_records_ = num_records;
@@ -368,14 +1033,14 @@ void ASTERIXDecodeJob::fileJasterixCallback(std::unique_ptr<nlohmann::json> data
 
     max_index_ = 0;
 
-    if (framing_ == "")
+    if (framing_ == "" || decoded_unframed_)
     {
-        assert(extracted_data_.back()->contains("data_blocks"));
-        assert(extracted_data_.back()->at("data_blocks").is_array());
+        assert(data->contains("data_blocks"));
+        assert(data->at("data_blocks").is_array());
 
         std::vector<std::string> keys{"content", "records"};
 
-        for (json& data_block : extracted_data_.back()->at("data_blocks"))
+        for (json& data_block : data->at("data_blocks"))
         {
             if (!data_block.contains("category"))
             {
@@ -389,7 +1054,8 @@ void ASTERIXDecodeJob::fileJasterixCallback(std::unique_ptr<nlohmann::json> data
             assert (data_block.contains("content"));
             assert(data_block.at("content").is_object());
             assert (data_block.at("content").contains("index"));
-            max_index_ = data_block.at("content").at("index");
+            // for decoded frame contents only approximate, since frame headers are not counted
+            max_index_ = index_offset_ + (size_t) data_block.at("content").at("index");
 
             if (category == 1)
                 checkCAT001SacSics(data_block);
@@ -401,12 +1067,12 @@ void ASTERIXDecodeJob::fileJasterixCallback(std::unique_ptr<nlohmann::json> data
     }
     else
     {
-        assert(extracted_data_.back()->contains("frames"));
-        assert(extracted_data_.back()->at("frames").is_array());
+        assert(data->contains("frames"));
+        assert(data->at("frames").is_array());
 
         std::vector<std::string> keys{"content", "records"};
 
-        for (json& frame : extracted_data_.back()->at("frames"))
+        for (json& frame : data->at("frames"))
         {
             if (!frame.contains("content"))  // frame with errors
                 continue;
@@ -449,10 +1115,33 @@ void ASTERIXDecodeJob::fileJasterixCallback(std::unique_ptr<nlohmann::json> data
 //    while (!obsolete_ && pause_)  // block decoder until unpaused
 //        QThread::msleep(1);
 
+    if (direct_mapping_)
+    {
+        // records of this data are mapped while previously mapped buffers are handed out
+        std::map<std::string, std::shared_ptr<Buffer>> buffers = finishMapping();
+
+        std::vector<std::unique_ptr<nlohmann::json>> mapping_data;
+        mapping_data.emplace_back(std::move(data));
+
+        if (framing_ == "" || decoded_unframed_)
+            startMapping(std::move(mapping_data), {"data_blocks", "content", "records"});
+        else
+            startMapping(std::move(mapping_data), {"frames", "content", "data_blocks", "content", "records"});
+
+        handOutBuffers(std::move(buffers));
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(extracted_mutex_);
+        extracted_data_.emplace_back(std::move(data));
+        ++num_extracted_queued_;
+    }
+
     emit decodedASTERIXSignal();
 
-    while (!obsolete_ && extracted_data_.size())  // block decoder until extracted records have been moved out
-        QThread::msleep(1);
+    waitForExtraction();
 
 //    if (!obsolete_)
 //        assert(!extracted_data_);
@@ -530,7 +1219,9 @@ void ASTERIXDecodeJob::netJasterixCallback(std::unique_ptr<nlohmann::json> data,
     //    while (!obsolete_ && pause_)  // block decoder until unpaused
     //        QThread::msleep(1);
 
-    if (data->at("data_blocks").size())
+    if (direct_mapping_) // mapped after all lines were decoded
+        net_mapping_data_.emplace_back(std::move(data));
+    else if (data->at("data_blocks").size())
     {
 //        if (extracted_data_)
 //        {
@@ -548,7 +1239,9 @@ void ASTERIXDecodeJob::netJasterixCallback(std::unique_ptr<nlohmann::json> data,
 //        else
 //            extracted_data_ = std::move(tmp_extracted_data);
 
+        std::lock_guard<std::mutex> lock(extracted_mutex_);
         extracted_data_.emplace_back(std::move(data));
+        ++num_extracted_queued_;
     }
 
 }
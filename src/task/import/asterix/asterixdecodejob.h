@@ -24,16 +24,33 @@
 #include "json.hpp"
 #include "datasourcelineinfo.h"
 
-#include <boost/array.hpp>
 #include <boost/interprocess/sync/interprocess_semaphore.hpp>
 #include <boost/date_time/posix_time/posix_time.hpp>
 #include <boost/thread/mutex.hpp>
 
+#include <condition_variable>
+#include <future>
+#include <mutex>
+
+namespace jASTERIX
+{
+class jASTERIX;
+}
+
 class ASTERIXImportTask;
 class ASTERIXPostProcess;
+class ASTERIXRecordMapper;
+class Buffer;
+struct UDPDatagram;
 
 const unsigned int MAX_UDP_READ_SIZE=1024*1024;
-const unsigned int MAX_ALL_RECEIVE_SIZE=100*1024*1024;
+// max received data buffered per line while decoding is stalled, datagrams beyond are dropped and counted
+const size_t MAX_ALL_RECEIVE_SIZE=1024*1024*1024;
+const unsigned int RECEIVE_CHUNK_SIZE=4*1024*1024; // received data is stored in chunks, allocated as needed
+const unsigned int MAX_FREE_RECEIVE_CHUNKS=8; // kept for reuse
+const unsigned int PARALLEL_DECODE_CHUNK_SIZE=1024*1024; // bytes of data blocks decoded by one thread at once
+// chunks decoded or held as json in both waves, bounds memory independent of number of threads
+const unsigned int PARALLEL_DECODE_MAX_CHUNKS=16;
 
 class ASTERIXDecodeJob : public Job
 {
@@ -46,12 +63,18 @@ class ASTERIXDecodeJob : public Job
     virtual ~ASTERIXDecodeJob();
 
     void setDecodeFile (const std::string& filename,
-                        const std::string& framing);
+                        const std::string& framing, unsigned int line_id);
 
     void setDecodeUDPStreams (
             const std::map<unsigned int, std::map<std::string, std::shared_ptr<DataSourceLineInfo>>>& ds_lines);
     // ds_id -> (ip,port)
 
+    // decoders used by this job only, more than one for parallel file decoding. task's decoder if not set
+    void setDecoders (const std::vector<std::shared_ptr<jASTERIX::jASTERIX>>& decoders);
+    const std::vector<std::shared_ptr<jASTERIX::jASTERIX>>& decoders() const { return decoders_; }
+    // number of hand-outs kept while decoding continues, 0 = decoding waits until data was taken
+    void maxExtractedQueued (unsigned int value);
+
     virtual void run() override;
     virtual void setObsolete() override;
 
@@ -62,14 +85,27 @@ class ASTERIXDecodeJob : public Job
 //    void pause() { pause_ = true; }
 //    void unpause() { pause_ = false; }
 
-    bool hasData() { return extracted_data_.size();}
+    bool hasData();
 
     bool error() const;
     std::string errorMessage() const;
 
     std::map<unsigned int, size_t> categoryCounts() const;
 
-    std::vector<std::unique_ptr<nlohmann::json>> extractedData() { return std::move(extracted_data_); } // ds_id -> (ip,port)
+    // moving out extracted data resumes decoding
+    std::vector<std::unique_ptr<nlohmann::json>> extractedData(); // ds_id -> (ip,port)
+    // extracted data has frames, false if netto or frame contents were decoded in parallel
+    bool framedData() const { return framing_ != "" && !decoded_unframed_; }
+
+    // decoded records are mapped into buffers directly, decoded json is not handed out
+    bool directMapping() const { return direct_mapping_; }
+    std::map<std::string, std::shared_ptr<Buffer>> extractedBuffers();
+    // direct mapping counts, complete when done
+    const ASTERIXRecordMapper* recordMapper() const { return record_mapper_.get(); }
+
+    // received datagrams not stored since receive buffer was full, all lines
+    size_t numDroppedDatagrams();
+    size_t numDroppedBytes();
 
     float getFileDecodingProgress() const;
     float getRecordsPerSecond() const;
@@ -101,29 +137,99 @@ private:
 
     size_t file_size_{0};
     size_t max_index_{0};
+    size_t index_offset_{0}; // offset of decoded data in file, for parallel decoding
+    bool decoded_unframed_ {false}; // frame contents decoded as netto data, set before data is handed out
+
+    // frame layout from a framing definition, for splitting framed files at frame borders
+    struct FrameLayout
+    {
+        size_t file_header_size {0};
+        size_t length_offset {0}; // of content length variable in frame
+        size_t length_size {0};
+        bool length_reverse {false}; // little endian
+        size_t content_offset {0}; // in frame
+        long content_length_add {0}; // added to length variable
+        size_t trailer_size {0}; // after content
+    };
+
+    // decoded results of one chunk of the file
+    struct DecodedChunk
+    {
+        size_t offset {0};
+        std::vector<char> frame_contents; // if framed, contents of the chunk's frames as netto data
+        std::vector<std::unique_ptr<nlohmann::json>> data;
+        std::vector<size_t> num_records; // per data
+        size_t num_errors {0};
+        bool error {false};
+        std::string error_message;
+    };
 
     bool error_{false};
     std::string error_message_;
 
     boost::interprocess::interprocess_semaphore receive_semaphore_;
-    std::map<unsigned int, std::unique_ptr<boost::array<char, MAX_ALL_RECEIVE_SIZE>>> receive_buffers_copy_; // line->buf
-    std::map<unsigned int, size_t> receive_copy_buffer_sizes_; // line -> len
+    std::map<unsigned int, std::vector<std::vector<char>>> receive_buffers_copy_; // line -> chunks
 
     boost::mutex receive_buffers_mutex_;
-    std::map<unsigned int, std::unique_ptr<boost::array<char, MAX_ALL_RECEIVE_SIZE>>> receive_buffers_; // line -> buf
+    std::map<unsigned int, std::vector<std::vector<char>>> receive_buffers_; // line -> chunks
     std::map<unsigned int, size_t> receive_buffer_sizes_; // line -> len
+    std::vector<std::vector<char>> free_receive_chunks_; // empty, with capacity
+    // datagrams not stored since receive buffer full, since last decode
+    std::map<unsigned int, size_t> num_dropped_datagrams_; // line -> cnt
+    std::map<unsigned int, size_t> num_dropped_bytes_; // line -> cnt
+    size_t num_dropped_datagrams_total_ {0};
+    size_t num_dropped_bytes_total_ {0};
+    // kernel receive time to store latency, since last decode
+    size_t num_receive_latencies_ {0};
+    double receive_latency_sum_ms_ {0};
+    double receive_latency_max_ms_ {0};
 
     boost::posix_time::ptime last_receive_decode_time_;
 
+    std::vector<std::shared_ptr<jASTERIX::jASTERIX>> decoders_;
+
+    std::mutex extracted_mutex_; // for extracted data & buffers
+    std::condition_variable extracted_condition_; // notified when moved out, queue limit changed or obsolete
     std::vector<std::unique_ptr<nlohmann::json>> extracted_data_;
+    unsigned int num_extracted_queued_ {0}; // hand-outs not taken
+    unsigned int max_extracted_queued_ {0};
+
+    bool direct_mapping_ {false};
+    std::unique_ptr<ASTERIXRecordMapper> record_mapper_;
+    // direct mapping of post-processed data runs asynchronously, one at a time
+    std::future<void> mapping_;
+    std::vector<std::unique_ptr<nlohmann::json>> mapping_data_; // used by running mapping
+    std::vector<std::unique_ptr<nlohmann::json>> net_mapping_data_; // collected over all lines
+    std::map<std::string, std::shared_ptr<Buffer>> extracted_buffers_;
 
     size_t count_total_ {0};
     std::map<unsigned int, size_t> category_counts_;
 
     void doFileDecoding();
+    // file is mapped and split into data block (netto) or frame aligned chunks, which are decoded in
+    // parallel and processed in file order. returns false if frames could not be split, nothing decoded
+    bool doParallelFileDecoding(unsigned int num_threads, const FrameLayout* layout);
+    // returns false if the framing definition is not supported for splitting
+    bool frameLayout (FrameLayout& layout);
+    // reads frame at index, returns false if it does not fit into size or has no valid length
+    static bool readFrame (const char* data, size_t size, size_t index, const FrameLayout& layout,
+                           size_t& content_begin, size_t& content_size, size_t& frame_end);
+    // returns false if the frames do not cover the data exactly or contents are not whole data blocks
+    static bool checkFrames (const char* data, size_t size, const FrameLayout& layout);
     void doUDPStreamDecoding();
 
-    void storeReceivedData (unsigned int line, const char* data, unsigned int length);
+    void storeReceivedData (unsigned int line, const std::vector<UDPDatagram>& batch);
+    // empty chunk with capacity of at least size, from free chunks if possible. receive_buffers_mutex_ has to be locked
+    std::vector<char> receiveChunk (size_t size);
+    // blocks decoder until extracted data or buffers have been moved out, except max queued ones if not all
+    void waitForExtraction(bool all=false);
+    jASTERIX::jASTERIX& decoder();
+    // direct mapping: maps records under keys off the decode thread, previous mapping must be finished
+    void startMapping(std::vector<std::unique_ptr<nlohmann::json>> data, const std::vector<std::string>& keys);
+    // waits for running mapping, returns its buffers
+    std::map<std::string, std::shared_ptr<Buffer>> finishMapping();
+    // extracts non-empty buffers and blocks until they have been moved out
+    void handOutBuffers(std::map<std::string, std::shared_ptr<Buffer>> buffers);
 
     void fileJasterixCallback(std::unique_ptr<nlohmann::json> data, unsigned int line_id, size_t num_frames,
                            size_t num_records, size_t numErrors);
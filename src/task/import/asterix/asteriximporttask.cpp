@@ -18,6 +18,7 @@
 #include "asteriximporttask.h"
 #include "asterixcategoryconfig.h"
 #include "asteriximporttaskwidget.h"
+#include "asterixrecordmapper.h"
 #include "compass.h"
 #include "buffer.h"
 #include "configurable.h"
@@ -48,10 +49,15 @@
 #include <QMessageBox>
 #include <QThread>
 #include <QProgressDialog>
+#include <QThreadPool>
 #include <QMessageBox>
 #include <QPushButton>
+#include <QTimer>
+
+#include "util/tbbhack.h"
 
 #include <algorithm>
+#include <thread>
 
 using namespace Utils;
 using namespace nlohmann;
@@ -62,6 +68,9 @@ const unsigned int unlimited_chunk_size = 4000;
 
 const std::string DONE_PROPERTY_NAME = "asterix_data_imported";
 
+const unsigned int MAX_FILE_DECODE_JOBS=4; // files decoded concurrently
+const unsigned int MAX_AHEAD_DECODE_QUEUED=4; // hand-outs kept by a job decoding ahead of the current one
+
 //const float ram_threshold = 4.0;
 
 ASTERIXImportTask::ASTERIXImportTask(const std::string& class_id, const std::string& instance_id,
@@ -76,8 +85,12 @@ ASTERIXImportTask::ASTERIXImportTask(const std::string& class_id, const std::str
     registerParameter("file_list", &file_list_, json::array());
     registerParameter("current_file_framing", &current_file_framing_, "");
 
+    registerParameter("max_packets_in_processing", &max_packets_in_processing_, 3);
     registerParameter("num_packets_overload", &num_packets_overload_, 60);
 
+    registerParameter("direct_buffer_mapping", &direct_buffer_mapping_, false);
+    registerParameter("num_file_decode_threads", &num_file_decode_threads_, 0);
+
     date_ = boost::posix_time::ptime(boost::gregorian::day_clock::universal_day());
 
     registerParameter("override_tod_offset", &override_tod_offset_, 0.0);
@@ -294,6 +307,7 @@ void ASTERIXImportTask::refreshjASTERIX()
 
     jasterix_ = std::make_shared<jASTERIX::jASTERIX>(jasterix_definition_path, false,
                                                      debug_jasterix_, true);
+    file_decoders_.clear();
 
     std::vector<std::string> framings = jasterix_->framings();
     if (std::find(framings.begin(), framings.end(), current_file_framing_) == framings.end())
@@ -303,6 +317,108 @@ void ASTERIXImportTask::refreshjASTERIX()
     }
 }
 
+std::shared_ptr<jASTERIX::jASTERIX> ASTERIXImportTask::createjASTERIX()
+{
+    std::string jasterix_definition_path = HOME_DATA_DIRECTORY + "jasterix_definitions";
+    assert(Files::directoryExists(jasterix_definition_path));
+
+    std::shared_ptr<jASTERIX::jASTERIX> jasterix = std::make_shared<jASTERIX::jASTERIX>(
+                jasterix_definition_path, false, debug_jasterix_, true);
+
+    setCategoryConfigs(*jasterix, false);
+
+    return jasterix;
+}
+
+std::vector<std::shared_ptr<jASTERIX::jASTERIX>> ASTERIXImportTask::fileDecoders(unsigned int num)
+{
+    assert (num);
+
+    size_t num_existing = file_decoders_.size();
+
+    if (num - 1 > num_existing)
+    {
+        loginf << "ASTERIXImportTask: fileDecoders: creating " << num - 1 - num_existing << " decoders";
+
+        file_decoders_.resize(num - 1);
+
+        tbb::parallel_for(num_existing, file_decoders_.size(), [&](size_t cnt)
+        {
+            file_decoders_.at(cnt) = createjASTERIX();
+        });
+    }
+
+    std::vector<std::shared_ptr<jASTERIX::jASTERIX>> decoders {jasterix_};
+    decoders.insert(decoders.end(), file_decoders_.begin(), file_decoders_.begin() + (num - 1));
+
+    return decoders;
+}
+
+unsigned int ASTERIXImportTask::numFileDecodeThreads() const
+{
+    if (num_file_decode_threads_)
+        return num_file_decode_threads_;
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void ASTERIXImportTask::setCategoryConfigs(jASTERIX::jASTERIX& jasterix, bool log)
+{
+    jasterix.decodeNoCategories();
+
+    for (auto& cat_it : category_configs_)
+    {
+        if (log)
+            loginf << "ASTERIXImportTask: setCategoryConfigs: setting cat " << cat_it.first << " decode "
+                   << cat_it.second.decode() << " edition '" << cat_it.second.edition() << "' ref '"
+                   << cat_it.second.ref() << "'";
+
+        if (!jasterix.hasCategory(cat_it.first))
+        {
+            if (log)
+                logwrn << "ASTERIXImportTask: setCategoryConfigs: cat '" << cat_it.first
+                       << "' not defined in decoder";
+            continue;
+        }
+
+        if (!jasterix.category(cat_it.first)->hasEdition(cat_it.second.edition()))
+        {
+            if (log)
+                logwrn << "ASTERIXImportTask: setCategoryConfigs: cat " << cat_it.first << " edition '"
+                       << cat_it.second.edition() << "' not defined in decoder";
+            continue;
+        }
+
+        if (cat_it.second.ref().size() &&  // only if value set
+                !jasterix.category(cat_it.first)->hasREFEdition(cat_it.second.ref()))
+        {
+            if (log)
+                logwrn << "ASTERIXImportTask: setCategoryConfigs: cat " << cat_it.first << " ref '"
+                       << cat_it.second.ref() << "' not defined in decoder";
+            continue;
+        }
+
+        if (cat_it.second.spf().size() &&  // only if value set
+                !jasterix.category(cat_it.first)->hasSPFEdition(cat_it.second.spf()))
+        {
+            if (log)
+                logwrn << "ASTERIXImportTask: setCategoryConfigs: cat " << cat_it.first << " spf '"
+                       << cat_it.second.spf() << "' not defined in decoder";
+            continue;
+        }
+
+        jasterix.setDecodeCategory(cat_it.first, cat_it.second.decode());
+
+        if (log)
+            loginf << "ASTERIXImportTask: setCategoryConfigs: setting cat " <<  cat_it.first
+                   << " edition " << cat_it.second.edition();
+
+        jasterix.category(cat_it.first)->setCurrentEdition(cat_it.second.edition());
+        jasterix.category(cat_it.first)->setCurrentREFEdition(cat_it.second.ref());
+        jasterix.category(cat_it.first)->setCurrentSPFEdition(cat_it.second.spf());
+    }
+}
+
 std::vector<std::string> ASTERIXImportTask::fileList()
 {
     return file_list_.get<std::vector<string>>();
@@ -341,6 +457,7 @@ void ASTERIXImportTask::importFilename(const std::string& filename)
 
     current_filename_ = filename;
     import_file_ = true;
+    import_files_.clear();
 
     addFile(filename);
 
@@ -348,12 +465,30 @@ void ASTERIXImportTask::importFilename(const std::string& filename)
         dialog_->updateButtons();
 }
 
+void ASTERIXImportTask::importFiles(const std::vector<ASTERIXImportFileInfo>& files)
+{
+    loginf << "ASTERIXImportTask: importFiles: num files " << files.size();
+
+    assert (files.size());
+
+    current_filename_ = files.at(0).filename;
+    import_file_ = true;
+    import_files_ = files;
+
+    for (auto& file_it : files)
+        addFile(file_it.filename);
+
+    if (dialog_)
+        dialog_->updateButtons();
+}
+
 void ASTERIXImportTask::importNetwork()
 {
     loginf << "ASTERIXImportTask: importNetwork";
 
     current_filename_ = "";
     import_file_ = false;
+    import_files_.clear();
 
     if (dialog_)
         dialog_->updateButtons();
@@ -619,6 +754,19 @@ void ASTERIXImportTask::maxNetworkLines(unsigned int value)
     max_network_lines_ = value;
 }
 
+bool ASTERIXImportTask::directBufferMapping() const
+{
+    return direct_buffer_mapping_;
+}
+
+void ASTERIXImportTask::directBufferMapping(bool value)
+{
+    loginf << "ASTERIXImportTask: directBufferMapping: value " << value;
+
+    assert (!running_);
+    direct_buffer_mapping_ = value;
+}
+
 bool ASTERIXImportTask::isRunning() const
 {
     return running_;
@@ -636,6 +784,16 @@ bool ASTERIXImportTask::canImportFile()
         return false;
     }
 
+    for (auto& file_it : import_files_)
+    {
+        if (!Files::fileExists(file_it.filename))
+        {
+            loginf << "ASTERIXImportTask: canImportFile: not possible since file '"
+                   << file_it.filename << "'does not exist";
+            return false;
+        }
+    }
+
     return true;
 }
 
@@ -658,9 +816,14 @@ void ASTERIXImportTask::stop()
 
     stopped_ = true;
 
+    files_to_decode_.clear();
+
     if (decode_job_)
         decode_job_->setObsolete();
 
+    for (auto& ahead_it : ahead_decode_jobs_)
+        ahead_it.job->setObsolete();
+
     for (auto& job_it : json_map_jobs_)
         job_it->setObsolete();
 
@@ -679,6 +842,21 @@ void ASTERIXImportTask::stop()
         QThread::msleep(1);
     }
 
+    for (auto& ahead_it : ahead_decode_jobs_)
+    {
+        while(!ahead_it.job->done())
+        {
+            loginf << "ASTERIXImportTask: stop: waiting for decode job decoding ahead to finish";
+
+            if (QCoreApplication::hasPendingEvents())
+                QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+
+            QThread::msleep(1);
+        }
+    }
+
+    ahead_decode_jobs_.clear();
+
     while(json_map_jobs_.size())
     {
         loginf << "ASTERIXImportTask: stop: waiting for map job to finish";
@@ -722,11 +900,27 @@ void ASTERIXImportTask::run(bool test) // , bool create_mapping_stubs
     stopped_ = false;
     done_ = false; // since can be run multiple times
 
+    COMPASS::instance().interface().useImportStorageProfile(!import_file_); // restored in checkAllDone
+
     num_packets_in_processing_ = 0;
     num_packets_total_ = 0;
 
     num_records_ = 0;
 
+    map_stats_ = StageStats();
+    category_mapped_counts_.clear();
+    num_mapped_ = 0;
+    num_not_mapped_ = 0;
+    num_mapping_errors_ = 0;
+    postprocess_stats_ = StageStats();
+    insert_stats_ = StageStats();
+
+    num_stalls_ = 0;
+    stall_duration_ = boost::posix_time::time_duration();
+    stall_start_time_ = boost::posix_time::not_a_date_time;
+    num_dropped_datagrams_ = 0;
+    num_dropped_bytes_ = 0;
+
     start_time_ = boost::posix_time::microsec_clock::local_time();
 
     last_insert_time_ = boost::posix_time::microsec_clock::local_time();
@@ -738,6 +932,40 @@ void ASTERIXImportTask::run(bool test) // , bool create_mapping_stubs
 
     assert(canRun());
 
+    // files to decode, or settings for network
+    files_to_decode_.clear();
+    files_total_size_ = 0;
+    files_decoded_size_ = 0;
+
+    if (import_file_ && import_files_.size())
+        files_to_decode_.insert(files_to_decode_.end(), import_files_.begin(), import_files_.end());
+    else
+    {
+        ASTERIXImportFileInfo file;
+
+        file.filename = current_filename_;
+        file.line_id = file_line_id_;
+        file.date = date_;
+        file.override_tod_active = override_tod_active_;
+        file.override_tod_offset = override_tod_offset_;
+
+        files_to_decode_.push_back(file);
+    }
+
+    num_files_ = files_to_decode_.size();
+
+    if (import_file_)
+    {
+        for (auto& file_it : files_to_decode_)
+        {
+            file_it.size = Files::fileSize(file_it.filename);
+            files_total_size_ += file_it.size;
+        }
+    }
+
+    decoding_file_ = files_to_decode_.front();
+    files_to_decode_.pop_front();
+
     if (import_file_)
     {
         last_file_progress_time_ = boost::posix_time::microsec_clock::local_time();
@@ -771,84 +999,138 @@ void ASTERIXImportTask::run(bool test) // , bool create_mapping_stubs
 
     jASTERIX::add_artas_md5_hash = true;
 
-    // set category configs
-    jasterix_->decodeNoCategories();
+    setCategoryConfigs(*jasterix_, true);
 
-    for (auto& cat_it : category_configs_)
+    setupDecodeSlots();
+
+    startDecoding(decoding_file_);
+    startAheadDecoding();
+}
+
+void ASTERIXImportTask::setupDecodeSlots()
+{
+    unsigned int num_slots = 1;
+    unsigned int num_threads = numFileDecodeThreads();
+
+    if (import_file_ && num_files_ > 1)
     {
-        // loginf << "ASTERIXImportTask: importFile: setting category " << cat_it.first;
+        if (hasConfiguratonFor(1) && decodeCategory(1))
+            loginf << "ASTERIXImportTask: setupDecodeSlots: decoding files one after another, since CAT001"
+                   << " time of day depends on CAT002 of previous files";
+        else // decode jobs wait in the thread pool while decoding ahead, leave threads to the processing jobs
+            num_slots = std::min({num_files_, num_threads, MAX_FILE_DECODE_JOBS,
+                                  std::max(1u, (unsigned int) QThreadPool::globalInstance()->maxThreadCount() / 2)});
+    }
 
-        loginf << "ASTERIXImportTask: run: setting cat " << cat_it.first << " decode "
-               << cat_it.second.decode() << " edition '" << cat_it.second.edition() << "' ref '"
-               << cat_it.second.ref() << "'";
+    slot_decoders_.clear();
+    slot_decoders_.resize(num_slots);
 
-        if (!jasterix_->hasCategory(cat_it.first))
-        {
-            logwrn << "ASTERIXImportTask: run: cat '" << cat_it.first
-                   << "' not defined in decoder";
-            continue;
-        }
+    if (import_file_)
+    {
+        // decoders for parallel decoding of a file are only created if it is large enough
+        unsigned int threads_per_slot = 1;
 
-        if (!jasterix_->category(cat_it.first)->hasEdition(cat_it.second.edition()))
-        {
-            logwrn << "ASTERIXImportTask: run: cat " << cat_it.first << " edition '"
-                   << cat_it.second.edition() << "' not defined in decoder";
-            continue;
-        }
+        for (auto& file_it : files_to_decode_)
+            if (file_it.size > 4 * PARALLEL_DECODE_CHUNK_SIZE)
+                threads_per_slot = std::max(1u, num_threads / num_slots);
 
-        if (cat_it.second.ref().size() &&  // only if value set
-                !jasterix_->category(cat_it.first)->hasREFEdition(cat_it.second.ref()))
-        {
-            logwrn << "ASTERIXImportTask: run: cat " << cat_it.first << " ref '"
-                   << cat_it.second.ref() << "' not defined in decoder";
-            continue;
-        }
+        if (decoding_file_.size > 4 * PARALLEL_DECODE_CHUNK_SIZE)
+            threads_per_slot = std::max(1u, num_threads / num_slots);
 
-        if (cat_it.second.spf().size() &&  // only if value set
-                !jasterix_->category(cat_it.first)->hasSPFEdition(cat_it.second.spf()))
-        {
-            logwrn << "ASTERIXImportTask: run: cat " << cat_it.first << " spf '"
-                   << cat_it.second.spf() << "' not defined in decoder";
-            continue;
-        }
+        std::vector<std::shared_ptr<jASTERIX::jASTERIX>> decoders = fileDecoders(num_slots * threads_per_slot);
+
+        for (unsigned int slot = 0; slot < num_slots; ++slot)
+            slot_decoders_.at(slot).assign(decoders.begin() + slot * threads_per_slot,
+                                           decoders.begin() + (slot + 1) * threads_per_slot);
 
-        //        loginf << "ASTERIXImportTask: importFile: setting cat " <<  cat_it.first
-        //               << " decode flag " << cat_it.second.decode();
-        jasterix_->setDecodeCategory(cat_it.first, cat_it.second.decode());
-        loginf << "ASTERIXImportTask: run: setting cat " <<  cat_it.first
-               << " edition " << cat_it.second.edition();
-        jasterix_->category(cat_it.first)->setCurrentEdition(cat_it.second.edition());
-        jasterix_->category(cat_it.first)->setCurrentREFEdition(cat_it.second.ref());
-        jasterix_->category(cat_it.first)->setCurrentSPFEdition(cat_it.second.spf());
+        loginf << "ASTERIXImportTask: setupDecodeSlots: concurrent file decode jobs " << num_slots
+               << " decoders per job " << threads_per_slot;
     }
 
-    loginf << "ASTERIXImportTask: run: starting decode job";
+    slot_post_processes_.assign(num_slots - 1, post_process_);
+
+    free_slots_.clear();
+
+    for (unsigned int slot = num_slots; slot > 0; --slot) // slot 0 is used first
+        free_slots_.push_back(slot - 1);
+}
+
+ASTERIXPostProcess& ASTERIXImportTask::slotPostProcess(unsigned int slot)
+{
+    if (slot == 0)
+        return post_process_;
+
+    return slot_post_processes_.at(slot - 1);
+}
+
+void ASTERIXImportTask::startDecoding(const ASTERIXImportFileInfo& file)
+{
+    assert (free_slots_.size());
 
-    assert(decode_job_ == nullptr);
+    unsigned int slot = free_slots_.back();
+    free_slots_.pop_back();
 
-    decode_job_ = make_shared<ASTERIXDecodeJob>(*this, test_, post_process_);
+    loginf << "ASTERIXImportTask: startDecoding: starting decode job, file '" << file.filename << "' slot "
+           << slot << " ahead " << (decode_job_ != nullptr);
+
+    std::shared_ptr<ASTERIXDecodeJob> job = make_shared<ASTERIXDecodeJob>(*this, test_, slotPostProcess(slot));
 
     if (import_file_)
-        decode_job_->setDecodeFile(current_filename_, current_file_framing_); // do file import
+    {
+        job->setDecodeFile(file.filename, current_file_framing_, file.line_id); // do file import
+        job->setDecoders(slot_decoders_.at(slot));
+    }
     else
     {
         COMPASS::instance().dataSourceManager().createNetworkDBDataSources();
-        decode_job_->setDecodeUDPStreams(COMPASS::instance().dataSourceManager().getNetworkLines()); // record from network
+        job->setDecodeUDPStreams(COMPASS::instance().dataSourceManager().getNetworkLines()); // record from network
     }
 
 
-    connect(decode_job_.get(), &ASTERIXDecodeJob::obsoleteSignal, this,
+    connect(job.get(), &ASTERIXDecodeJob::obsoleteSignal, this,
             &ASTERIXImportTask::decodeASTERIXObsoleteSlot, Qt::QueuedConnection);
-    connect(decode_job_.get(), &ASTERIXDecodeJob::doneSignal, this,
+    connect(job.get(), &ASTERIXDecodeJob::doneSignal, this,
             &ASTERIXImportTask::decodeASTERIXDoneSlot, Qt::QueuedConnection);
-    connect(decode_job_.get(), &ASTERIXDecodeJob::decodedASTERIXSignal, this,
+    connect(job.get(), &ASTERIXDecodeJob::decodedASTERIXSignal, this,
             &ASTERIXImportTask::addDecodedASTERIXSlot, Qt::QueuedConnection);
 
-    JobManager::instance().addBlockingJob(decode_job_);
+    if (decode_job_) // decodes ahead, data is kept until it is the current one
+    {
+        job->maxExtractedQueued(MAX_AHEAD_DECODE_QUEUED);
+
+        AheadDecodeJob ahead;
+        ahead.job = job;
+        ahead.file = file;
+        ahead.slot = slot;
+
+        ahead_decode_jobs_.push_back(ahead);
+    }
+    else
+    {
+        decode_job_ = job;
+        decoding_file_ = file;
+        decode_job_slot_ = slot;
+    }
+
+    if (import_file_) // concurrent to other file decode jobs
+        JobManager::instance().addConcurrentJob(job);
+    else
+        JobManager::instance().addBlockingJob(job);
 
     return;
 }
 
+void ASTERIXImportTask::startAheadDecoding()
+{
+    while (!stopped_ && !error_ && free_slots_.size() && files_to_decode_.size())
+    {
+        ASTERIXImportFileInfo file = files_to_decode_.front();
+        files_to_decode_.pop_front();
+
+        startDecoding(file);
+    }
+}
+
 void ASTERIXImportTask::dialogImportSlot()
 {
     loginf << "ASTERIXImportTask: dialogImportSlot";
@@ -887,6 +1169,9 @@ void ASTERIXImportTask::decodeASTERIXDoneSlot()
     if (!decode_job_) // called twice?
         return;
 
+    if (!decode_job_->done()) // job decoding ahead, finished when it is the current one
+        return;
+
     assert(decode_job_);
 
     if (!stopped_ && decode_job_->error())
@@ -903,7 +1188,50 @@ void ASTERIXImportTask::decodeASTERIXDoneSlot()
         msgBox.exec();
     }
 
+    num_dropped_datagrams_ += decode_job_->numDroppedDatagrams();
+    num_dropped_bytes_ += decode_job_->numDroppedBytes();
+
+    if (decode_job_->directMapping() && decode_job_->recordMapper())
+    {
+        const ASTERIXRecordMapper& mapper = *decode_job_->recordMapper();
+        addMappingCounts(mapper.categoryMappedCounts(), mapper.numMapped(), mapper.numNotMapped(),
+                         mapper.numErrors());
+    }
+
     decode_job_ = nullptr;
+    free_slots_.push_back(decode_job_slot_);
+
+    // decode next file while previous is processed
+    if (!stopped_ && !error_ && (ahead_decode_jobs_.size() || files_to_decode_.size()))
+    {
+        files_decoded_size_ += decoding_file_.size;
+
+        if (ahead_decode_jobs_.size()) // next file decoded ahead becomes current one
+        {
+            decode_job_ = ahead_decode_jobs_.front().job;
+            decoding_file_ = ahead_decode_jobs_.front().file;
+            decode_job_slot_ = ahead_decode_jobs_.front().slot;
+            ahead_decode_jobs_.pop_front();
+
+            decode_job_->maxExtractedQueued(0);
+        }
+
+        startAheadDecoding(); // as current one if none decoded ahead
+
+        assert (decode_job_);
+
+        if (decode_job_->done()) // done signal was ignored while decoding ahead
+            decodeASTERIXDoneSlot();
+        else if (decode_job_->hasData())
+            addDecodedASTERIXSlot();
+
+        return;
+    }
+
+    for (auto& ahead_it : ahead_decode_jobs_) // not processed after error
+        ahead_it.job->setObsolete();
+
+    ahead_decode_jobs_.clear();
 
     checkAllDone();
 }
@@ -911,6 +1239,12 @@ void ASTERIXImportTask::decodeASTERIXObsoleteSlot()
 {
     logdbg << "ASTERIXImportTask: decodeASTERIXObsoleteSlot";
 
+    if (decode_job_)
+    {
+        num_dropped_datagrams_ += decode_job_->numDroppedDatagrams();
+        num_dropped_bytes_ += decode_job_->numDroppedBytes();
+    }
+
     decode_job_ = nullptr;
 }
 
@@ -924,46 +1258,79 @@ void ASTERIXImportTask::addDecodedASTERIXSlot()
         return;
     }
 
-    assert(decode_job_);
+    // signal of a job decoding ahead, its data is taken when it is the current one. or of one discarded
+    // after an error
+    if (!decode_job_ || !decode_job_->hasData())
+        return;
 
     logdbg << "ASTERIXImportTask: addDecodedASTERIXSlot: errors " << decode_job_->numErrors()
            << " num records " << jasterix_->numRecords();
 
-    if (import_file_)
+    if (import_file_ && file_progress_dialog_->wasCanceled())
     {
-        if (file_progress_dialog_->wasCanceled())
-        {
-            stop();
-            return;
-        }
-
-        if (maxLoadReached()) // break if too many packets in process, this slot is called again from insertDoneSlot
-        {
-            logdbg << "ASTERIXImportTask: addDecodedASTERIXSlot: returning since max load reached";
-            return;
-        }
+        stop();
+        return;
     }
 
     if (stopped_)
         return;
 
-    if (num_packets_in_processing_ > num_packets_overload_) // network special case
+    // data is left in the decode job, which waits until it was taken. in network mode the received data is
+    // buffered meanwhile, and dropped (counted) if the receive buffer is full. this slot is called again when
+    // a packet was processed
+    if (maxLoadReached())
     {
-        logwrn << "ASTERIXImportTask: addDecodedASTERIXSlot: overload detected, packets in processing "
-               << num_packets_in_processing_ << " skipping data";
+        if (stall_start_time_.is_not_a_date_time())
+        {
+            stall_start_time_ = boost::posix_time::microsec_clock::local_time();
+            ++num_stalls_;
 
-        std::vector<std::unique_ptr<nlohmann::json>> extracted_data {decode_job_->extractedData()};
+            if (!import_file_)
+                logwrn << "ASTERIXImportTask: addDecodedASTERIXSlot: overload detected, packets in processing "
+                       << num_packets_in_processing_ << ", delaying data";
+        }
+
+        logdbg << "ASTERIXImportTask: addDecodedASTERIXSlot: returning since max load reached";
 
-        // issue: if all packets are already in queued_job_buffers_, no insert will be started
-        // try to resume after being in overload for too long
+        // queued inserts are not started during load or export, resume them
         if (!insert_active_ && queued_job_buffers_.size())
-            insertData(); // will call itself again if required
+        {
+            if (!COMPASS::instance().dbExportInProgress()
+                    && !COMPASS::instance().dbContentManager().loadInProgress())
+                insertData();
+            else
+                QTimer::singleShot(100, this, &ASTERIXImportTask::addDecodedASTERIXSlot);
+        }
 
         return;
     }
 
+    if (!stall_start_time_.is_not_a_date_time())
+    {
+        stall_duration_ += boost::posix_time::microsec_clock::local_time() - stall_start_time_;
+        stall_start_time_ = boost::posix_time::not_a_date_time;
+    }
+
     logdbg << "ASTERIXImportTask: addDecodedASTERIXSlot: processing data";
 
+    if (decode_job_->directMapping()) // already mapped, skip json mapping job
+    {
+        std::map<std::string, std::shared_ptr<Buffer>> job_buffers {decode_job_->extractedBuffers()};
+
+        if (!job_buffers.size())
+        {
+            loginf << "ASTERIXImportTask: addDecodedASTERIXSlot: processing buffers empty";
+            return;
+        }
+
+        ++num_packets_in_processing_;
+        ++num_packets_total_;
+
+        postprocessBuffers(std::move(job_buffers), decoding_file_);
+
+        return;
+    }
+
     std::vector<std::unique_ptr<nlohmann::json>> extracted_data {decode_job_->extractedData()};
 
     if (!extracted_data.size())
@@ -986,7 +1353,7 @@ void ASTERIXImportTask::addDecodedASTERIXSlot()
 
     std::vector<std::string> keys;
 
-    if (current_file_framing_ == "" || !import_file_) // force netto when doing network import
+    if (!decode_job_->framedData()) // netto, also when doing network import
         keys = {"data_blocks", "content", "records"};
     else
         keys = {"frames", "content", "data_blocks", "content", "records"};
@@ -995,6 +1362,8 @@ void ASTERIXImportTask::addDecodedASTERIXSlot()
             make_shared<ASTERIXJSONMappingJob>(std::move(extracted_data), keys, schema_->parsers());
 
     json_map_jobs_.push_back(json_map_job);
+    json_map_job_files_.push_back(decoding_file_);
+    map_stats_.add();
 
     assert(!extracted_data.size());
 
@@ -1015,6 +1384,7 @@ void ASTERIXImportTask::mapJSONDoneSlot()
         logdbg << "ASTERIXImportTask: mapJSONDoneSlot: stopping";
 
         json_map_jobs_.clear();
+        json_map_job_files_.clear();
 
         checkAllDone();
 
@@ -1026,48 +1396,39 @@ void ASTERIXImportTask::mapJSONDoneSlot()
 
     std::map<std::string, std::shared_ptr<Buffer>> job_buffers {map_job->buffers()};
 
+    addMappingCounts(map_job->categoryMappedCounts(), map_job->numMapped(), map_job->numNotMapped(),
+                     map_job->numErrors());
+
     assert (json_map_jobs_.size());
     assert (json_map_jobs_.begin()->get() == map_job);
     map_job = nullptr;
     json_map_jobs_.erase(json_map_jobs_.begin()); // remove
 
+    assert (json_map_job_files_.size());
+    ASTERIXImportFileInfo file = json_map_job_files_.front();
+    json_map_job_files_.pop_front();
+
     logdbg << "ASTERIXImportTask: mapJSONDoneSlot: processing, num buffers " << job_buffers.size();
 
-    if (!job_buffers.size())
-    {
-        assert (num_packets_in_processing_);
-        num_packets_in_processing_--;
-        return;
-    }
+    size_t num_mapped {0};
 
-    bool check_future_ts = !import_file_;
+    for (auto& buf_it : job_buffers)
+        num_mapped += buf_it.second->size();
 
-    if (network_ignore_future_ts_)
-        check_future_ts = false;
+    map_stats_.remove(num_mapped);
 
-    if (!test_)
+    if (!job_buffers.size())
     {
-        std::shared_ptr<ASTERIXPostprocessJob> postprocess_job =
-                make_shared<ASTERIXPostprocessJob>(std::move(job_buffers), date_,
-                                                   override_tod_active_, override_tod_offset_,
-                                                   check_future_ts);
-
-        postprocess_jobs_.push_back(postprocess_job);
-
-        // check for future when net import
+        assert (num_packets_in_processing_);
+        num_packets_in_processing_--;
 
-        connect(postprocess_job.get(), &ASTERIXPostprocessJob::obsoleteSignal, this,
-                &ASTERIXImportTask::postprocessObsoleteSlot, Qt::QueuedConnection);
-        connect(postprocess_job.get(), &ASTERIXPostprocessJob::doneSignal, this,
-                &ASTERIXImportTask::postprocessDoneSlot, Qt::QueuedConnection);
+        if (decode_job_ && decode_job_->hasData())
+            addDecodedASTERIXSlot(); // load next chunk
 
-        JobManager::instance().addNonBlockingJob(postprocess_job);
+        return;
     }
 
-    if (test_)
-    {
-        checkAllDone();
-    }
+    postprocessBuffers(std::move(job_buffers), file);
 
     logdbg << "ASTERIXImportTask: mapJSONDoneSlot: done";
 }
@@ -1084,6 +1445,9 @@ void ASTERIXImportTask::mapJSONObsoleteSlot()
     map_job = nullptr;
     json_map_jobs_.erase(json_map_jobs_.begin()); // remove
 
+    if (json_map_job_files_.size())
+        json_map_job_files_.pop_front();
+
     checkAllDone();
 
 }
@@ -1118,12 +1482,17 @@ void ASTERIXImportTask::postprocessDoneSlot()
     for (auto& buf_it : job_buffers)
         buffer_cnt += buf_it.second->size();
 
+    postprocess_stats_.remove(buffer_cnt);
+
     if (buffer_cnt == 0)
     {
         // quit
         assert (num_packets_in_processing_);
         --num_packets_in_processing_;
 
+        if (decode_job_ && decode_job_->hasData())
+            addDecodedASTERIXSlot(); // load next chunk
+
         checkAllDone();
 
         return;
@@ -1134,6 +1503,7 @@ void ASTERIXImportTask::postprocessDoneSlot()
     {
         // TODO change to append
         queued_job_buffers_.emplace_back(std::move(job_buffers));
+        insert_stats_.add();
 
         if (!insert_active_ && !COMPASS::instance().dbExportInProgress()
                 && !COMPASS::instance().dbContentManager().loadInProgress())
@@ -1156,6 +1526,42 @@ void ASTERIXImportTask::postprocessObsoleteSlot()
     postprocess_jobs_.erase(postprocess_jobs_.begin()); // remove
 }
 
+void ASTERIXImportTask::postprocessBuffers(std::map<std::string, std::shared_ptr<Buffer>> job_buffers,
+                                           const ASTERIXImportFileInfo& file)
+{
+    logdbg << "ASTERIXImportTask: postprocessBuffers: num buffers " << job_buffers.size();
+
+    bool check_future_ts = !import_file_;
+
+    if (network_ignore_future_ts_)
+        check_future_ts = false;
+
+    if (!test_)
+    {
+        std::shared_ptr<ASTERIXPostprocessJob> postprocess_job =
+                make_shared<ASTERIXPostprocessJob>(std::move(job_buffers), file.date,
+                                                   file.override_tod_active, file.override_tod_offset,
+                                                   check_future_ts);
+
+        postprocess_jobs_.push_back(postprocess_job);
+        postprocess_stats_.add();
+
+        // check for future when net import
+
+        connect(postprocess_job.get(), &ASTERIXPostprocessJob::obsoleteSignal, this,
+                &ASTERIXImportTask::postprocessObsoleteSlot, Qt::QueuedConnection);
+        connect(postprocess_job.get(), &ASTERIXPostprocessJob::doneSignal, this,
+                &ASTERIXImportTask::postprocessDoneSlot, Qt::QueuedConnection);
+
+        JobManager::instance().addNonBlockingJob(postprocess_job);
+    }
+
+    if (test_)
+    {
+        checkAllDone();
+    }
+}
+
 void ASTERIXImportTask::insertData()
 {
     logdbg << "ASTERIXImportTask: insertData: thread " << QThread::currentThreadId();
@@ -1193,6 +1599,8 @@ void ASTERIXImportTask::insertData()
 
     loginf << "ASTERIXImportTask: insertData: inserting " << current_num_records << " records/s";
 
+    last_insert_num_records_ = current_num_records;
+
     if (!insert_slot_connected_)
     {
         loginf << "JSONImporterTask: insertData: connecting slot";
@@ -1228,6 +1636,7 @@ void ASTERIXImportTask::insertDoneSlot()
     assert (!COMPASS::instance().dbContentManager().insertInProgress());
 
     --num_packets_in_processing_;
+    insert_stats_.remove(last_insert_num_records_);
 
 //    double insert_time_ms = (double)(
 //                boost::posix_time::microsec_clock::local_time() - insert_start_time_).total_microseconds() / 1000.0;
@@ -1307,7 +1716,8 @@ void ASTERIXImportTask::checkAllDone()
            << " queued insert " << queued_job_buffers_.size()
            << " insert active " << insert_active_;
 
-    if (!all_done_ && decode_job_ == nullptr && !json_map_jobs_.size() && !postprocess_jobs_.size()
+    if (!all_done_ && decode_job_ == nullptr && !ahead_decode_jobs_.size() && !json_map_jobs_.size()
+            && !postprocess_jobs_.size()
             && !queued_job_buffers_.size() && !insert_active_)
     {
         logdbg << "ASTERIXImportTask: checkAllDone: setting all done: total packets " << num_packets_total_;
@@ -1325,6 +1735,11 @@ void ASTERIXImportTask::checkAllDone()
         loginf << "ASTERIXImportTask: checkAllDone: import done after "
                << String::timeStringFromDouble(time_diff.total_milliseconds() / 1000.0, false);
 
+        logStageStats();
+
+        if (COMPASS::instance().interface().ready())
+            COMPASS::instance().interface().useConfiguredStorageProfile();
+
         COMPASS::instance().mainWindow().updateMenus(); // re-enable import menu
 
         QApplication::restoreOverrideCursor();
@@ -1355,7 +1770,62 @@ void ASTERIXImportTask::checkAllDone()
 
 bool ASTERIXImportTask::maxLoadReached()
 {
-    return num_packets_in_processing_ > 2;
+    if (import_file_)
+        return num_packets_in_processing_ >= max_packets_in_processing_;
+    else
+        return num_packets_in_processing_ > num_packets_overload_;
+}
+
+void ASTERIXImportTask::addMappingCounts(
+        const std::map<unsigned int, std::pair<size_t, size_t>>& category_counts,
+        size_t num_mapped, size_t num_not_mapped, size_t num_errors)
+{
+    for (auto& cat_it : category_counts)
+    {
+        category_mapped_counts_[cat_it.first].first += cat_it.second.first;
+        category_mapped_counts_[cat_it.first].second += cat_it.second.second;
+    }
+
+    num_mapped_ += num_mapped;
+    num_not_mapped_ += num_not_mapped;
+    num_mapping_errors_ += num_errors;
+}
+
+void ASTERIXImportTask::logStageStats()
+{
+    double elapsed_s = (boost::posix_time::microsec_clock::local_time() - start_time_).total_milliseconds() / 1000.0;
+
+    if (elapsed_s <= 0)
+        elapsed_s = 1;
+
+    auto log_stage = [elapsed_s] (const std::string& name, const StageStats& stats) {
+        loginf << "ASTERIXImportTask: logStageStats: " << name << ": packets " << stats.num_packets
+               << " records " << stats.num_records << " rec/s " << (unsigned int) (stats.num_records / elapsed_s)
+               << " max queued " << stats.max_active;
+    };
+
+    log_stage("map", map_stats_);
+
+    loginf << "ASTERIXImportTask: logStageStats: map: mapped " << num_mapped_ << " not mapped "
+           << num_not_mapped_ << " errors " << num_mapping_errors_;
+
+    for (auto& cat_it : category_mapped_counts_)
+        loginf << "ASTERIXImportTask: logStageStats: map: cat " << cat_it.first << " mapped "
+               << cat_it.second.first << " not mapped " << cat_it.second.second;
+    log_stage("post-process", postprocess_stats_);
+    log_stage("insert", insert_stats_);
+
+    loginf << "ASTERIXImportTask: logStageStats: max load reached " << num_stalls_ << " times, delayed for "
+           << String::timeStringFromDouble(stall_duration_.total_milliseconds() / 1000.0, true);
+
+    if (!import_file_)
+    {
+        if (num_dropped_datagrams_)
+            logwrn << "ASTERIXImportTask: logStageStats: receive: dropped " << num_dropped_datagrams_
+                   << " datagrams with " << num_dropped_bytes_ << " bytes, receive buffer full";
+        else
+            loginf << "ASTERIXImportTask: logStageStats: receive: no datagrams dropped";
+    }
 }
 
 void ASTERIXImportTask::updateFileProgressDialog(bool force)
@@ -1366,7 +1836,7 @@ void ASTERIXImportTask::updateFileProgressDialog(bool force)
     if (!file_progress_dialog_)
     {
         file_progress_dialog_.reset(
-                    new QProgressDialog(("File '"+current_filename_+"'").c_str(), "Abort", 0, 100));
+                    new QProgressDialog(("File '"+decoding_file_.filename+"'").c_str(), "Abort", 0, 100));
         file_progress_dialog_->setWindowTitle("Importing ASTERIX Recording");
         file_progress_dialog_->setWindowModality(Qt::ApplicationModal);
 
@@ -1381,11 +1851,36 @@ void ASTERIXImportTask::updateFileProgressDialog(bool force)
 
     last_file_progress_time_ = boost::posix_time::microsec_clock::local_time();
 
-    string text = "File '"+current_filename_+"'";
+    string text = "File '"+decoding_file_.filename+"'";
     string rec_text;
     string rem_text;
 
-    if (decode_job_)
+    if (num_files_ > 1)
+        text += " ("+to_string(num_files_ - files_to_decode_.size() - ahead_decode_jobs_.size())
+                +"/"+to_string(num_files_)+")";
+
+    if (decode_job_ && num_files_ > 1 && files_total_size_)
+    {
+        // progress and remaining time over all files
+        double decoded_size = files_decoded_size_
+                + decode_job_->getFileDecodingProgress() / 100.0 * decoding_file_.size;
+
+        for (auto& ahead_it : ahead_decode_jobs_)
+            decoded_size += ahead_it.job->getFileDecodingProgress() / 100.0 * ahead_it.file.size;
+        double elapsed_s = (boost::posix_time::microsec_clock::local_time()
+                            - start_time_).total_milliseconds() / 1000.0;
+
+        file_progress_dialog_->setValue(100.0 * decoded_size / files_total_size_);
+
+        rec_text = "\n\nRecords/s: "+to_string((unsigned int) decode_job_->getRecordsPerSecond());
+
+        if (decoded_size > 0)
+            rem_text = "Remaining: "+String::timeStringFromDouble(
+                        elapsed_s * (files_total_size_ - decoded_size) / decoded_size + 1.0, false);
+        else
+            rem_text = "Remaining: Unknown";
+    }
+    else if (decode_job_)
     {
         file_progress_dialog_->setValue(decode_job_->getFileDecodingProgress());
 
@@ -32,6 +32,7 @@
 #include <QObject>
 #include <QMessageBox>
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <mutex>
@@ -49,6 +50,18 @@ namespace jASTERIX
 class jASTERIX;
 }
 
+// file of a multi-file import, with its own settings
+struct ASTERIXImportFileInfo
+{
+    std::string filename;
+    unsigned int line_id {0};
+    boost::posix_time::ptime date;
+    bool override_tod_active {false};
+    float override_tod_offset {0};
+
+    size_t size {0}; // set on run
+};
+
 class ASTERIXImportTask : public Task, public Configurable
 {
     Q_OBJECT
@@ -98,12 +111,19 @@ class ASTERIXImportTask : public Task, public Configurable
 
     void importFilename(const std::string& filename);
     const std::string& importFilename() { return current_filename_; }
+    // imports the files in one run, a file is decoded while the previous ones are still processed
+    void importFiles(const std::vector<ASTERIXImportFileInfo>& files);
 
     void importNetwork();
     bool isImportNetwork();
 
     std::shared_ptr<jASTERIX::jASTERIX> jASTERIX() { return jasterix_; }
-    void refreshjASTERIX();
+    void refreshjASTERIX(); // also discards file decoders
+    // decoders for parallel file decoding, first is jASTERIX(). additional ones are created once with the
+    // current category configs and kept until refresh
+    std::vector<std::shared_ptr<jASTERIX::jASTERIX>> fileDecoders(unsigned int num);
+
+    unsigned int numFileDecodeThreads() const;
 
     const std::string& currentFraming() const;
 
@@ -147,12 +167,23 @@ class ASTERIXImportTask : public Task, public Configurable
     unsigned int maxNetworkLines() const;
     void maxNetworkLines(unsigned int value);
 
+    bool directBufferMapping() const;
+    void directBufferMapping(bool value);
+
 protected:
     bool debug_jasterix_;
     std::shared_ptr<jASTERIX::jASTERIX> jasterix_;
+    std::vector<std::shared_ptr<jASTERIX::jASTERIX>> file_decoders_; // additional to jasterix_
     ASTERIXPostProcess post_process_;
 
     bool import_file_ {false}; // false = network, true file
+    std::vector<ASTERIXImportFileInfo> import_files_; // if multiple files set
+
+    ASTERIXImportFileInfo decoding_file_; // file of current decode job, settings for network import
+    std::deque<ASTERIXImportFileInfo> files_to_decode_; // after current one
+    unsigned int num_files_ {0};
+    size_t files_total_size_ {0};
+    size_t files_decoded_size_ {0};
 
     nlohmann::json file_list_;
     std::string current_filename_;
@@ -162,6 +193,9 @@ protected:
 
     unsigned int max_network_lines_ {4};
 
+    bool direct_buffer_mapping_ {false}; // map decoded records in decode job, skips json mapping jobs
+    unsigned int num_file_decode_threads_ {0}; // 0 = number of cores, 1 = no parallel decoding
+
     bool test_{false};
 
     bool override_tod_active_{false};
@@ -171,7 +205,8 @@ protected:
 
     bool network_ignore_future_ts_ {false};
 
-    unsigned int num_packets_overload_ {60};
+    unsigned int max_packets_in_processing_ {3}; // file import
+    unsigned int num_packets_overload_ {60}; // network import
     unsigned int num_packets_in_processing_{0};
     unsigned int num_packets_total_{0};
 
@@ -186,9 +221,27 @@ protected:
 
     std::shared_ptr<ASTERIXJSONParsingSchema> schema_;
 
-    std::shared_ptr<ASTERIXDecodeJob> decode_job_;
+    std::shared_ptr<ASTERIXDecodeJob> decode_job_; // data of current file is processed
+    unsigned int decode_job_slot_ {0};
+
+    // file decode jobs started after the current one, in file order. they decode concurrently and keep
+    // their data until they are the current one, so processing and insertion stay in file order
+    struct AheadDecodeJob
+    {
+        std::shared_ptr<ASTERIXDecodeJob> job;
+        ASTERIXImportFileInfo file;
+        unsigned int slot {0};
+    };
+    std::deque<AheadDecodeJob> ahead_decode_jobs_;
+
+    // decoders and post-processing of concurrent decode jobs, one slot per job. slot 0 decodes with
+    // jasterix_ (and file decoders) and post-processes with post_process_, empty decoders for network
+    std::vector<std::vector<std::shared_ptr<jASTERIX::jASTERIX>>> slot_decoders_;
+    std::vector<ASTERIXPostProcess> slot_post_processes_; // of slots > 0
+    std::vector<unsigned int> free_slots_;
 
     std::vector<std::shared_ptr<ASTERIXJSONMappingJob>> json_map_jobs_;
+    std::deque<ASTERIXImportFileInfo> json_map_job_files_; // file of each map job
     std::vector<std::shared_ptr<ASTERIXPostprocessJob>> postprocess_jobs_;
     std::vector<std::map<std::string, std::shared_ptr<Buffer>>> queued_job_buffers_;
 
@@ -198,6 +251,7 @@ protected:
     std::string error_message_;
 
     bool insert_active_{false};
+    size_t last_insert_num_records_ {0};
     //boost::posix_time::ptime insert_start_time_;
     //double total_insert_time_ms_ {0};
 
@@ -208,12 +262,62 @@ protected:
     bool insert_slot_connected_ {false};
     bool all_done_{false};
 
+    // packets in one stage of decode -> map -> post-process -> insert
+    struct StageStats
+    {
+        unsigned int num_active {0}; // running or queued
+        unsigned int max_active {0};
+        size_t num_packets {0}; // finished
+        size_t num_records {0}; // finished
+
+        void add() { ++num_active; max_active = std::max(max_active, num_active); }
+        void remove(size_t num_recs)
+        {
+            assert (num_active);
+            --num_active;
+            ++num_packets;
+            num_records += num_recs;
+        }
+    };
+
+    StageStats map_stats_;
+    // records mapped in mapping jobs, or directly in decode job
+    std::map<unsigned int, std::pair<size_t, size_t>> category_mapped_counts_; // mapped, not mapped
+    size_t num_mapped_ {0};
+    size_t num_not_mapped_ {0};
+    size_t num_mapping_errors_ {0};
+    StageStats postprocess_stats_;
+    StageStats insert_stats_;
+
+    // decoded data is kept in decode job while max load is reached
+    unsigned int num_stalls_ {0};
+    boost::posix_time::time_duration stall_duration_;
+    boost::posix_time::ptime stall_start_time_;
+    // network mode, received while decode job receive buffer was full
+    size_t num_dropped_datagrams_ {0};
+    size_t num_dropped_bytes_ {0};
+
     virtual void checkSubConfigurables() override;
 
+    void setCategoryConfigs(jASTERIX::jASTERIX& jasterix, bool log);
+    std::shared_ptr<jASTERIX::jASTERIX> createjASTERIX(); // with the current category configs
+
+    // sets up decode slots for the files to decode
+    void setupDecodeSlots();
+    ASTERIXPostProcess& slotPostProcess(unsigned int slot);
+    // starts decode job in a free slot, as current one if none exists, else decoding ahead
+    void startDecoding(const ASTERIXImportFileInfo& file);
+    // starts decoding of next files in free slots
+    void startAheadDecoding();
+    void postprocessBuffers(std::map<std::string, std::shared_ptr<Buffer>> job_buffers,
+                            const ASTERIXImportFileInfo& file);
     void insertData(); // inserts queued job buffers
     void checkAllDone();
 
     bool maxLoadReached();
+    void addMappingCounts(const std::map<unsigned int, std::pair<size_t, size_t>>& category_counts,
+                          size_t num_mapped, size_t num_not_mapped, size_t num_errors);
+    void logStageStats();
     void updateFileProgressDialog(bool force=false);
 };
 
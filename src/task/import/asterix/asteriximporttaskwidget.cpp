@@ -123,6 +123,13 @@ void ASTERIXImportTaskWidget::addMainTab()
                 &ASTERIXImportTaskWidget::debugChangedSlot);
         main_tab_layout->addWidget(debug_check_);
 
+        direct_mapping_check_ = new QCheckBox("Direct Buffer Mapping");
+        direct_mapping_check_->setToolTip("Maps decoded records directly into buffers in the decoder,"
+                                          " reduces memory usage for large recordings");
+        direct_mapping_check_->setChecked(task_.directBufferMapping());
+        connect(direct_mapping_check_, &QCheckBox::clicked, this,
+                &ASTERIXImportTaskWidget::directMappingChangedSlot);
+        main_tab_layout->addWidget(direct_mapping_check_);
     }
 
     QWidget* main_tab_widget = new QWidget();
@@ -405,6 +412,14 @@ void ASTERIXImportTaskWidget::debugChangedSlot()
     task_.debug(box->checkState() == Qt::Checked);
 }
 
+void ASTERIXImportTaskWidget::directMappingChangedSlot()
+{
+    QCheckBox* box = dynamic_cast<QCheckBox*>(sender());
+    assert(box);
+
+    task_.directBufferMapping(box->checkState() == Qt::Checked);
+}
+
 //void ASTERIXImportTaskWidget::runStarted()
 //{
 //    loginf << "ASTERIXImportTaskWidget: runStarted";
@@ -50,6 +50,7 @@ class ASTERIXImportTaskWidget : public QWidget
     void dateChangedSlot(QDate date);
 
     void debugChangedSlot();
+    void directMappingChangedSlot();
     void testImportSlot();
 
   public:
@@ -79,6 +80,7 @@ protected:
     ASTERIXOverrideWidget* override_widget_{nullptr};
 
     QCheckBox* debug_check_{nullptr};
+    QCheckBox* direct_mapping_check_{nullptr};
     QCheckBox* limit_ram_check_{nullptr};
 
     void addMainTab();
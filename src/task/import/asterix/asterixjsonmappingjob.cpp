@@ -1,14 +1,11 @@
 #include "asterixjsonmappingjob.h"
 #include "asterixjsonparser.h"
+#include "asterixrecordmapper.h"
 
 #include "buffer.h"
-#include "dbcontent/dbcontent.h"
 #include "json.h"
-#include "jsonobjectparser.h"
 #include "logger.h"
 
-#include <exception>
-
 using namespace std;
 using namespace Utils;
 using namespace nlohmann;
@@ -35,80 +32,15 @@ void ASTERIXJSONMappingJob::run()
 
     started_ = true;
 
-    string dbcontent_name;
-
-    for (auto& parser_it : parsers_)
-    {
-        dbcontent_name = parser_it.second->dbContentName();
-
-        if (!buffers_.count(dbcontent_name))
-            buffers_[dbcontent_name] = parser_it.second->getNewBuffer();
-        else
-            parser_it.second->appendVariablesToBuffer(*buffers_.at(dbcontent_name));
-    }
+    ASTERIXRecordMapper mapper (parsers_);
 
-    auto process_lambda = [this](nlohmann::json& record) {
+    auto process_lambda = [this, &mapper](nlohmann::json& record) {
         //loginf << "UGA '" << record.dump(4) << "'";
 
         if (this->obsolete_)
             return;
 
-        unsigned int category{0};
-        assert (record.contains("category"));
-
-        category = record.at("category");
-
-        bool parsed{false};
-        bool parsed_any{false};
-
-        if (!parsers_.count(category))
-            return;
-
-        const unique_ptr<ASTERIXJSONParser>& parser = parsers_.at(category);
-
-        string dbcontent_name = parser->dbContentName();
-
-        logdbg << "ASTERIXJSONMappingJob: run: mapping json: cat " << category;
-
-        std::shared_ptr<Buffer>& buffer = buffers_.at(dbcontent_name);
-        assert(buffer);
-
-        try
-        {
-            logdbg << "ASTERIXJSONMappingJob: run: obj " << dbcontent_name << " parsing JSON";
-
-            parsed = parser->parseJSON(record, *buffer);
-
-//            if (parsed)
-//            {
-//                logdbg << "ASTERIXJSONMappingJob: run: obj " << parser.dbObject().name() << " transforming buffer";
-//                //parser.transformBuffer(*buffer, buffer->size() - 1);
-//            }
-
-            logdbg << "ASTERIXJSONMappingJob: run: obj " << dbcontent_name << " done";
-
-            parsed_any |= parsed;
-        }
-        catch (exception& e)
-        {
-            logerr << "ASTERIXJSONMappingJob: run: caught exception '" << e.what() << "' in \n'"
-                       << record.dump(4) << "' parser dbo " << dbcontent_name;
-
-            ++num_errors_;
-
-            return;
-        }
-
-        if (parsed_any)
-        {
-            category_mapped_counts_[category].first += 1;
-            ++num_mapped_;
-        }
-        else
-        {
-            category_mapped_counts_[category].second += 1;
-            ++num_not_mapped_;
-        }
+        mapper.mapRecord(record);
     };
 
     for (auto& data_slice : data_)
@@ -121,18 +53,13 @@ void ASTERIXJSONMappingJob::run()
         }
     }
 
-    std::map<std::string, std::shared_ptr<Buffer>> not_empty_buffers;
+    buffers_ = mapper.buffers();
 
-    logdbg << "ASTERIXJSONMappingJob: run: counting buffer sizes";
-    for (auto& buf_it : buffers_)
-    {
-        if (buf_it.second && buf_it.second->size())
-        {
-            num_created_ += buf_it.second->size();
-            not_empty_buffers[buf_it.first] = buf_it.second;
-        }
-    }
-    buffers_ = not_empty_buffers;  // cleaner
+    category_mapped_counts_ = mapper.categoryMappedCounts();
+    num_mapped_ = mapper.numMapped();
+    num_not_mapped_ = mapper.numNotMapped();
+    num_errors_ = mapper.numErrors();
+    num_created_ = mapper.numCreated();
 
     data_.clear();
 
@@ -21,6 +21,7 @@
 #include "dbcontent/dbcontent.h"
 #include "json.h"
 #include "jsonobjectparser.h"
+#include "jsonmappingplan.h"
 #include "asterixjsonparser.h"
 #include "logger.h"
 
@@ -133,7 +134,19 @@ void JSONMappingJob::parseJSON()
                 *buffers_.at(parser_it.second->dbContentName()));
     }
 
-    auto process_lambda = [this](nlohmann::json& record) {
+    // parser name -> plan, created after all variables were added
+    std::map<std::string, std::unique_ptr<JSONMappingPlan>> plans;
+
+    for (auto& parser_it : *json_parsers_)
+    {
+        if (!parser_it.second->active())
+            continue;
+
+        plans[parser_it.first] = parser_it.second->createMappingPlan(
+                    *buffers_.at(parser_it.second->dbContentName()));
+    }
+
+    auto process_lambda = [this, &plans](nlohmann::json& record) {
         //loginf << "UGA '" << record.dump(4) << "'";
 
         unsigned int category{0};
@@ -153,13 +166,13 @@ void JSONMappingJob::parseJSON()
                 continue;
 
             logdbg << "JSONMappingJob: parseJSON: mapping json: obj " << map_it.second->dbContentName();
-            std::shared_ptr<Buffer>& buffer = buffers_.at(map_it.second->dbContentName());
-            assert(buffer);
+            assert(plans.count(map_it.first));
+            JSONMappingPlan& plan = *plans.at(map_it.first);
             try
             {
                 logdbg << "JSONMappingJob: parseJSON: obj " << map_it.second->dbContentName() << " parsing JSON";
 
-                parsed = map_it.second->parseJSON(record, *buffer);
+                parsed = map_it.second->parseJSON(record, plan);
 
                 logdbg << "JSONMappingJob: parseJSON: obj " << map_it.second->dbContentName() << " done";
 
@@ -215,7 +228,14 @@ void JSONMappingJob::parseASTERIX()
                 *buffers_.at(parser_it.second->dbContentName()));
     }
 
-    auto process_lambda = [this](nlohmann::json& record) {
+    // category -> plan, created after all variables were added
+    std::map<unsigned int, std::unique_ptr<JSONMappingPlan>> plans;
+
+    for (auto& parser_it : *asterix_parsers_)
+        plans[parser_it.first] = parser_it.second->createMappingPlan(
+                    *buffers_.at(parser_it.second->dbContentName()));
+
+    auto process_lambda = [this, &plans](nlohmann::json& record) {
         //loginf << "UGA '" << record.dump(4) << "'";
 
         unsigned int category{0};
@@ -237,14 +257,14 @@ void JSONMappingJob::parseASTERIX()
 
         logdbg << "ASTERIXJSONMappingJob: run: mapping json: cat " << category;
 
-        std::shared_ptr<Buffer>& buffer = buffers_.at(dbcontent_name);
-        assert(buffer);
+        assert(plans.count(category));
+        JSONMappingPlan& plan = *plans.at(category);
 
         try
         {
             logdbg << "ASTERIXJSONMappingJob: run: obj " << dbcontent_name << " parsing JSON";
 
-            parsed = parser->parseJSON(record, *buffer);
+            parsed = parser->parseJSON(record, plan);
 
 //            if (parsed)
 //            {
@@ -338,6 +338,10 @@ void ViewPointsImportTask::run()
 
         if (context.contains("datasets"))
         {
+            ASTERIXImportTask& asterix_importer_task = task_manager_.asterixImporterTask();
+
+            std::vector<ASTERIXImportFileInfo> files;
+
             for (auto& ds_it : context.at("datasets").get<json::array_t>())
             {
                 std::string name;
@@ -347,7 +351,7 @@ void ViewPointsImportTask::run()
 
                 std::string filename = ds_it.at("filename");
 
-                loginf << "ViewPointsImportTask: import: importing dataset name '" << name
+                loginf << "ViewPointsImportTask: import: adding dataset name '" << name
                        << "' file '" << filename << "'";
 
                 if (!Files::fileExists(filename))
@@ -360,7 +364,8 @@ void ViewPointsImportTask::run()
                     assert (Files::fileExists(filename));
                 }
 
-                ASTERIXImportTask& asterix_importer_task = task_manager_.asterixImporterTask();
+                ASTERIXImportFileInfo file_info;
+                file_info.filename = filename;
 
                 // line
                 if (ds_it.contains("line_id"))
@@ -370,10 +375,10 @@ void ViewPointsImportTask::run()
 
                     loginf << "ViewPointsImportTask: import: line_id " << line_id;
 
-                    asterix_importer_task.fileLineID(line_id);
+                    file_info.line_id = line_id;
                 }
                 else
-                    asterix_importer_task.fileLineID(0); // import to L1 if not set
+                    file_info.line_id = 0; // import to L1 if not set
 
 
                 if (ds_it.contains("time_offset"))
@@ -382,13 +387,13 @@ void ViewPointsImportTask::run()
 
                     float tod_offset = ds_it.at("time_offset");
 
-                    asterix_importer_task.overrideTodActive(true);
-                    asterix_importer_task.overrideTodOffset(tod_offset);
+                    file_info.override_tod_active = true;
+                    file_info.override_tod_offset = tod_offset;
                 }
                 else
                 {
                     loginf << "ViewPointsImportTask: import: override information not set";
-                    asterix_importer_task.overrideTodActive(false);
+                    file_info.override_tod_active = false;
                 }
 
                 if (ds_it.contains("date"))
@@ -398,12 +403,17 @@ void ViewPointsImportTask::run()
 
                     loginf << "ViewPointsImportTask: import: date " << date_str;
 
-                    boost::posix_time::ptime date = Time::fromDateString(date_str);
-
-                    asterix_importer_task.date(date);
+                    file_info.date = Time::fromDateString(date_str);
                 }
+                else
+                    file_info.date = files.size() ? files.back().date : asterix_importer_task.date();
 
-                asterix_importer_task.importFilename(filename);
+                files.push_back(file_info);
+            }
+
+            if (files.size())
+            {
+                asterix_importer_task.importFiles(files);
 
                 assert(asterix_importer_task.canRun());
                 asterix_importer_task.showDoneSummary(false);
@@ -418,8 +428,7 @@ void ViewPointsImportTask::run()
                     QThread::msleep(1);
                 }
 
-                loginf << "ViewPointsImportTask: import: importing dataset '" << name << "' done";
-
+                loginf << "ViewPointsImportTask: import: importing " << files.size() << " datasets done";
             }
 
             //task_manager_.appendSuccess("ViewPointsImportTask: import of ASTERIX files done");
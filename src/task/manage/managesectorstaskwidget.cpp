@@ -449,6 +449,9 @@ void ManageSectorsTaskWidget::importSlot()
         loginf << "ManageSectorsTaskWidget: importSlot: accepted, layer name '" << dialog.layerName()
                << "' exclude " << dialog.exclude();
 
+        if (evaluationRunning())
+            return;
+
         assert (task_.canImportFile());
         task_.importFile(dialog.layerName(), dialog.exclude(), dialog.color());
 
@@ -479,6 +482,12 @@ void ManageSectorsTaskWidget::sectorItemChangedSlot(QTableWidgetItem* item)
     loginf << "ManageSectorsTaskWidget: sectorItemChangedSlot: sector_id " << sector_id
            << " col_name " << col_name << " text '" << text << "'";
 
+    if (evaluationRunning())
+    {
+        updateSectorTable(); // revert
+        return;
+    }
+
     EvaluationManager& eval_man = COMPASS::instance().evaluationManager();
 
     assert (eval_man.hasSector(sector_id));
@@ -584,6 +593,9 @@ void ManageSectorsTaskWidget::deleteSectorSlot()
 {
     loginf << "ManageSectorsTaskWidget: deleteSectorSlot";
 
+    if (evaluationRunning())
+        return;
+
     QPushButton* button = dynamic_cast<QPushButton*>(sender());
     assert (button);
 
@@ -634,6 +646,9 @@ void ManageSectorsTaskWidget::clearSectorsSlot ()
 {
     loginf << "ManageSectorsTaskWidget: clearSectorsSlot";
 
+    if (evaluationRunning())
+        return;
+
     COMPASS::instance().evaluationManager().deleteAllSectors();
 
     updateSectorTable();
@@ -643,6 +658,9 @@ void ManageSectorsTaskWidget::importSectorsSlot ()
 {
     loginf << "ManageSectorsTaskWidget: importSectorsSlot";
 
+    if (evaluationRunning())
+        return;
+
     QString filename =
         QFileDialog::getOpenFileName(nullptr, "Export Sectors as JSON", "", "*.json");
 
@@ -664,3 +682,15 @@ void ManageSectorsTaskWidget::importSectorsJSON (const std::string& filename)
 
     updateSectorTable();
 }
+
+bool ManageSectorsTaskWidget::evaluationRunning()
+{
+    if (!COMPASS::instance().evaluationManager().evaluationRunning())
+        return false;
+
+    QMessageBox m_warning(QMessageBox::Warning, "Sector Change Failed",
+                          "Sectors can not be changed while an evaluation is running.", QMessageBox::Ok);
+    m_warning.exec();
+
+    return true;
+}
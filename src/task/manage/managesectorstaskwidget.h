@@ -88,6 +88,8 @@ protected:
     void addManageTab();
 
     void updateSectorTable();
+
+    bool evaluationRunning(); // shows warning if running
 };
 
 #endif // MANAGESECTORSTASKWIDGET_H
@@ -0,0 +1,203 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "localstereographic.h"
+
+#include <cmath>
+#include <random>
+
+namespace
+{
+// WGS84, independent of the projection constants
+const double WGS84_A = 6378137.0;
+const double WGS84_E2 = 0.00669437999014;
+const double DEG2RAD = M_PI / 180.0;
+
+// meridional and prime vertical radii of curvature
+double meridianRadius (double lat)
+{
+    double sin_lat = std::sin(lat * DEG2RAD);
+    return WGS84_A * (1.0 - WGS84_E2) / std::pow(1.0 - WGS84_E2 * sin_lat * sin_lat, 1.5);
+}
+
+double primeVerticalRadius (double lat)
+{
+    double sin_lat = std::sin(lat * DEG2RAD);
+    return WGS84_A / std::sqrt(1.0 - WGS84_E2 * sin_lat * sin_lat);
+}
+
+// derivatives of x, y per meter north and east at lat, lon, by central differences
+void localDerivatives (const LocalStereographic& proj, double lat, double lon,
+                       double& dx_north, double& dy_north, double& dx_east, double& dy_east)
+{
+    const double h = 1e-5; // degrees
+
+    double x1 {0}, y1 {0}, x2 {0}, y2 {0};
+
+    REQUIRE(proj.wgs2Cart(lat + h, lon, x1, y1));
+    REQUIRE(proj.wgs2Cart(lat - h, lon, x2, y2));
+
+    double meters_north = 2 * h * DEG2RAD * meridianRadius(lat);
+    dx_north = (x1 - x2) / meters_north;
+    dy_north = (y1 - y2) / meters_north;
+
+    REQUIRE(proj.wgs2Cart(lat, lon + h, x1, y1));
+    REQUIRE(proj.wgs2Cart(lat, lon - h, x2, y2));
+
+    double meters_east = 2 * h * DEG2RAD * primeVerticalRadius(lat) * std::cos(lat * DEG2RAD);
+    dx_east = (x1 - x2) / meters_east;
+    dy_east = (y1 - y2) / meters_east;
+}
+}
+
+TEST_CASE("LocalStereographic origin", "[LocalStereographic]")
+{
+    LocalStereographic proj (47.5, 14.2);
+
+    REQUIRE(proj.valid());
+
+    double x {0}, y {0}, lat {0}, lon {0};
+
+    REQUIRE(proj.wgs2Cart(47.5, 14.2, x, y));
+    REQUIRE(std::fabs(x) < 1e-9);
+    REQUIRE(std::fabs(y) < 1e-9);
+
+    REQUIRE(proj.cart2WGS(0.0, 0.0, lat, lon));
+    REQUIRE(lat == Approx(47.5).margin(1e-12));
+    REQUIRE(lon == Approx(14.2).margin(1e-12));
+
+    // due north on the central meridian, due east to the right
+    REQUIRE(proj.wgs2Cart(48.0, 14.2, x, y));
+    REQUIRE(std::fabs(x) < 1e-6);
+    REQUIRE(y > 0);
+
+    REQUIRE(proj.wgs2Cart(47.5, 14.7, x, y));
+    REQUIRE(x > 0);
+}
+
+TEST_CASE("LocalStereographic unit scale at origin, conformal", "[LocalStereographic]")
+{
+    double origins[][2] = {{0.0, 0.0}, {47.5, 14.2}, {-33.9, 151.2}, {64.1, -21.9}, {-70.0, 179.9}};
+
+    double dx_north, dy_north, dx_east, dy_east;
+
+    for (auto& origin : origins)
+    {
+        LocalStereographic proj (origin[0], origin[1]);
+
+        // true scale, north is y and east is x
+        localDerivatives(proj, origin[0], origin[1], dx_north, dy_north, dx_east, dy_east);
+
+        REQUIRE(dx_north == Approx(0.0).margin(1e-6));
+        REQUIRE(dy_north == Approx(1.0).epsilon(1e-6));
+        REQUIRE(dx_east == Approx(1.0).epsilon(1e-6));
+        REQUIRE(dy_east == Approx(0.0).margin(1e-6));
+
+        // away from origin, same scale in all directions and right angles kept
+        double lat = origin[0] + (origin[0] > 0 ? -2.0 : 2.0);
+        double lon = origin[1] - 2.5;
+
+        localDerivatives(proj, lat, lon, dx_north, dy_north, dx_east, dy_east);
+
+        double scale_north = std::hypot(dx_north, dy_north);
+        double scale_east = std::hypot(dx_east, dy_east);
+
+        REQUIRE(scale_north > 1.0);
+        REQUIRE(scale_north == Approx(scale_east).epsilon(1e-6));
+        REQUIRE((dx_north * dx_east + dy_north * dy_east) == Approx(0.0).margin(1e-6));
+    }
+}
+
+TEST_CASE("LocalStereographic round-trip", "[LocalStereographic]")
+{
+    std::mt19937 gen (42);
+    std::uniform_real_distribution<double> lat_dist (-80.0, 80.0);
+    std::uniform_real_distribution<double> lon_dist (-180.0, 180.0);
+    std::uniform_real_distribution<double> offset_dist (-3.0, 3.0); // degrees, ~300km
+    std::uniform_real_distribution<double> cart_dist (-500e3, 500e3);
+
+    LocalStereographic proj;
+    double x {0}, y {0}, lat {0}, lon {0}, lat2 {0}, lon2 {0}, x2 {0}, y2 {0};
+
+    for (unsigned int cnt = 0; cnt < 10000; ++cnt)
+    {
+        proj.origin(lat_dist(gen), lon_dist(gen));
+
+        REQUIRE(proj.valid());
+
+        // wgs -> cart -> wgs
+        lat = proj.latitude0() + offset_dist(gen);
+        lon = proj.longitude0() + offset_dist(gen);
+
+        if (lon > 180.0)
+            lon -= 360.0;
+        else if (lon < -180.0)
+            lon += 360.0;
+
+        REQUIRE(proj.wgs2Cart(lat, lon, x, y));
+        REQUIRE(proj.cart2WGS(x, y, lat2, lon2));
+
+        double lon_diff = std::fabs(lon2 - lon);
+        lon_diff = std::min(lon_diff, 360.0 - lon_diff);
+
+        REQUIRE(std::fabs(lat2 - lat) < 1e-9);
+        REQUIRE(lon_diff < 1e-9);
+
+        // cart -> wgs -> cart
+        x = cart_dist(gen);
+        y = cart_dist(gen);
+
+        REQUIRE(proj.cart2WGS(x, y, lat, lon));
+        REQUIRE(proj.wgs2Cart(lat, lon, x2, y2));
+
+        REQUIRE(std::fabs(x2 - x) < 1e-4);
+        REQUIRE(std::fabs(y2 - y) < 1e-4);
+    }
+}
+
+TEST_CASE("LocalStereographic batch and poles", "[LocalStereographic]")
+{
+    LocalStereographic proj (52.0, 4.0);
+
+    double lats[] = {51.0, 52.5, 53.0};
+    double lons[] = {3.0, 4.5, 6.0};
+    double xs[3], ys[3], lats2[3], lons2[3];
+
+    REQUIRE(proj.wgs2Cart(lats, lons, xs, ys, 3));
+    REQUIRE(proj.cart2WGS(xs, ys, lats2, lons2, 3));
+
+    double x {0}, y {0};
+
+    for (unsigned int cnt = 0; cnt < 3; ++cnt)
+    {
+        REQUIRE(proj.wgs2Cart(lats[cnt], lons[cnt], x, y));
+        REQUIRE(xs[cnt] == x);
+        REQUIRE(ys[cnt] == y);
+        REQUIRE(lats2[cnt] == Approx(lats[cnt]).margin(1e-9));
+        REQUIRE(lons2[cnt] == Approx(lons[cnt]).margin(1e-9));
+    }
+
+    proj.origin(90.0, 0.0);
+    REQUIRE(!proj.valid());
+    REQUIRE(!proj.wgs2Cart(89.0, 0.0, x, y));
+
+    proj.origin(-90.0, 0.0);
+    REQUIRE(!proj.valid());
+}
@@ -0,0 +1,101 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "localstereographic.h"
+
+#include <gdal_version.h>
+#include <ogr_spatialref.h>
+
+#include <cmath>
+#include <memory>
+#include <random>
+
+// compares LocalStereographic with the OGR transformations it replaced, x/y in meters
+TEST_CASE("LocalStereographic matches OGR SetStereographic", "[LocalStereographic]")
+{
+    std::mt19937 gen (42);
+    std::uniform_real_distribution<double> lat_dist (-80.0, 80.0);
+    std::uniform_real_distribution<double> lon_dist (-180.0, 180.0);
+    std::uniform_real_distribution<double> offset_dist (-3.0, 3.0); // degrees, ~300km
+
+    OGRSpatialReference wgs84;
+    wgs84.SetWellKnownGeogCS("WGS84");
+
+#if GDAL_VERSION_MAJOR >= 3
+    wgs84.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER); // x is longitude
+#endif
+
+    LocalStereographic proj;
+
+    for (unsigned int origin_cnt = 0; origin_cnt < 200; ++origin_cnt)
+    {
+        double lat0 = lat_dist(gen);
+        double lon0 = lon_dist(gen);
+
+        OGRSpatialReference local;
+        local.SetStereographic(lat0, lon0, 1.0, 0.0, 0.0);
+
+#if GDAL_VERSION_MAJOR >= 3
+        local.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+
+        std::unique_ptr<OGRCoordinateTransformation> geo2cart (OGRCreateCoordinateTransformation(&wgs84, &local));
+        std::unique_ptr<OGRCoordinateTransformation> cart2geo (OGRCreateCoordinateTransformation(&local, &wgs84));
+
+        REQUIRE(geo2cart);
+        REQUIRE(cart2geo);
+
+        proj.origin(lat0, lon0);
+
+        for (unsigned int cnt = 0; cnt < 50; ++cnt)
+        {
+            double lat = lat0 + offset_dist(gen);
+            double lon = lon0 + offset_dist(gen);
+
+            if (lon > 180.0)
+                lon -= 360.0;
+            else if (lon < -180.0)
+                lon += 360.0;
+
+            // forward
+            double x {0}, y {0};
+            REQUIRE(proj.wgs2Cart(lat, lon, x, y));
+
+            double ogr_x = lon, ogr_y = lat;
+            REQUIRE(geo2cart->Transform(1, &ogr_x, &ogr_y));
+
+            REQUIRE(std::fabs(x - ogr_x) < 1e-3);
+            REQUIRE(std::fabs(y - ogr_y) < 1e-3);
+
+            // inverse
+            double lat2 {0}, lon2 {0};
+            REQUIRE(proj.cart2WGS(x, y, lat2, lon2));
+
+            double ogr_lon = x, ogr_lat = y;
+            REQUIRE(cart2geo->Transform(1, &ogr_lon, &ogr_lat));
+
+            double lon_diff = std::fabs(lon2 - ogr_lon);
+            lon_diff = std::min(lon_diff, 360.0 - lon_diff);
+
+            REQUIRE(std::fabs(lat2 - ogr_lat) < 1e-8); // ~1mm
+            REQUIRE(lon_diff < 1e-8 / std::cos(lat * M_PI / 180.0));
+        }
+    }
+}
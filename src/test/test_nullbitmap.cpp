@@ -0,0 +1,214 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "nullbitmap.h"
+
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// checks bitmap against reference, including the word-wise functions on a random range
+void check (const NullBitmap& bitmap, const std::vector<bool>& ref, std::mt19937& gen)
+{
+    REQUIRE(bitmap.size() == ref.size());
+    REQUIRE(bitmap.empty() == ref.empty());
+
+    size_t num_set = 0;
+    size_t last_set = NullBitmap::NPOS;
+
+    for (size_t cnt = 0; cnt < ref.size(); ++cnt)
+    {
+        REQUIRE(bitmap.at(cnt) == ref[cnt]);
+
+        if (ref[cnt])
+        {
+            ++num_set;
+            last_set = cnt;
+        }
+    }
+
+    REQUIRE(bitmap.count() == num_set);
+    REQUIRE(bitmap.any() == (num_set > 0));
+    REQUIRE(bitmap.findLast() == last_set);
+
+    std::uniform_int_distribution<size_t> index_dist (0, ref.size());
+    size_t from_index = index_dist(gen);
+    size_t to_index = index_dist(gen);
+
+    if (from_index > to_index)
+        std::swap(from_index, to_index);
+
+    std::vector<size_t> set_indexes, ref_set_indexes;
+    bitmap.forEachSet(from_index, to_index, [&](size_t index) { set_indexes.push_back(index); });
+
+    std::vector<std::pair<size_t, size_t>> unset_runs, ref_unset_runs;
+    bitmap.forEachUnsetRun(from_index, to_index, [&](size_t begin, size_t end)
+    {
+        // runs crossing word borders may be split, join them
+        if (unset_runs.size() && unset_runs.back().second == begin)
+            unset_runs.back().second = end;
+        else
+            unset_runs.push_back({begin, end});
+    });
+
+    for (size_t cnt = from_index; cnt < to_index; ++cnt)
+    {
+        if (ref[cnt])
+            ref_set_indexes.push_back(cnt);
+        else if (ref_unset_runs.size() && ref_unset_runs.back().second == cnt)
+            ref_unset_runs.back().second = cnt + 1;
+        else
+            ref_unset_runs.push_back({cnt, cnt + 1});
+    }
+
+    REQUIRE(set_indexes == ref_set_indexes);
+    REQUIRE(unset_runs == ref_unset_runs);
+}
+}
+
+TEST_CASE("NullBitmap matches vector<bool>", "[NullBitmap]")
+{
+    std::mt19937 gen (42);
+    std::uniform_int_distribution<unsigned int> op_dist (0, 7);
+    std::uniform_int_distribution<size_t> size_dist (0, 300);
+    std::bernoulli_distribution bool_dist (0.5);
+
+    NullBitmap bitmap;
+    std::vector<bool> ref;
+
+    for (unsigned int op_cnt = 0; op_cnt < 5000; ++op_cnt)
+    {
+        switch (op_dist(gen))
+        {
+            case 0: // grow or shrink
+            {
+                size_t size = ref.size() + size_dist(gen) - (op_cnt % 2 ? 0 : std::min(ref.size(), size_dist(gen)));
+                bool value = bool_dist(gen);
+
+                bitmap.resize(size, value);
+                ref.resize(size, value);
+                break;
+            }
+            case 1: // set random bits
+            case 2:
+            {
+                if (!ref.size())
+                    break;
+
+                std::uniform_int_distribution<size_t> index_dist (0, ref.size() - 1);
+
+                for (unsigned int cnt = 0; cnt < 20; ++cnt)
+                {
+                    size_t index = index_dist(gen);
+                    bool value = bool_dist(gen);
+
+                    bitmap.set(index, value);
+                    ref[index] = value;
+                }
+                break;
+            }
+            case 3:
+            {
+                bool value = bool_dist(gen);
+
+                bitmap.fill(value);
+                ref.assign(ref.size(), value);
+                break;
+            }
+            case 4: // append other bitmap, which itself has an offset
+            {
+                NullBitmap other;
+                std::vector<bool> other_ref;
+
+                size_t size = size_dist(gen);
+                other.resize(size);
+                other_ref.resize(size);
+
+                for (size_t cnt = 0; cnt < size; ++cnt)
+                {
+                    bool value = bool_dist(gen);
+                    other.set(cnt, value);
+                    other_ref[cnt] = value;
+                }
+
+                size_t num_erase = std::min(size, size_dist(gen) / 4);
+                other.eraseFront(num_erase);
+                other_ref.erase(other_ref.begin(), other_ref.begin() + num_erase);
+
+                bitmap.append(other);
+                ref.insert(ref.end(), other_ref.begin(), other_ref.end());
+                break;
+            }
+            case 5: // remove from front
+            case 6:
+            {
+                size_t num = std::min(ref.size(), size_dist(gen) / 2);
+
+                bitmap.eraseFront(num);
+                ref.erase(ref.begin(), ref.begin() + num);
+                break;
+            }
+            case 7:
+            {
+                if (op_cnt % 50 == 0)
+                {
+                    bitmap.clear();
+                    ref.clear();
+                }
+                break;
+            }
+        }
+
+        check(bitmap, ref, gen);
+    }
+}
+
+TEST_CASE("NullBitmap word borders", "[NullBitmap]")
+{
+    const size_t word_bits = NullBitmap::WORD_BITS; // copies, REQUIRE binds by reference
+    const size_t npos = NullBitmap::NPOS;
+
+    NullBitmap bitmap;
+
+    bitmap.resize(word_bits - 1, true);
+    bitmap.resize(2 * word_bits + 1, false);
+
+    REQUIRE(bitmap.count() == word_bits - 1);
+    REQUIRE(bitmap.findLast() == word_bits - 2);
+
+    bitmap.eraseFront(word_bits - 2);
+
+    REQUIRE(bitmap.size() == word_bits + 3);
+    REQUIRE(bitmap.count() == 1);
+    REQUIRE(bitmap.at(0));
+    REQUIRE(!bitmap.at(1));
+
+    bitmap.fill(true); // must not set bits before the offset
+
+    REQUIRE(bitmap.count() == bitmap.size());
+
+    bitmap.resize(0);
+
+    REQUIRE(bitmap.empty());
+    REQUIRE(!bitmap.any());
+    REQUIRE(bitmap.findLast() == npos);
+}
@@ -0,0 +1,155 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "offsetvector.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+template <typename T>
+void check (const OffsetVector<T>& values, const std::vector<T>& ref)
+{
+    REQUIRE(values.size() == ref.size());
+    REQUIRE(values.empty() == ref.empty());
+
+    for (size_t cnt = 0; cnt < ref.size(); ++cnt)
+    {
+        REQUIRE(values[cnt] == ref[cnt]);
+        REQUIRE(values.at(cnt) == ref[cnt]);
+    }
+
+    REQUIRE(std::vector<T>(values.begin(), values.end()) == ref);
+}
+
+// random operations on values and ref, value_func(gen) creates new values
+template <typename T, typename ValueFunc>
+void runDifferential (unsigned int num_ops, ValueFunc value_func)
+{
+    std::mt19937 gen (42);
+    std::uniform_int_distribution<unsigned int> op_dist (0, 5);
+    std::uniform_int_distribution<size_t> size_dist (0, 3000); // above compaction size
+
+    OffsetVector<T> values;
+    std::vector<T> ref;
+
+    for (unsigned int op_cnt = 0; op_cnt < num_ops; ++op_cnt)
+    {
+        switch (op_dist(gen))
+        {
+            case 0: // append
+            {
+                std::vector<T> new_values (size_dist(gen));
+
+                for (auto& value_it : new_values)
+                    value_it = value_func(gen);
+
+                values.insert(values.end(), new_values.begin(), new_values.end());
+                ref.insert(ref.end(), new_values.begin(), new_values.end());
+                break;
+            }
+            case 1: // grow or shrink
+            {
+                size_t size = size_dist(gen);
+                T value = value_func(gen);
+
+                values.resize(size, value);
+                ref.resize(size, value);
+                break;
+            }
+            case 2: // overwrite
+            {
+                if (!ref.size())
+                    break;
+
+                std::uniform_int_distribution<size_t> index_dist (0, ref.size() - 1);
+
+                for (unsigned int cnt = 0; cnt < 20; ++cnt)
+                {
+                    size_t index = index_dist(gen);
+                    T value = value_func(gen);
+
+                    values[index] = value;
+                    ref[index] = value;
+                }
+                break;
+            }
+            case 3: // remove from front
+            case 4:
+            {
+                size_t num = std::min(ref.size(), size_dist(gen) / 2);
+
+                values.eraseFront(num);
+                ref.erase(ref.begin(), ref.begin() + num);
+                break;
+            }
+            case 5:
+            {
+                if (op_cnt % 20 == 0)
+                {
+                    values.clear();
+                    ref.clear();
+                }
+                else
+                    values.reserve(ref.size() + size_dist(gen));
+                break;
+            }
+        }
+
+        check(values, ref);
+    }
+}
+}
+
+TEST_CASE("OffsetVector matches vector", "[OffsetVector]")
+{
+    runDifferential<int>(2000, [](std::mt19937& gen) { return (int) gen(); });
+}
+
+TEST_CASE("OffsetVector matches vector, non-trivial type", "[OffsetVector]")
+{
+    runDifferential<std::string>(500, [](std::mt19937& gen) { return std::to_string(gen()); });
+}
+
+TEST_CASE("OffsetVector data after eraseFront", "[OffsetVector]")
+{
+    OffsetVector<double> values;
+    values.resize(5000);
+
+    for (size_t cnt = 0; cnt < values.size(); ++cnt)
+        values[cnt] = cnt;
+
+    values.eraseFront(10); // only moves offset
+
+    REQUIRE(values.data()[0] == 10);
+    REQUIRE(&values[0] == values.data());
+
+    values.eraseFront(4000); // compacts
+
+    REQUIRE(values.size() == 990);
+    REQUIRE(values.data()[0] == 4010);
+    REQUIRE(values.at(989) == 4999);
+
+    values.eraseFront(1000);
+
+    REQUIRE(values.empty());
+}
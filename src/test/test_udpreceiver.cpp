@@ -0,0 +1,155 @@
+/*
+ * This file is part of OpenATS COMPASS.
+ *
+ * COMPASS is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * COMPASS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+
+ * You should have received a copy of the GNU General Public License
+ * along with COMPASS. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+#include "udpreceiver.h"
+#include "datasourcelineinfo.h"
+
+#include <boost/asio.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace boost::asio;
+using namespace boost::posix_time;
+
+namespace
+{
+// free loopback port, by binding to port 0
+unsigned short freePort (io_context& io_context)
+{
+    ip::udp::socket socket (io_context, ip::udp::endpoint(ip::address::from_string("127.0.0.1"), 0));
+    return socket.local_endpoint().port();
+}
+
+// sends num datagrams "<prefix><cnt>" of size cnt % 100 + 20 to port from sender address
+void send (io_context& io_context, const std::string& sender_ip, unsigned short port,
+           const std::string& prefix, unsigned int num)
+{
+    ip::udp::socket socket (io_context, ip::udp::endpoint(ip::address::from_string(sender_ip), 0));
+    ip::udp::endpoint receiver (ip::address::from_string("127.0.0.1"), port);
+
+    for (unsigned int cnt = 0; cnt < num; ++cnt)
+    {
+        std::string data = prefix + std::to_string(cnt);
+        data.resize(cnt % 100 + 20, '.');
+
+        socket.send_to(buffer(data), receiver);
+    }
+}
+
+// runs io context until num datagrams were received, at most 5 seconds
+void receive (io_context& io_context, const std::vector<std::string>& received, size_t num)
+{
+    auto end = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+
+    while (received.size() < num && std::chrono::steady_clock::now() < end)
+    {
+        io_context.restart();
+        io_context.run_for(std::chrono::milliseconds(10));
+    }
+
+    // nothing more
+    io_context.restart();
+    io_context.run_for(std::chrono::milliseconds(50));
+}
+}
+
+TEST_CASE("UDPReceiver receives all datagrams in order", "[UDPReceiver]")
+{
+    io_context io_context;
+    unsigned short port = freePort(io_context);
+
+    nlohmann::json config = {{"mcast_ip", "127.0.0.1"}, {"mcast_port", port}};
+    std::shared_ptr<DataSourceLineInfo> line_info (new DataSourceLineInfo("L1", config));
+
+    std::vector<std::string> received;
+    std::vector<ptime> receive_times;
+    size_t num_callbacks = 0;
+
+    UDPReceiver receiver (io_context, line_info, [&](const std::vector<UDPDatagram>& batch)
+    {
+        ++num_callbacks;
+
+        for (auto& datagram : batch)
+        {
+            received.push_back(std::string(datagram.data, datagram.length));
+            receive_times.push_back(datagram.receive_time);
+        }
+    }, 1024*1024);
+
+    const unsigned int num = 500; // several recvmmsg batches
+
+    ptime send_time = microsec_clock::universal_time();
+    send(io_context, "127.0.0.1", port, "data", num);
+
+    receive(io_context, received, num);
+
+    REQUIRE(received.size() == num);
+    REQUIRE(receiver.numDatagrams() == num);
+    REQUIRE(receiver.numBatches() == num_callbacks);
+
+    for (unsigned int cnt = 0; cnt < num; ++cnt)
+    {
+        REQUIRE(received.at(cnt).size() == cnt % 100 + 20);
+        REQUIRE(received.at(cnt).find("data" + std::to_string(cnt) + ".") == 0);
+    }
+
+#if defined(__linux__)
+    // all available datagrams read at once, with kernel timestamps in UTC
+    REQUIRE(receiver.numBatches() < num);
+
+    for (auto& receive_time : receive_times)
+    {
+        REQUIRE(!receive_time.is_not_a_date_time());
+        REQUIRE(receive_time >= send_time - seconds(1));
+        REQUIRE(receive_time <= microsec_clock::universal_time() + seconds(1));
+    }
+#endif
+}
+
+TEST_CASE("UDPReceiver filters by sender address", "[UDPReceiver]")
+{
+    io_context io_context;
+    unsigned short port = freePort(io_context);
+
+    nlohmann::json config = {{"mcast_ip", "127.0.0.1"}, {"mcast_port", port}, {"sender_ip", "127.0.0.2"}};
+    std::shared_ptr<DataSourceLineInfo> line_info (new DataSourceLineInfo("L1", config));
+
+    std::vector<std::string> received;
+
+    UDPReceiver receiver (io_context, line_info, [&](const std::vector<UDPDatagram>& batch)
+    {
+        for (auto& datagram : batch)
+            received.push_back(std::string(datagram.data, datagram.length));
+    }, 1024*1024);
+
+    send(io_context, "127.0.0.1", port, "other", 100);
+    send(io_context, "127.0.0.2", port, "sender", 100);
+
+    receive(io_context, received, 100);
+
+    REQUIRE(received.size() == 100);
+
+    for (unsigned int cnt = 0; cnt < received.size(); ++cnt)
+        REQUIRE(received.at(cnt).find("sender" + std::to_string(cnt) + ".") == 0);
+}
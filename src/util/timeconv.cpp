@@ -18,6 +18,8 @@
 #include "timeconv.h"
 #include "logger.h"
 
+#include <cassert>
+
 namespace Utils
 {
 namespace Time
@@ -63,6 +65,18 @@ long toLong(boost::posix_time::ptime value)
     return result;
 }
 
+MicroTimestamp toMicroTimestamp(boost::posix_time::ptime value)
+{
+    assert (!value.is_special());
+
+    return (value - epoch).total_microseconds();
+}
+
+boost::posix_time::ptime fromMicroTimestamp(MicroTimestamp value)
+{
+    return epoch + boost::posix_time::microseconds(value);
+}
+
 string toString(boost::posix_time::ptime value, unsigned int partial_digits)
 {
     ostringstream date_stream;
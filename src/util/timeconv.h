@@ -21,6 +21,7 @@
 
 #include "boost/date_time/posix_time/posix_time.hpp"
 
+#include <cstdint>
 #include <string>
 
 namespace Utils
@@ -43,6 +44,33 @@ extern boost::posix_time::ptime currentUTCTime();
 extern boost::posix_time::time_duration partialSeconds(double seconds, bool ignore_full_seconds=false);
 extern double partialSeconds(boost::posix_time::time_duration seconds);
 
+// compact 64-bit timestamps for hot paths, microseconds since epoch. Only converted from/to ptime at
+// GUI and DB boundaries, comparison and arithmetic are plain integer operations.
+typedef std::int64_t MicroTimestamp;
+typedef std::int64_t MicroDuration; // microseconds
+
+extern MicroTimestamp toMicroTimestamp(boost::posix_time::ptime value); // value must not be special
+extern boost::posix_time::ptime fromMicroTimestamp(MicroTimestamp value);
+
+inline MicroDuration toMicroDuration(boost::posix_time::time_duration value)
+{
+    return value.total_microseconds();
+}
+
+inline boost::posix_time::time_duration fromMicroDuration(MicroDuration value)
+{
+    return boost::posix_time::microseconds(value);
+}
+
+inline MicroDuration microDurationFromSeconds(double seconds)
+{
+    return seconds < 0 ? (MicroDuration) (seconds * 1e6 - 0.5) : (MicroDuration) (seconds * 1e6 + 0.5);
+}
+
+inline double secondsFromMicroDuration(MicroDuration value)
+{
+    return value / 1e6;
+}
 
 }  // namespace Time
 